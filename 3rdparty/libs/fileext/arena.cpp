@@ -0,0 +1,24 @@
+/**
+ * @brief   Per-conversion memory arena
+ * @package fileext
+ * @file    arena.cpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#include "arena.hpp"
+
+
+namespace fileext {
+
+/** Larger blocks aren't pooled */
+constexpr size_t ARENA_BLOCK_LIMIT = 64 * 1024;
+/** First chunk of monotonic buffer */
+constexpr size_t ARENA_INITIAL_SIZE = 64 * 1024;
+
+
+// Arena public:
+Arena::Arena()
+	: m_buffer(ARENA_INITIAL_SIZE),
+	  m_pool(std::pmr::pool_options {0, ARENA_BLOCK_LIMIT}, &m_buffer) {}
+
+}  // End namespace
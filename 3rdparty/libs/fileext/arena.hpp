@@ -0,0 +1,53 @@
+/**
+ * @brief   Per-conversion memory arena
+ * @package fileext
+ * @file    arena.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+
+namespace fileext {
+
+/**
+ * @class Arena
+ * @brief
+ *     Memory of the lookup tables of one conversion
+ * @details
+ *     Pools of small blocks carved from a monotonic buffer. Only containers
+ *     that are given `resource()` explicitly (`std::pmr` tables of the parsers,
+ *     with `std::pmr::string` keys and values) live in the arena: freed blocks
+ *     are reused by later tables of the same conversion, and all of them are
+ *     released at once when the parser is destroyed. pugixml documents, parser
+ *     records and the extracted text use the global heap.
+ *
+ *     The arena isn't thread-safe: it belongs to the parser and is only used
+ *     on the thread running its conversion.
+ */
+class Arena {
+public:
+	/** @since 1.2 */
+	Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/**
+	 * @brief
+	 *     Memory resource for `std::pmr` containers
+	 * @since 1.2
+	 */
+	std::pmr::memory_resource* resource() { return &m_pool; }
+
+private:
+	/** Chunks of the pools */
+	std::pmr::monotonic_buffer_resource m_buffer;
+	/** Reusable small blocks */
+	std::pmr::unsynchronized_pool_resource m_pool;
+};
+
+}  // End namespace
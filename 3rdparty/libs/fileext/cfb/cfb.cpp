@@ -34,9 +34,11 @@ Cfb::Cfb(const std::string& fileName)
     : m_fileName(fileName) {}
 
 void Cfb::parse() {
-    std::ifstream inputFile(m_fileName, std::ios::binary);
-    m_data.assign(std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>());
-    inputFile.close();
+    if (m_data.empty()) {
+        std::ifstream inputFile(m_fileName, std::ios::binary);
+        m_data.assign(std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>());
+        inputFile.close();
+    }
 
     // Check CFB 8 bytes signature (widespread and deprecated)
     auto abSig = binToHex(readByte<std::string>(m_data, 0, 8));
@@ -105,6 +107,11 @@ std::string Cfb::getStream(const std::string& name, int offset, bool isRoot) con
     return "";
 }
 
+bool Cfb::hasStream(const std::string& name) const {
+    return std::any_of(m_fatEntries.begin(), m_fatEntries.end(),
+                       [&name](const auto& entry) { return entry.first == name; });
+}
+
 void Cfb::clear() {
     m_data.clear();
     m_fatChains.clear();
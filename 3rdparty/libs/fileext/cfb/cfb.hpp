@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -57,10 +58,30 @@ public:
 	/**
 	 * @brief
 	 *     Parse file-system-like structure within a file
+	 * @details
+	 *     Data given by setData() is parsed instead of the file
 	 * @since 1.0
 	 */
 	void parse();
 
+	/**
+	 * @brief
+	 *     Use binary data held in memory instead of reading the file
+	 * @param[in] data
+	 *     CFB content (e.g. embedded OLE object)
+	 * @since 1.2
+	 */
+	void setData(std::string data) { m_data = std::move(data); }
+
+	/**
+	 * @brief
+	 *     Check if parsed structure has stream
+	 * @param[in] name
+	 *     Stream name
+	 * @since 1.2
+	 */
+	bool hasStream(const std::string& name) const;
+
 	/**
 	 * @brief
 	 *     Get binary stream content by name in "directory" structure
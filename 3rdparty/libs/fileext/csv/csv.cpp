@@ -32,11 +32,36 @@ int Csv::convert(bool addStyle, bool extractImages, char mergingMode) {
 	std::ifstream file(m_fileName);
 	detectDelimiter(file);
 
+#ifdef DOCPARSER_TEXT_ONLY
+	// Cells are separated with tabs, rows with newlines
+	bool hasRows     = false;
+	bool isFirstCell = true;
+	auto addRow = [&]() {
+		if (hasRows)
+			m_text += '\n';
+		hasRows     = true;
+		isFirstCell = true;
+	};
+	auto addCell = [&](std::string& cell) {
+		if (!isFirstCell)
+			m_text += '\t';
+		isFirstCell = false;
+		m_text += clearCell(cell);
+	};
+#else
 	auto tableTag = m_htmlTree.append_child("html").append_child("body").append_child("table");
+	pugi::xml_node tr;
+	auto addRow = [&]() {
+		tr = tableTag.append_child("tr");
+	};
+	auto addCell = [&](std::string& cell) {
+		tr.append_child("td").append_child(pugi::node_pcdata).set_value(clearCell(cell).c_str());
+	};
+#endif
 
 	std::string line;
 	while(std::getline(file, line)) {
-		auto tr = tableTag.append_child("tr");
+		addRow();
 
 		std::string cell;
 		bool inQuote = false;
@@ -48,14 +73,12 @@ int Csv::convert(bool addStyle, bool extractImages, char mergingMode) {
 			if (inQuote || c != m_delimiter)
 				cell += c;
 			else {
-				tr.append_child("td").append_child(pugi::node_pcdata)
-					.set_value(clearCell(cell).c_str());
+				addCell(cell);
 				cell.clear();
 			}
 		}
 		if (!cell.empty())
-			tr.append_child("td").append_child(pugi::node_pcdata)
-				.set_value(clearCell(cell).c_str());
+			addCell(cell);
 	}
 
 	file.close();
@@ -0,0 +1,102 @@
+/**
+ * @brief   Repeated paragraph suppression
+ * @package fileext
+ * @file    dedupe.cpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#include "dedupe.hpp"
+
+
+namespace fileext {
+
+/** Multiplier of polynomial paragraph hash */
+constexpr uint64_t DEDUPE_HASH_BASE = 0x100000001b3ull;
+
+/**
+ * @brief
+ *     Call `onParagraph(unitBegin, end, paragraph, hash)` for every paragraph
+ * @details
+ *     The unit of a paragraph starts at the line break in front of it.
+ *     `paragraph` is the text without surrounding whitespace (empty for blank
+ *     lines), its hash is never 0.
+ */
+template <class Callback>
+static void forEachParagraph(std::string_view text, Callback&& onParagraph) {
+	auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+	size_t begin = 0;
+	while (begin <= text.size()) {
+		size_t end = text.find('\n', begin);
+		if (end == std::string_view::npos)
+			end = text.size();
+
+		size_t first = begin;
+		size_t last = end;
+		while (first < last && isSpace(text[first]))
+			++first;
+		while (last > first && isSpace(text[last - 1]))
+			--last;
+		const std::string_view paragraph = text.substr(first, last - first);
+
+		uint64_t hash = 0;
+		for (const char c : paragraph)
+			hash = hash * DEDUPE_HASH_BASE + static_cast<unsigned char>(c);
+
+		onParagraph(begin > 0 ? begin - 1 : 0, end, paragraph, hash != 0 ? hash : 1);
+		begin = end + 1;
+	}
+}
+
+
+// ParagraphDedupe public:
+ParagraphDedupe::ParagraphDedupe(size_t slots)
+	: m_slots(slots) {}
+
+void ParagraphDedupe::addBoilerplate(std::string_view text) {
+	forEachParagraph(text, [this](size_t, size_t, std::string_view paragraph, uint64_t hash) {
+		if (paragraph.empty() || m_slots.empty())
+			return;
+		Entry& entry = slotOf(paragraph, hash);
+		// Full table: paragraph is kept but not remembered
+		if (entry.hash != 0 || m_used >= m_slots.size() / 4 * 3 ||
+			m_texts.size() + paragraph.size() > UINT32_MAX)
+			return;
+		entry.hash = hash;
+		entry.offset = static_cast<uint32_t>(m_texts.size());
+		entry.size = static_cast<uint32_t>(paragraph.size());
+		m_texts.append(paragraph);
+		++m_used;
+	});
+}
+
+void ParagraphDedupe::filter(std::string_view text, std::string& output) {
+	forEachParagraph(text, [this, text, &output](size_t unitBegin, size_t end, std::string_view paragraph,
+												 uint64_t hash) {
+		if (!paragraph.empty() && !m_slots.empty()) {
+			Entry& entry = slotOf(paragraph, hash);
+			if (entry.hash != 0) {
+				// Paragraph goes with the line break in front of it
+				if (entry.isAppended)
+					return;
+				entry.isAppended = true;
+			}
+		}
+		output.append(text.substr(unitBegin, end - unitBegin));
+	});
+}
+
+// private:
+ParagraphDedupe::Entry& ParagraphDedupe::slotOf(std::string_view paragraph, uint64_t hash) {
+	// Table is never full, so probing ends at an empty slot
+	const size_t mask = m_slots.size() - 1;
+	for (size_t slot = (hash ^ (hash >> 29)) & mask;; slot = (slot + 1) & mask) {
+		Entry& entry = m_slots[slot];
+		if (entry.hash == 0)
+			return entry;
+		// Equal hashes of different text are collisions, probing goes on
+		if (entry.hash == hash && std::string_view(m_texts).substr(entry.offset, entry.size) == paragraph)
+			return entry;
+	}
+}
+
+}  // End namespace
@@ -0,0 +1,99 @@
+/**
+ * @brief   Repeated paragraph suppression
+ * @package fileext
+ * @file    dedupe.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace fileext {
+
+/** Default size of the hash table of ParagraphDedupe (384 KiB) */
+constexpr size_t DEDUPE_SLOTS = 16 * 1024;
+
+/**
+ * @class ParagraphDedupe
+ * @brief
+ *     Drops repeats of boilerplate paragraphs
+ * @details
+ *     Boilerplate is text of template parts (masters, layouts, notes) that
+ *     slides or pages repeat: footers, confidentiality notices, placeholder
+ *     text. A paragraph is dropped only if it is boilerplate and was already
+ *     appended since; any other paragraph is kept, however often it occurs.
+ *
+ *     Paragraphs are lines of text, compared without surrounding whitespace.
+ *     Boilerplate paragraphs are kept in an open addressing table of fixed
+ *     size, with their text: a paragraph whose hash matches is compared with
+ *     the stored text before it's dropped, so hash collisions never drop
+ *     text. Once the table is 3/4 full, new boilerplate is no longer
+ *     remembered, so memory stays bounded on any document.
+ */
+class ParagraphDedupe {
+public:
+	/**
+	 * @param[in] slots
+	 *     Size of the hash table (power of two), 0 keeps every paragraph
+	 * @since 1.2
+	 */
+	explicit ParagraphDedupe(size_t slots = DEDUPE_SLOTS);
+
+	/**
+	 * @brief
+	 *     Remember paragraphs of text as boilerplate
+	 * @param[in] text
+	 *     Text, paragraphs separated by `\n`
+	 * @since 1.2
+	 */
+	void addBoilerplate(std::string_view text);
+
+	/**
+	 * @brief
+	 *     Append text without boilerplate paragraphs already appended
+	 * @details
+	 *     A dropped paragraph takes its leading line break with it, blank
+	 *     lines are always kept
+	 * @param[in] text
+	 *     Text, paragraphs separated by `\n`
+	 * @param[out] output
+	 *     Text is appended here
+	 * @since 1.2
+	 */
+	void filter(std::string_view text, std::string& output);
+
+private:
+	/** Boilerplate paragraph, its text is `m_texts.substr(offset, size)` */
+	struct Entry {
+		/** Paragraph hash, 0 for empty slot */
+		uint64_t hash = 0;
+		uint32_t offset = 0;
+		uint32_t size = 0;
+		/** Paragraph was appended to the output */
+		bool isAppended = false;
+	};
+
+	/**
+	 * @brief
+	 *     Find slot of paragraph
+	 * @return
+	 *     Entry of paragraph, or empty slot where it belongs
+	 * @since 1.2
+	 */
+	Entry& slotOf(std::string_view paragraph, uint64_t hash);
+
+	/** Hash table of boilerplate paragraphs */
+	std::vector<Entry> m_slots;
+	/** Number of used slots */
+	size_t m_used = 0;
+	/** Text of boilerplate paragraphs */
+	std::string m_texts;
+};
+
+}  // End namespace
@@ -15,14 +15,23 @@
 
 namespace doc {
 
-const std::regex OBJECT1_MASK("HYPER13 *(INCLUDEPICTURE|HTMLCONTROL)(.*)HYPER15", std::regex::icase);
-const std::regex OBJECT2_MASK("HYPER13(.*)HYPER14(.*)HYPER15", std::regex::icase);
+/** Embedded objects masks (compiled on first use) */
+static const std::regex& object1Mask() {
+    static const std::regex regex("HYPER13 *(INCLUDEPICTURE|HTMLCONTROL)(.*)HYPER15", std::regex::icase);
+    return regex;
+}
+static const std::regex& object2Mask() {
+    static const std::regex regex("HYPER13(.*)HYPER14(.*)HYPER15", std::regex::icase);
+    return regex;
+}
 
 // public:
 Doc::Doc(const std::string& fileName)
     : FileExtension(fileName), Cfb(fileName) {}
 
 int Doc::convert(bool addStyle, bool extractImages, char mergingMode) {
+    if (!m_content.empty())
+        setData(std::string(m_content));
     Cfb::parse();
     // DOC needs two streams for reading DOC - `WordDocument` and `0Table` or `1Table`, depending
     // on situation. Find `WordDocument` - it contains pieces of text
@@ -132,8 +141,8 @@ int Doc::convert(bool addStyle, bool extractImages, char mergingMode) {
 
     // Delete links and embedded objects
     text = text.substr(0, 100000);
-    text = regex_replace(text, OBJECT1_MASK, "");
-    text = regex_replace(text, OBJECT2_MASK, "$2");
+    text = regex_replace(text, object1Mask(), "");
+    text = regex_replace(text, object2Mask(), "$2");
 
     // Separate pargraphs and add them to HTML tags
     for (const auto& line : tools::explode(text, "\n\r")) {
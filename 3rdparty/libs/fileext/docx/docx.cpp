@@ -7,17 +7,25 @@
  * @date      12.07.2016 -- 18.10.2017
  */
 #include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <string.h>
+#include <string_view>
+
+#include "tools.hpp"
+#include "fileext/ooxml/textscan.hpp"
+#include "fileext/ooxml/xmlreader.hpp"
+#include "fileext/ooxml/xmltag.hpp"
 
 #include "docx.hpp"
 
 
 namespace docx {
 
-/** Header tags map */
-const std::unordered_map<std::string, std::string> HEADER_LIST {
+/** Header tags map (sorted by key) */
+constexpr tools::TableEntry<std::string_view, const char*> HEADER_LIST[] {
 	{"heading 1",  "h1"},
+	{"heading 10", "h6"},
 	{"heading 2",  "h2"},
 	{"heading 3",  "h3"},
 	{"heading 4",  "h4"},
@@ -25,220 +33,333 @@ const std::unordered_map<std::string, std::string> HEADER_LIST {
 	{"heading 6",  "h6"},
 	{"heading 7",  "h6"},
 	{"heading 8",  "h6"},
-	{"heading 9",  "h6"},
-	{"heading 10", "h6"}
-};
-/** List type map */
-const std::unordered_map<std::string, std::string> LIST_TYPE {
-	{"decimal",      "decimal"},
-	{"decimalZero",  "decimal-leading-zero"},
-	{"upperRoman",   "upper-roman"},
-	{"lowerRoman",   "lower-roman"},
-	{"upperLetter",  "upper-alpha"},
-	{"lowerLetter",  "lower-alpha"},
-	{"ordinal",      "decimal"},
-	{"cardinalText", "decimal"},
-	{"ordinalText",  "decimal"}
-};
-/** Only these tags contain text that we care about (e.g. don't care about delete tags) */
-const std::vector<std::string> CONTENT_TAGS {
-	"w:r",
-	"w:hyperlink",
-	"w:ins",
-	"w:smartTag"
-};
-/** Horizontal align map */
-const std::unordered_map<std::string, std::string> HORZ_ALIGN {
-	{"left",   "left"},
-	{"center", "center"},
-	{"right",  "right"},
-	{"both",   "justify"},
-};
-/** Vertical align map */
-const std::unordered_map<std::string, std::string> VERT_ALIGN {
-	{"top",         "top"},
-	{"center",      "middle"},
-	{"bottom",      "bottom"},
-	{"justify",     "middle"},
-	{"distributed", "middle"}
+	{"heading 9",  "h6"}
 };
-/** Border type map */
-const std::unordered_map<std::string, std::string> BORDER_TYPE {
-	{"",                 "none"},
-	{"single",           "solid"},
-	{"thin",             "solid"},
-	{"medium",           "solid"},
-	{"dashed",           "dashed"},
-	{"dotted",           "dotted"},
-	{"thick",            "solid"},
-	{"double",           "double"},
-	{"hair",             "dotted"},
-	{"mediumDashed",     "dashed"},
-	{"dashDot",          "dashed"},
-	{"mediumDashDot",    "dashed"},
-	{"dashDotDot",       "dotted"},
-	{"mediumDashDotDot", "dotted"},
-	{"slantDashDot",     "dashed"}
-};
-/** Border size map */
-const std::unordered_map<std::string, int> BORDER_SIZE {
-	{"",                 1},
-	{"single",           1},
-	{"thin",             1},
-	{"medium",           2},
-	{"dashed",           1},
-	{"dotted",           1},
-	{"thick",            3},
-	{"double",           1},
-	{"hair",             1},
-	{"mediumDashed",     2},
-	{"dashDot",          1},
-	{"mediumDashDot",    2},
-	{"dashDotDot",       1},
-	{"mediumDashDotDot", 2},
-	{"slantDashDot",     3}
-};
-/** Border position list */
-const std::vector<std::string> BORDER_LIST {
-	"top",
-	"left",
-	"right",
-	"bottom"
+static_assert(tools::isSortedTable(HEADER_LIST), "HEADER_LIST must be sorted");
+
+/**
+ * @brief
+ *     Get `H` tag of heading style name (case insensitive)
+ * @return
+ *     Tag or nullptr if style isn't heading
+ */
+static const char* getHeaderTag(std::string_view name) {
+	// Only "heading N" names can match, the rest isn't lowercased at all
+	char lowered[10];
+	if (name.size() < 9 || name.size() > sizeof(lowered))
+		return nullptr;
+	for (size_t i = 0; i < name.size(); ++i)
+		lowered[i] = static_cast<char>(tolower(static_cast<unsigned char>(name[i])));
+	const auto header = tools::findInTable(HEADER_LIST, std::string_view(lowered, name.size()));
+	return header ? *header : nullptr;
+}
+
+/**
+ * @brief
+ *     Parse decimal number (`ST_DecimalNumber`)
+ * @return
+ *     False if value isn't a number
+ */
+static bool parseDecimal(std::string_view value, int& number) {
+	const char* end = value.data() + value.size();
+	const auto result = std::from_chars(value.data(), end, number);
+	return result.ec == std::errc() && result.ptr == end;
+}
+/** Relationship types (last path segment) of story parts */
+constexpr tools::TableEntry<std::string_view, Docx::Part> STORY_PART_TYPES[] {
+	{"comments",  Docx::PartComments},
+	{"endnotes",  Docx::PartEndnotes},
+	{"footer",    Docx::PartFooters},
+	{"footnotes", Docx::PartFootnotes},
+	{"header",    Docx::PartHeaders}
 };
+static_assert(tools::isSortedTable(STORY_PART_TYPES), "STORY_PART_TYPES must be sorted");
 
 // public:
 Docx::Docx(const std::string& fileName, int maxLen)
     : FileExtension(fileName)
-    , m_maxLen(maxLen) {}
+    , m_maxLen(maxLen)
+    , m_numberings(m_arena.resource())
+    , m_styleIds(m_arena.resource())
+    , m_headingStyles(m_arena.resource())
+    , m_blocks(m_arena.resource())
+    , m_relationshipMap(m_arena.resource()) {}
 
 int Docx::convert(bool addStyle, bool extractImages, char mergingMode) {
-	getNumberingMap();
-	getStyleMap();
-	getRelationshipMap();
-
-	pugi::xml_document tree;
-	Ooxml::extractFile(m_fileName, "word/document.xml", tree);
-
-	for (const auto& node : tree.child("w:document").child("w:body")) {
-		// Lists are handled specific => could double visit certain elements. Keep track
-		// of visited elements and skip any that have been visited already
-		std::string nodeName = node.name();
-		if (nodeName == "w:sectPr" ||
-			find(m_visitedNodeList.begin(), m_visitedNodeList.end(), node) !=
-				m_visitedNodeList.end()
-		)
-			continue;
-		std::string headerValue = isHeader(node);
-		if (!headerValue.empty()) {
-            getParagraphText(node);
+	openArchive(m_fileName, m_content);
+	// Numbering, styles and relationships are read on first use
+	if (m_parts & PartBody) {
+		if (m_fastText) {
+			getTextFast("word/document.xml");
 		}
-		else if (nodeName == "w:p") {
-			// Certain `p` tags denoted as `Title` tags. Strip out them
-			auto pStyle = node.select_node(".//w:pStyle");
-			std::string isTitle = pStyle.node().attribute("w:val").value();
-			if (isTitle == "Title")
-				continue;
-			// Parse out the needed info from node
-			if (isLi(node)) {
-                buildList(node);
-			}
-			// Handle generic `p` tag
-			else {
-                getParagraphText(node);
-			}
+		else {
+			buildBody();
 		}
-		else if (nodeName == "w:tbl") {
-            buildTable(node);
+	}
+
+	// Other story parts are found in document relationships
+	if (!(m_parts & ~(PartBody | PartTextBoxes)))
+		return 0;
+	getRelationshipMap();
+	for (const auto& storyPart : m_storyParts) {
+		if (!(m_parts & storyPart.first) || shouldStopProcessing())
 			continue;
-		}
-		m_visitedNodeList.emplace_back(node);
+		if (m_fastText)
+			getTextFast(storyPart.second);
+		else
+			buildStoryPart(storyPart.first, storyPart.second);
 	}
     return 0;
 }
 
 
 // private:
-void Docx::getNumberingMap() {
-	pugi::xml_document tree;
-	Ooxml::extractFile(m_fileName, "word/numbering.xml", tree);
-
-	std::unordered_map<std::string, std::string> numIdList;
-	// Each list type is assigned an abstractNumber that defines how lists should look
-	for (const auto& node : tree.select_nodes("//w:num")) {
-		auto nd = node.node();
-		std::string abstractNumber = nd.child("w:abstractNumId").attribute("w:val").value();
-		numIdList[abstractNumber] = nd.attribute("w:numId").value();
-	}
+void Docx::getTextFast(const std::string& fileName) {
+	std::string storage;
+	std::string_view xml;
+	if (!extractFile(fileName, xml, storage))
+		return;
+
+	// One branch of alternate content is read, as in the normal mode
+	const ooxml::TextScanner scanner("w:t", "w:p");
+	std::string paragraph;
+	scanner.scan(xml, paragraph, [&](ooxml::TextScanner::Event event) {
+		if (event != ooxml::TextScanner::Event::BlockEnd)
+			return true;
+		paragraph += '\n';
+		bool appended = safeAppendText(paragraph);
+		paragraph.clear();
+		return appended;
+	});
+}
 
-	for (const auto& node : tree.select_nodes("//w:abstractNum")) {
-		auto nd = node.node();
-		std::string abstractNumId = nd.attribute("w:abstractNumId").value();
-		// If we find abstractNumber that is not being used in document => ignore it
-		if (numIdList.find(abstractNumId) == numIdList.end())
+void Docx::buildBody() {
+	// Body is streamed; only one paragraph or table at a time is loaded into a
+	// small DOM, and nothing after the text limit is inflated or parsed
+	using Token = ooxml::XmlReader::Token;
+	ooxml::XmlReader reader(archive().get(), "word/document.xml");
+	pugi::xml_document fragment;
+	std::string xml;
+	ListState list;
+	int bodyDepth = 0;
+	for (auto token = reader.next(); token != Token::End && !shouldStopProcessing(); token = reader.next()) {
+		if (token != Token::StartElement)
+			continue;
+		if (!bodyDepth) {
+			if (ooxml::tagOf(reader.name()) == ooxml::XmlTag::WBody)
+				bodyDepth = reader.depth();
 			continue;
-		// Get level of abstract number
-		for (const auto& child : nd.children("w:lvl")) {
-			// Based on list type and ilvl (indentation level) store needed style
-			m_numberingMap[numIdList[abstractNumId]].emplace_back(
-				child.child("w:numFmt").attribute("w:val").value()
-			);
+		}
+		if (reader.depth() != bodyDepth + 1)
+			continue;
+
+		if (!reader.readElement(xml))
+			break;
+		// `xml` isn't touched until the next block replaces the fragment
+		if (fragment.load_buffer_inplace(&xml[0], xml.size())) {
+			buildBlock(fragment.first_child(), true, list);
+			// Tables and text boxes of the block are read before the fragment is reused
+			readBlocks(0);
 		}
 	}
 }
 
-void Docx::getStyleMap() {
+void Docx::buildStoryPart(Part part, const std::string& fileName) {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_fileName, "word/styles.xml", tree);
+	if (!extractFile(fileName, tree))
+		return;
 
-	// This is a partial document and actual H1 is the document title, which
-	// will be displayed elsewhere
-	for (const auto& node : tree.select_nodes("//w:style")) {
-		auto nd = node.node();
-		std::unordered_map<std::string, std::string> style {
-			{"header",    ""},
-			{"font_size", ""},
-			{"based_on",  ""}
-		};
-		// Get header info
-		auto name = nd.child("w:name");
-		if (!name)
+	const auto root = tree.first_child();
+	if (part == PartHeaders || part == PartFooters) {
+		buildBlocks(root, true);
+		return;
+	}
+	// Footnotes, endnotes and comments: one block container per note.
+	// Separator notes (`w:type` is set) have no text
+	for (const auto& note : root) {
+		if (!note.attribute("w:type"))
+			buildBlocks(note, true);
+	}
+}
+
+void Docx::getNumberingMap() {
+	if (m_numberingMapLoaded)
+		return;
+	m_numberingMapLoaded = true;
+
+	// Abstract lists come first in the part, list ids refer to them afterwards
+	using Token = ooxml::XmlReader::Token;
+	std::vector<Numbering> abstractNums;
+	std::vector<std::pair<int, int>> nums;
+	Numbering* abstractNum = nullptr;
+	int numId = 0;
+	bool hasNumId = false;
+	bool hasFormat = false;
+	ooxml::XmlReader reader(archive().get(), "word/numbering.xml");
+	for (auto token = reader.next(); token != Token::End; token = reader.next()) {
+		if (token != Token::StartElement)
+			continue;
+		switch (ooxml::tagOf(reader.name())) {
+		case ooxml::XmlTag::WAbstractNum:
+			abstractNum = nullptr;
+			hasNumId    = false;
+			hasFormat   = false;
+			if (reader.depth() == 2) {
+				int id = 0;
+				if (parseDecimal(reader.rawAttribute("w:abstractNumId"), id)) {
+					abstractNums.push_back({id, 0, false});
+					abstractNum = &abstractNums.back();
+				}
+			}
+			break;
+		case ooxml::XmlTag::WLvl:
+			if (abstractNum && reader.depth() == 3)
+				++abstractNum->levels;
+			break;
+		case ooxml::XmlTag::WNumFmt:
+			// Only format of first level matters (upper roman lists are headings)
+			if (abstractNum && abstractNum->levels == 1 && reader.depth() == 4 && !hasFormat) {
+				abstractNum->isUpperRoman = reader.rawAttribute("w:val") == "upperRoman";
+				hasFormat = true;
+			}
+			break;
+		case ooxml::XmlTag::WNum:
+			abstractNum = nullptr;
+			hasNumId    = reader.depth() == 2 && parseDecimal(reader.rawAttribute("w:numId"), numId);
+			break;
+		case ooxml::XmlTag::WAbstractNumId: {
+			int abstractId = 0;
+			if (hasNumId && reader.depth() == 3 && parseDecimal(reader.rawAttribute("w:val"), abstractId))
+				nums.emplace_back(abstractId, numId);
+			hasNumId = false;
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// Each abstract list is used by the last list id referring to it
+	std::stable_sort(abstractNums.begin(), abstractNums.end(),
+					 [](const Numbering& a, const Numbering& b) { return a.numId < b.numId; });
+	std::stable_sort(nums.begin(), nums.end(),
+					 [](const auto& a, const auto& b) { return a.first < b.first; });
+	for (auto it = nums.begin(); it != nums.end(); ++it) {
+		if (std::next(it) != nums.end() && std::next(it)->first == it->first)
 			continue;
-		std::string value = name.attribute("w:val").value();
-		transform(value.begin(), value.end(), value.begin(), ::tolower);
-		if (HEADER_LIST.find(value) != HEADER_LIST.end())
-			style["header"] = HEADER_LIST.at(value);
-
-		// Get size info
-		auto rPr = nd.child("w:rPr");
-		if (!rPr)
+		auto abstract = std::lower_bound(abstractNums.begin(), abstractNums.end(), it->first,
+										 [](const Numbering& a, int id) { return a.numId < id; });
+		if (abstract == abstractNums.end() || abstract->numId != it->first || abstract->levels == 0)
 			continue;
-		auto size = rPr.child("w:sz");
-		if (size)
-			style["font_size"] = size.attribute("w:val").value();
+		m_numberings.push_back({it->second, abstract->levels, abstract->isUpperRoman});
+	}
+	std::sort(m_numberings.begin(), m_numberings.end(),
+			  [](const Numbering& a, const Numbering& b) { return a.numId < b.numId; });
+}
 
-		// Get based on info
-		auto basedOn = nd.child("w:basedOn");
-		if (basedOn)
-			style["based_on"] = basedOn.attribute("w:val").value();
+void Docx::getStyleMap() {
+	if (m_styleMapLoaded)
+		return;
+	m_styleMapLoaded = true;
 
-		std::string styleId = nd.attribute("w:styleId").value();
-		m_styleMap[styleId] = style;
+	// This is a partial document and actual H1 is the document title, which
+	// will be displayed elsewhere. Styles without run properties are ignored
+	using Token = ooxml::XmlReader::Token;
+	std::string styleId;
+	const char* tag = nullptr;
+	bool hasRunProperties = false;
+	ooxml::XmlReader reader(archive().get(), "word/styles.xml");
+	for (auto token = reader.next(); token != Token::End; token = reader.next()) {
+		if (token == Token::StartElement) {
+			switch (ooxml::tagOf(reader.name())) {
+			case ooxml::XmlTag::WStyle:
+				if (reader.depth() == 2) {
+					styleId          = reader.attribute("w:styleId");
+					tag              = nullptr;
+					hasRunProperties = false;
+				}
+				break;
+			case ooxml::XmlTag::WName:
+				if (reader.depth() == 3)
+					tag = getHeaderTag(reader.rawAttribute("w:val"));
+				break;
+			case ooxml::XmlTag::WRPr:
+				if (reader.depth() == 3)
+					hasRunProperties = true;
+				break;
+			default:
+				break;
+			}
+		}
+		else if (token == Token::EndElement && reader.depth() == 2 &&
+				 ooxml::tagOf(reader.name()) == ooxml::XmlTag::WStyle) {
+			if (tag && hasRunProperties) {
+				m_headingStyles.push_back({static_cast<uint32_t>(m_styleIds.size()),
+										   static_cast<uint32_t>(styleId.size()), tag});
+				m_styleIds += styleId;
+			}
+		}
 	}
+
+	// Later definitions of the same id win
+	const auto idOf = [this](const HeadingStyle& style) {
+		return std::string_view(m_styleIds).substr(style.idOffset, style.idSize);
+	};
+	std::stable_sort(m_headingStyles.begin(), m_headingStyles.end(),
+					 [&idOf](const HeadingStyle& a, const HeadingStyle& b) { return idOf(a) < idOf(b); });
+	auto last = m_headingStyles.begin();
+	for (auto it = m_headingStyles.begin(); it != m_headingStyles.end(); ++it) {
+		if (last != it && idOf(*last) == idOf(*it))
+			*last = *it;
+		else if (last != it)
+			*++last = *it;
+	}
+	if (!m_headingStyles.empty())
+		m_headingStyles.erase(last + 1, m_headingStyles.end());
+}
+
+const Docx::Numbering* Docx::findNumbering(std::string_view numId) {
+	getNumberingMap();
+	int id = 0;
+	if (!parseDecimal(numId, id))
+		return nullptr;
+	auto it = std::lower_bound(m_numberings.begin(), m_numberings.end(), id,
+							   [](const Numbering& numbering, int value) { return numbering.numId < value; });
+	if (it == m_numberings.end() || it->numId != id)
+		return nullptr;
+	return &*it;
 }
 
 void Docx::getRelationshipMap() {
+	if (m_relationshipMapLoaded)
+		return;
+	m_relationshipMapLoaded = true;
+
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_fileName, "word/_rels/document.xml.rels", tree);
+	extractFile("word/_rels/document.xml.rels", tree);
 
 	for (const auto& node : tree.child("Relationships")) {
 		auto id = node.attribute("Id").value();
 		if (id)
 			m_relationshipMap[id] = node.attribute("Target").value();
+
+		// Story parts of one kind are kept in relationship order
+		std::string_view type = node.attribute("Type").value();
+		const auto part = tools::findInTable(STORY_PART_TYPES, type.substr(type.rfind('/') + 1));
+		if (!part)
+			continue;
+		std::string target = node.attribute("Target").value();
+		if (target.empty() || node.attribute("TargetMode"))
+			continue;
+		m_storyParts.emplace_back(*part, target[0] == '/' ? target.substr(1) : "word/" + target);
 	}
+	// Kinds are read in flag order: headers, footers, footnotes, endnotes, comments
+	std::stable_sort(m_storyParts.begin(), m_storyParts.end(),
+					 [](const auto& a, const auto& b) { return a.first < b.first; });
 }
 
 
-std::string Docx::isHeader(const pugi::xml_node& node) const {
+std::string Docx::isHeader(const pugi::xml_node& node) {
 	if (isTopLevel(node))
 		return "h2";
 	std::string el_isNaturalHeader = isNaturalHeader(node);
@@ -251,45 +372,62 @@ std::string Docx::isHeader(const pugi::xml_node& node) const {
 	return "";
 }
 
-std::string Docx::isNaturalHeader(const pugi::xml_node& node) const {
+std::string Docx::isNaturalHeader(const pugi::xml_node& node) {
 	auto pPr = node.child("w:pPr");
 	if (!pPr)
 		return "";
 	auto pStyle = pPr.child("w:pStyle");
 	if (!pStyle)
 		return "";
-	std::string styleId = pStyle.attribute("w:val").value();
-    if (m_styleMap.find(styleId) != m_styleMap.end() && m_styleMap.at(styleId).at("header") != "false")
-		return m_styleMap.at(styleId).at("header");
+	const std::string_view styleId = pStyle.attribute("w:val").value();
+	getStyleMap();
+	auto it = std::lower_bound(m_headingStyles.begin(), m_headingStyles.end(), styleId,
+		[this](const HeadingStyle& style, std::string_view id) {
+			return std::string_view(m_styleIds).substr(style.idOffset, style.idSize) < id;
+		});
+	if (it != m_headingStyles.end() &&
+		std::string_view(m_styleIds).substr(it->idOffset, it->idSize) == styleId)
+		return it->tag;
 	return "";
 }
 
+pugi::xml_node Docx::getNumberingProperties(const pugi::xml_node& node) {
+	return node.child("w:pPr").child("w:numPr");
+}
+
 std::string Docx::getNumberingId(const pugi::xml_node& node) const {
-	auto numId = node.select_node(".//w:numId");
-	return numId.node().attribute("w:val").value();
+	return getNumberingProperties(node).child("w:numId").attribute("w:val").value();
 }
 
 bool Docx::hasIndentationLevel(const pugi::xml_node& node) const {
-	auto ilvl = node.select_nodes(".//w:numPr/w:ilvl");
-	return (ilvl.end() - ilvl.begin() != 0);
+	return getNumberingProperties(node).child("w:ilvl");
 }
 
 // Paragraph
-void Docx::getParagraphText(const pugi::xml_node& xmlNode) {
-    if (m_maxLen > 0 && m_text.size() >= m_maxLen)
-        return;
-
-    std::string text;
+void Docx::getParagraphText(const pugi::xml_node& xmlNode, unsigned depth) {
+	if ((m_maxLen > 0 && m_text.size() >= m_maxLen) || shouldStopProcessing())
+		return;
+	if (depth >= m_maxNesting)
+		return;
+
+	std::string text;
+	std::vector<pugi::xml_node> textBoxes;
 	for (const auto& child : xmlNode) {
-		std::string childName = child.name();
-		if (find(CONTENT_TAGS.begin(), CONTENT_TAGS.end(), childName) != CONTENT_TAGS.end()) {
-			// Hyperlinks and insert tags need to be handled differently than r and smart tags
-			if (childName == "w:r")
-                text += getElementText(child);
-			else if (childName == "w:hyperlink")
-                buildHyperlink(child);
-			else
-                getParagraphText(child);
+		// Only these tags contain text that we care about (e.g. don't care about delete tags).
+		// Hyperlinks and insert tags need to be handled differently than r and smart tags
+		switch (ooxml::tagOf(child.name())) {
+		case ooxml::XmlTag::WR:
+            text += getElementText(child, textBoxes);
+			break;
+		case ooxml::XmlTag::WHyperlink:
+            buildHyperlink(child, depth + 1);
+			break;
+		case ooxml::XmlTag::WIns:
+		case ooxml::XmlTag::WSmartTag:
+            getParagraphText(child, depth + 1);
+			break;
+		default:
+			break;
 		}
 	}
 
@@ -297,13 +435,29 @@ void Docx::getParagraphText(const pugi::xml_node& xmlNode) {
         // Truncation occurred, stop processing
         return;
     }
+
+	// Text boxes anchored in paragraph follow it: the last one is queued first
+	for (auto it = textBoxes.rbegin(); it != textBoxes.rend(); ++it)
+		pushBlocks(*it, true);
 }
 
-std::string Docx::getElementText(const pugi::xml_node& xmlNode) {
+std::string Docx::getElementText(const pugi::xml_node& xmlNode, std::vector<pugi::xml_node>& textBoxes,
+                                 unsigned depth) {
     std::string elementText;
 	for (const auto& child : xmlNode) {
-		std::string childName = child.name();
-		if (childName == "w:t") {
+		const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+		if (tag == ooxml::XmlTag::WDrawing || tag == ooxml::XmlTag::WPict) {
+			if (m_parts & PartTextBoxes)
+				findTextBoxes(child, textBoxes, depth);
+		}
+		else if (tag == ooxml::XmlTag::McAlternateContent) {
+			// Branches hold the same content, only one of them is read
+			if (depth >= m_maxNesting)
+				continue;
+			if (const auto branch = ooxml::selectAlternateContent(child))
+				elementText += getElementText(branch, textBoxes, depth + 1);
+		}
+		else if (tag == ooxml::XmlTag::WT) {
 			// Generate string data that for this particular `t` tag
 			std::string text = child.child_value();
 			if (text.empty())
@@ -317,191 +471,223 @@ std::string Docx::getElementText(const pugi::xml_node& xmlNode) {
     return elementText;
 }
 
+void Docx::findTextBoxes(const pugi::xml_node& xmlNode, std::vector<pugi::xml_node>& textBoxes,
+                         unsigned depth) const {
+	// Shapes nest deeply (anchor, graphic, group, shape); text box content
+	// itself is read later, so the walk doesn't descend into it
+	for (auto node = xmlNode.first_child(); node && node != xmlNode;) {
+		const ooxml::XmlTag tag = ooxml::tagOf(node.name());
+		if (tag == ooxml::XmlTag::WTxbxContent)
+			textBoxes.push_back(node);
+		else if (tag == ooxml::XmlTag::McAlternateContent) {
+			const auto branch = ooxml::selectAlternateContent(node);
+			if (branch && depth < m_maxNesting)
+				findTextBoxes(branch, textBoxes, depth + 1);
+		}
+		else if (node.first_child()) {
+			node = node.first_child();
+			continue;
+		}
+
+		while (!node.next_sibling() && node != xmlNode)
+			node = node.parent();
+		if (node != xmlNode)
+			node = node.next_sibling();
+	}
+}
+
 // Hyperlink
-void Docx::buildHyperlink(const pugi::xml_node& xmlNode) {
+void Docx::buildHyperlink(const pugi::xml_node& xmlNode, unsigned depth) {
 	// If we have hyperlink we need to get relationship id
 	auto hyperlinkId = xmlNode.attribute("r:id").value();
+	getRelationshipMap();
 
 	// Once we have hyperlinkId then we need to replace hyperlink tag with its child run tags
     if (m_relationshipMap.find(hyperlinkId) != m_relationshipMap.end()) {
-        getParagraphText(xmlNode);
+        getParagraphText(xmlNode, depth);
 	}
 }
 
 // Table
 void Docx::buildTable(const pugi::xml_node& xmlNode) {
-	for (const auto& child : xmlNode.children("w:tr")) {
-        buildTr(child);
-	}
+	if (m_blocks.size() >= m_maxNesting)
+		return;
+	const auto row = xmlNode.child("w:tr");
+	m_blocks.push_back({row, row.child("w:tc"), true, false, {}});
 }
 
-void Docx::buildTr(const pugi::xml_node& xmlNode) {
-	for (const auto& child : xmlNode.children("w:tc")) {
-		if (find(m_visitedNodeList.begin(), m_visitedNodeList.end(), child) != m_visitedNodeList.end())
-			continue;
-		// Keep track of m_visitedNodeList
-		m_visitedNodeList.emplace_back(xmlNode);
-
-		// vMerge is what docx uses to denote that table cell is part of rowspan. First
-		// cell has vMerge - start of rowspan, and vMerge will be denoted with `restart`.
-		// If it is anything other than restart then it is continuation of another rowspan
-		auto vMerge = child.child("w:tcPr").child("w:vMerge");
-		std::string vMergeVal = vMerge.attribute("w:val").value();
-        if (vMerge && vMergeVal != "restart")
-			continue;
-
-		// Loop through each and build list of all content
-		for (const auto& tdContent : child) {
-			// Since we are doing look-a-heads in this loop we need to check already visited nodes
-			if (find(m_visitedNodeList.begin(), m_visitedNodeList.end(), tdContent) !=
-                m_visitedNodeList.end())
+pugi::xml_node Docx::nextTableCell(BlockFrame& table) {
+	while (table.next) {
+		for (auto cell = table.nextCell; cell; cell = cell.next_sibling("w:tc")) {
+			// vMerge is what docx uses to denote that table cell is part of rowspan. First
+			// cell has vMerge - start of rowspan, and vMerge will be denoted with `restart`.
+			// If it is anything other than restart then it is continuation of another rowspan
+			auto vMerge = cell.child("w:tcPr").child("w:vMerge");
+			if (vMerge && strcmp(vMerge.attribute("w:val").value(), "restart") != 0)
 				continue;
 
-			std::string tdContentName = tdContent.name();
-			// Check to see if it is list or regular paragraph
-			// If it is a list, create list and update m_visitedNodeList
-			if (isLi(tdContent)) {
-                buildList(tdContent);
-            } else if (tdContentName == "w:tbl") {
-                buildTable(tdContent);
-			}
-			// Do nothing
-			else if (tdContentName == "w:tcPr") {
-				m_visitedNodeList.push_back(tdContent);
-				continue;
-			}
-			else {
-                getParagraphText(tdContent);
-			}
+			table.nextCell = cell.next_sibling("w:tc");
+			return cell;
 		}
+		table.next     = table.next.next_sibling("w:tr");
+		table.nextCell = table.next.child("w:tc");
 	}
+	return {};
 }
 
-// List
-void Docx::buildList(const pugi::xml_node& xmlNode) {
-	// Need to keep track of current indentation level
-	int currentIndentationLevel = -1;
-	// Need to keep track of current list id
-	std::string currentListId = "-1";
-	// Need to keep track of list that new `li` tags should be added too
-	pugi::xml_node node;
-
-	// Get consecutive `li` tags that have content
-	std::vector<pugi::xml_node> liNodes;
-	getListNodes(xmlNode, liNodes);
-
-	for (const auto& li : liNodes) {
-		if (!isLi(li)) {
-			// Get content and visited nodes
-            buildNonListContent(li);
-			m_visitedNodeList.emplace_back(li);
-			continue;
-		}
+// Blocks
+void Docx::buildBlocks(const pugi::xml_node& xmlNode, bool isBody) {
+	const size_t base = m_blocks.size();
+	pushBlocks(xmlNode, isBody);
+	readBlocks(base);
+}
 
-		int ilvl = getIndentationLevel(li);
-		std::string numId = getNumberingId(li);
-        if (m_numberingMap.find(numId) == m_numberingMap.end())
-            continue;
+void Docx::pushBlocks(const pugi::xml_node& xmlNode, bool isBody) {
+	if (m_blocks.size() >= m_maxNesting)
+		return;
+	m_blocks.push_back({xmlNode.first_child(), {}, false, isBody, {}});
+}
 
-        const auto &list = m_numberingMap[numId];
-        if (ilvl + 1 > list.size())
-            continue;
+void Docx::readBlocks(size_t base) {
+	while (m_blocks.size() > base) {
+		// Text limit reached: unwind without looking at the rest
+		if (shouldStopProcessing()) {
+			m_blocks.resize(base);
+			return;
+		}
 
-        std::string listType = list[ilvl];
-		if (listType.empty())
-			listType = "decimal";
+		BlockFrame& frame = m_blocks.back();
+		if (frame.isTable) {
+			if (const auto cell = nextTableCell(frame))
+				pushBlocks(cell, false);
+			else
+				m_blocks.pop_back();
+			continue;
+		}
+		const auto node = frame.next;
+		if (!node) {
+			m_blocks.pop_back();
+			continue;
+		}
+		frame.next = node.next_sibling();
+		// May push frames: `frame` (and its list) stays where it is in deque
+		buildBlock(node, frame.isBody, frame.list);
+	}
+}
 
-		// If ilvl is greater than current indentation level or list id is changing then we have
-		// first li tag in nested list. Need to create new list object and update all variables
-		if (ilvl > currentIndentationLevel || numId != currentListId) {
-			currentIndentationLevel = ilvl;
-			currentListId           = numId;
+void Docx::buildBlock(const pugi::xml_node& node, bool isBody, ListState& list) {
+	// Content following list item belongs to the list until an item of
+	// another list (or of upper level) is found
+	if (list.isActive) {
+		if (continuesList(node, list)) {
+			if (isLi(node))
+				buildListItem(node, list);
+			else
+				buildNonListContent(node);
+			return;
 		}
+		list.isActive = false;
+	}
 
-		// Add li element to tree
-        getParagraphText(li);
+	const ooxml::XmlTag tag = ooxml::tagOf(node.name());
+	if (!isBody) {
+		// Table cell: everything except cell properties is a paragraph
+		if (isLi(node))
+			startList(node, list);
+		else if (tag == ooxml::XmlTag::WTbl)
+			buildTable(node);
+		else if (tag != ooxml::XmlTag::WTcPr)
+			getParagraphText(node);
+		return;
+	}
 
-		m_visitedNodeList.push_back(li);
+	if (tag == ooxml::XmlTag::WSectPr)
+		return;
+	if (!isHeader(node).empty()) {
+        getParagraphText(node);
+	}
+	else if (tag == ooxml::XmlTag::WP) {
+		// Certain `p` tags denoted as `Title` tags. Strip out them
+		auto pStyle = node.child("w:pPr").child("w:pStyle");
+		std::string isTitle = pStyle.attribute("w:val").value();
+		if (isTitle == "Title")
+			return;
+		if (isLi(node))
+			startList(node, list);
+		// Handle generic `p` tag
+		else
+            getParagraphText(node);
+	}
+	else if (tag == ooxml::XmlTag::WTbl) {
+        buildTable(node);
 	}
 }
 
-void Docx::getListNodes(const pugi::xml_node& node, std::vector<pugi::xml_node>& liNodes) const {
-	liNodes.emplace_back(node);
-	std::string currentNumId  = getNumberingId(node);
-	int startIndentationLevel = getIndentationLevel(node);
-	for (auto li = node; li; li = li.next_sibling()) {
-		if (!li.child_value())
-			continue;
+// List
+void Docx::startList(const pugi::xml_node& xmlNode, ListState& list) {
+	list.isActive   = true;
+	list.numId      = getNumberingId(xmlNode);
+	list.startLevel = getIndentationLevel(xmlNode);
 
-		// Stop lists if come across list item that should be heading
-		if (isTopLevel(li))
-			break;
-		bool isListItem = isLi(li);
-		if (isListItem && (startIndentationLevel > getIndentationLevel(li)))
-			break;
+	buildListItem(xmlNode, list);
+}
 
-		std::string numId = getNumberingId(li);
-		// Not `p` tag or list item
-		if (numId.empty() || numId == "-1") {
-			liNodes.emplace_back(li);
-			continue;
-		}
-		// If list id of next tag is different that previous that means new list (not nested)
-		if (currentNumId != numId) {
-			break;
-		}
-		if (isListItem && isLastLi(li, currentNumId)) {
-			liNodes.emplace_back(li);
-			break;
-		}
-		liNodes.emplace_back(li);
-	}
+bool Docx::continuesList(const pugi::xml_node& node, const ListState& list) {
+	// Stop lists if come across list item that should be heading
+	if (isTopLevel(node))
+		return false;
+	if (isLi(node) && list.startLevel > getIndentationLevel(node))
+		return false;
+
+	std::string numId = getNumberingId(node);
+	// Not `p` tag or list item
+	if (numId.empty() || numId == "-1")
+		return true;
+	// If list id of next tag is different that previous that means new list (not nested)
+	return numId == list.numId;
+}
+
+void Docx::buildListItem(const pugi::xml_node& xmlNode, const ListState& list) {
+	const Numbering* numbering = findNumbering(list.numId);
+	if (!numbering)
+		return;
+
+	// Items of levels missing in numbering definition are dropped
+	int ilvl = getIndentationLevel(xmlNode);
+	if (ilvl + 1 > static_cast<int>(numbering->levels))
+		return;
+
+	// Add li element to tree
+	getParagraphText(xmlNode);
 }
 
 int Docx::getIndentationLevel(const pugi::xml_node& node) const {
-	auto ilvl = node.select_node(".//w:ilvl");
+	auto ilvl = getNumberingProperties(node).child("w:ilvl");
 	if (!ilvl)
 		return -1;
-	return ilvl.node().attribute("w:val").as_int();
+	return ilvl.attribute("w:val").as_int();
 }
 
-bool Docx::isLi(const pugi::xml_node& node) const {
+bool Docx::isLi(const pugi::xml_node& node) {
 	if (!isHeader(node).empty())
 		return false;
 	return hasIndentationLevel(node);
 }
 
-bool Docx::isTopLevel(const pugi::xml_node& node) const {
+bool Docx::isTopLevel(const pugi::xml_node& node) {
 	int ilvl = getIndentationLevel(node);
 	if (ilvl != 0)
 		return false;
 
-    auto numId = getNumberingId(node);
-    if (m_numberingMap.find(numId) == m_numberingMap.end())
-        return false;
-
-    return (m_numberingMap.at(numId)[ilvl] == "upperRoman");
-}
-
-bool Docx::isLastLi(const pugi::xml_node& node, const std::string& currentNumId) const {
-	for (auto li = node; li; li = li.next_sibling()) {
-		if (!isLi(li))
-			continue;
-
-		if (currentNumId != getNumberingId(li))
-			return true;
-		// If here, we have found another list item in current list, so `li` is not last
-		return false;
-	}
-	// If we run out of element this must be last list item
-	return true;
+	const Numbering* numbering = findNumbering(getNumberingId(node));
+	return numbering && numbering->isUpperRoman;
 }
 
 void Docx::buildNonListContent(const pugi::xml_node& xmlNode) {
-	std::string nodeName = xmlNode.name();
-	if (nodeName == "w:tbl") {
+	const ooxml::XmlTag tag = ooxml::tagOf(xmlNode.name());
+	if (tag == ooxml::XmlTag::WTbl) {
         buildTable(xmlNode);
-    } else if (nodeName == "w:p") {
+    } else if (tag == ooxml::XmlTag::WP) {
         getParagraphText(xmlNode);
 	}
 }
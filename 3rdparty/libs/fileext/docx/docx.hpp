@@ -9,9 +9,14 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include <pugixml.hpp>
 
 #include "fileext/fileext.hpp"
@@ -32,6 +37,18 @@ namespace docx {
  */
 class Docx: public fileext::FileExtension, public ooxml::Ooxml {
 public:
+	/** Story parts of document (bit mask for setParts()) */
+	enum Part : unsigned {
+		PartBody      = 1 << 0,  ///< `word/document.xml`
+		PartHeaders   = 1 << 1,  ///< Headers of all sections
+		PartFooters   = 1 << 2,  ///< Footers of all sections
+		PartFootnotes = 1 << 3,  ///< `word/footnotes.xml`
+		PartEndnotes  = 1 << 4,  ///< `word/endnotes.xml`
+		PartComments  = 1 << 5,  ///< `word/comments.xml`
+		PartTextBoxes = 1 << 6,  ///< `w:txbxContent` of shapes in the selected parts
+		PartAll       = (1 << 7) - 1
+	};
+
 	/**
 	 * @param[in] fileName
 	 *     File name
@@ -55,23 +72,116 @@ public:
 	 */
     int convert(bool addStyle = true, bool extractImages = false, char mergingMode = 0) override;
 
+	/**
+	 * @brief
+	 *     Select story parts to extract
+	 * @details
+	 *     Parts are read in order body, headers, footers, footnotes, endnotes
+	 *     and comments; parts of one kind (headers of several sections) in
+	 *     the order of document relationships
+	 * @param[in] parts
+	 *     Part flags, PartBody by default
+	 * @since 1.2
+	 */
+	void setParts(unsigned parts) { m_parts = parts; }
+
 private:
+	/**
+	 * @brief
+	 *     Read part text with fast text-run scanner
+	 * @details
+	 *     Only `w:t` text and `w:p` boundaries are read; lists, headers, titles
+	 *     and hyperlink targets aren't interpreted. Text boxes are always read.
+	 * @param[in] fileName
+	 *     Part name
+	 * @since 1.2
+	 */
+	void getTextFast(const std::string& fileName);
+
+	/**
+	 * @brief
+	 *     Read header, footer, notes or comments part
+	 * @param[in] part
+	 *     Part kind
+	 * @param[in] fileName
+	 *     Part name
+	 * @since 1.2
+	 */
+	void buildStoryPart(Part part, const std::string& fileName);
+
+	/**
+	 * @brief
+	 *     List being read: item that started it and content following it
+	 */
+	struct ListState {
+		/** True while content belongs to list */
+		bool isActive = false;
+		/** List id */
+		std::string numId;
+		/** Indentation level of first item */
+		int startLevel = -1;
+	};
+
+	/**
+	 * @brief
+	 *     Open block container or table of block walk
+	 */
+	struct BlockFrame {
+		/** Next block (container) or current row (table) */
+		pugi::xml_node next;
+		/** Next cell of current row (table) */
+		pugi::xml_node nextCell;
+		/** True for `w:tbl` */
+		bool isTable;
+		/** True for document body, false for table cell */
+		bool isBody;
+		/** State of list being read in container */
+		ListState list;
+	};
+
+	/**
+	 * @brief
+	 *     Paragraph style that makes paragraph a heading
+	 */
+	struct HeadingStyle {
+		/** Offset of style id in `m_styleIds` */
+		uint32_t idOffset;
+		/** Style id length */
+		uint32_t idSize;
+		/** `H` tag */
+		const char* tag;
+	};
+
+	/**
+	 * @brief
+	 *     List definition used by numbering id
+	 */
+	struct Numbering {
+		/** Numbering id (`w:num/@w:numId`) */
+		int numId;
+		/** Number of defined levels */
+		unsigned levels;
+		/** True if first level is numbered with upper roman numbers */
+		bool isUpperRoman;
+	};
+
 	/// @name General
 	/// @{
 	/**
 	 * @brief
-	 *     Get `word/numbering.xml` content
+	 *     Get `word/numbering.xml` content (once, on first use)
 	 * @details
-	 *     Stores how lists should look (unordered, digits, ...).
-	 *     Parse it and create map of what each combination should be based on list id and
-	 *     level of indentation.
+	 *     Stores how lists should look: the part is streamed and only level
+	 *     count and format of first level are kept for every list id.
 	 * @since 1.0
 	 */
 	void getNumberingMap();
 
 	/**
 	 * @brief
-	 *     Get `word/styles.xml` content
+	 *     Get `word/styles.xml` content (once, on first use)
+	 * @details
+	 *     The part is streamed, only ids of heading styles are kept.
 	 * @note
 	 *     Some things that considered lists are actually supposed
 	 *     to be `H` tags (h1, h2, ...). These can be denoted by their styleId.
@@ -81,10 +191,21 @@ private:
 
 	/**
 	 * @brief
-	 *     Get `word/_rels/document.xml.rels` content
+	 *     Find list definition
+	 * @param[in] numId
+	 *     Numbering id
+	 * @return
+	 *     Definition or nullptr if list id is unknown
+	 * @since 1.2
+	 */
+	const Numbering* findNumbering(std::string_view numId);
+
+	/**
+	 * @brief
+	 *     Get `word/_rels/document.xml.rels` content (once, on first use)
 	 * @details
 	 *     Stores targets to links as well as targets for images.
-	 *     Create map based on the relationship id and target.
+	 *     Create map based on the relationship id and target, and list story parts.
 	 * @since 1.0
 	 */
 	void getRelationshipMap();
@@ -98,7 +219,7 @@ private:
 	 *     `H` tag if element is header
 	 * @since 1.0
 	 */
-	std::string isHeader(const pugi::xml_node& node) const;
+	std::string isHeader(const pugi::xml_node& node);
 
 	/**
 	 * @brief
@@ -109,7 +230,18 @@ private:
 	 *     `H` tag if element is header
 	 * @since 1.0
 	 */
-	std::string isNaturalHeader(const pugi::xml_node& node) const;
+	std::string isNaturalHeader(const pugi::xml_node& node);
+
+	/**
+	 * @brief
+	 *     Get numbering properties (`w:pPr/w:numPr`) of paragraph
+	 * @param[in] node
+	 *     XML-node
+	 * @return
+	 *     `w:numPr` node, empty if element isn't numbered paragraph
+	 * @since 1.2
+	 */
+	static pugi::xml_node getNumberingProperties(const pugi::xml_node& node);
 
 	/**
 	 * @brief
@@ -144,28 +276,47 @@ private:
 	 *     Get paragraph text
 	 * @details
 	 *     `P` tags are made up of several runs (`r` tags) of text. Takes `p` tag and
-	 *     constructs text that should be part of `p` tag.
+	 *     constructs text that should be part of `p` tag. Text boxes anchored in
+	 *     paragraph are queued to the block walk.
 	 * @param[in] xmlNode
 	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
+	 * @param[in] depth
+	 *     Nesting of hyperlinks, insert and smart tags
 	 * @since 1.0
 	 */
-    void getParagraphText(const pugi::xml_node& xmlNode);
+    void getParagraphText(const pugi::xml_node& xmlNode, unsigned depth = 0);
 
 	/**
 	 * @brief
 	 *     Get element text
 	 * @details
 	 *     It turns out that `r` tags can contain both `t` tags and drawing tags.
-	 *     Since we need both, this function will get them in order in which they are found
+	 *     Since we need both, this function will get them in order in which they are found.
+	 *     Of `mc:AlternateContent` only the branch selected by ooxml::selectAlternateContent() is read.
 	 * @param[in] xmlNode
 	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
+	 * @param[out] textBoxes
+	 *     Text boxes of run drawings (if PartTextBoxes is selected)
+	 * @param[in] depth
+	 *     Nesting of `mc:AlternateContent`
 	 * @since 1.0
 	 */
-    std::string getElementText(const pugi::xml_node& xmlNode);
+    std::string getElementText(const pugi::xml_node& xmlNode, std::vector<pugi::xml_node>& textBoxes,
+                               unsigned depth = 0);
+
+	/**
+	 * @brief
+	 *     Find `w:txbxContent` nodes in drawing
+	 * @param[in] xmlNode
+	 *     `w:drawing`, `w:pict` or selected branch of `mc:AlternateContent`
+	 * @param[out] textBoxes
+	 *     Found text boxes
+	 * @param[in] depth
+	 *     Nesting of `mc:AlternateContent`
+	 * @since 1.2
+	 */
+	void findTextBoxes(const pugi::xml_node& xmlNode, std::vector<pugi::xml_node>& textBoxes,
+	                   unsigned depth = 0) const;
 	/// @}
 
 	/// @name Hyperlink
@@ -175,60 +326,144 @@ private:
 	 *     Create hyperlink
 	 * @param[in] xmlNode
 	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
+	 * @param[in] depth
+	 *     Nesting of hyperlinks, insert and smart tags
 	 * @since 1.0
 	 */
-    void buildHyperlink(const pugi::xml_node& xmlNode);
+    void buildHyperlink(const pugi::xml_node& xmlNode, unsigned depth);
 	/// @}
 
 	/// @name Table
 	/// @{
 	/**
 	 * @brief
-	 *     Create table with all rows and cells correctly populated
+	 *     Queue table to block walk
+	 * @details
+	 *     Cells are read by readBlocks() in row order. Tables nested deeper
+	 *     than the nesting cap are skipped.
 	 * @param[in] xmlNode
-	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
+	 *     `w:tbl` node
 	 * @since 1.0
 	 */
     void buildTable(const pugi::xml_node& xmlNode);
 
 	/**
 	 * @brief
-	 *     Create single tr element, with all tds already populated
+	 *     Take next cell of table
+	 * @details
+	 *     Continuation cells of rowspan are skipped
+	 * @param[in,out] table
+	 *     Table frame
+	 * @return
+	 *     `w:tc` node or empty node after the last row
+	 * @since 1.2
+	 */
+	static pugi::xml_node nextTableCell(BlockFrame& table);
+	/// @}
+
+	/// @name Blocks
+	/// @{
+	/**
+	 * @brief
+	 *     Read block content (paragraphs, lists, tables) in one pass
+	 * @details
+	 *     Every child is looked at once, only the state of current list is kept
 	 * @param[in] xmlNode
-	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
-	 * @since 1.0
+	 *     `w:body` or `w:tc` node
+	 * @param[in] isBody
+	 *     True for document body, false for table cell
+	 * @since 1.2
+	 */
+	void buildBlocks(const pugi::xml_node& xmlNode, bool isBody);
+
+	/**
+	 * @brief
+	 *     Queue block container to block walk
+	 * @details
+	 *     Containers nested deeper than the nesting cap are skipped
+	 * @param[in] xmlNode
+	 *     `w:body`, `w:tc`, `w:txbxContent`, header, footer or note node
+	 * @param[in] isBody
+	 *     True for document body, false for table cell
+	 * @since 1.2
 	 */
-    void buildTr(const pugi::xml_node& xmlNode);
+	void pushBlocks(const pugi::xml_node& xmlNode, bool isBody);
+
+	/**
+	 * @brief
+	 *     Run block walk until frames above `base` are done
+	 * @details
+	 *     Nested tables and text boxes are frames of `m_blocks`, not calls, so
+	 *     deep nesting doesn't grow the call stack
+	 * @param[in] base
+	 *     Frame count to return to
+	 * @since 1.2
+	 */
+	void readBlocks(size_t base);
+
+	/**
+	 * @brief
+	 *     Read one block of body or table cell
+	 * @param[in] node
+	 *     Child of `w:body` or `w:tc`
+	 * @param[in] isBody
+	 *     True for document body, false for table cell
+	 * @param[in,out] list
+	 *     State of list being read
+	 * @since 1.2
+	 */
+	void buildBlock(const pugi::xml_node& node, bool isBody, ListState& list);
+
+	/**
+	 * @brief
+	 *     Stream `word/document.xml` body block by block
+	 * @details
+	 *     Stops as soon as the text limit is reached, the rest of the part
+	 *     is neither inflated nor parsed
+	 * @since 1.2
+	 */
+	void buildBody();
+	/// @}
 
 	/// @name List
 	/// @{
 	/**
 	 * @brief
-	 *     Build list structure
+	 *     Start list with its first item
 	 * @param[in] xmlNode
 	 *     XML-node
-	 * @param[out] htmlNode
-	 *     Parent HTML-node
-	 * @since 1.0
+	 * @param[out] list
+	 *     List state
+	 * @since 1.2
 	 */
-    void buildList(const pugi::xml_node& xmlNode);
+	void startList(const pugi::xml_node& xmlNode, ListState& list);
 
 	/**
 	 * @brief
-	 *     Find consecutive `li` tags that have content that have the same list id
+	 *     Check if node belongs to current list
+	 * @details
+	 *     Lists end on an item of upper level, an item of another list or an
+	 *     item that should be heading. Content without list id stays in list.
 	 * @param[in] node
 	 *     XML-node
-	 * @param[out] liNodes
-	 *     Consecutive `li` tags list
-	 * @since 1.0
+	 * @param[in] list
+	 *     List state
+	 * @return
+	 *     True if node continues list
+	 * @since 1.2
 	 */
-	void getListNodes(const pugi::xml_node& node, std::vector<pugi::xml_node>& liNodes) const;
+	bool continuesList(const pugi::xml_node& node, const ListState& list);
+
+	/**
+	 * @brief
+	 *     Build list item
+	 * @param[in] xmlNode
+	 *     XML-node
+	 * @param[in] list
+	 *     List state
+	 * @since 1.2
+	 */
+	void buildListItem(const pugi::xml_node& xmlNode, const ListState& list);
 
 	/**
 	 * @brief
@@ -256,7 +491,7 @@ private:
 	 *     If element is `li`
 	 * @since 1.0
 	 */
-	bool isLi(const pugi::xml_node& node) const;
+	bool isLi(const pugi::xml_node& node);
 
 	/**
 	 * @brief
@@ -270,22 +505,7 @@ private:
 	 *     True if list in the root document
 	 * @since 1.0
 	 */
-	bool isTopLevel(const pugi::xml_node& node) const;
-
-	/**
-	 * @brief
-	 *     Check if `li` is last
-	 * @details
-	 *     Determine if `li` is last list item for given list.
-	 * @param[in] node
-	 *     XML-node
-	 * @param[in] currentNumId
-	 *     Current numId
-	 * @return
-	 *     True if `li` is last list item
-	 * @since 1.0
-	 */
-	bool isLastLi(const pugi::xml_node& node, const std::string& currentNumId) const;
+	bool isTopLevel(const pugi::xml_node& node);
 
 	/**
 	 * @brief
@@ -299,14 +519,24 @@ private:
     void buildNonListContent(const pugi::xml_node& xmlNode);
 	/// @}
     int m_maxLen = 0;
-	/** Stores how lists should look (unordered, digits, ...) */
-	std::unordered_map<std::string, std::vector<std::string>> m_numberingMap;
-	/** Some document style information */
-	std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_styleMap;
+	/** Selected story parts */
+	unsigned m_parts = PartBody;
+	/** Story parts from document relationships (kind and part name) */
+	std::vector<std::pair<Part, std::string>> m_storyParts;
+	/** Lazy loading flags of numbering, style and relationship maps */
+	bool m_numberingMapLoaded    = false;
+	bool m_styleMapLoaded        = false;
+	bool m_relationshipMapLoaded = false;
+	/** List definitions sorted by numbering id */
+	std::pmr::vector<Numbering> m_numberings;
+	/** Interned ids of heading styles */
+	std::pmr::string m_styleIds;
+	/** Heading styles sorted by id */
+	std::pmr::vector<HeadingStyle> m_headingStyles;
+	/** Open frames of block walk (deque: list state of a frame stays in place) */
+	std::pmr::deque<BlockFrame> m_blocks;
 	/** Stores targets to links as well as targets for images */
-	std::unordered_map<std::string, std::string> m_relationshipMap;
-	/** List of visited elements */
-	std::vector<pugi::xml_node> m_visitedNodeList;
+	std::pmr::unordered_map<std::pmr::string, std::pmr::string> m_relationshipMap;
 	/** Stores table border style */
 	std::unordered_map<std::string, std::string> m_borderMap;
 };
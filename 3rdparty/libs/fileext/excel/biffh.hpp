@@ -8,9 +8,12 @@
  */
 #pragma once
 
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 
+#include "tools.hpp"
+
 
 namespace excel {
 
@@ -137,20 +140,21 @@ enum {
 	XL_XF3                = 0x0243,  ///< BIFF3 version of XF record
 	XL_XF4                = 0x0443,  ///< BIFF4 version of XF record
 };
-/** Cell type from format type */
-const std::unordered_map<int, int> CELL_TYPE_FROM_FORMAT_TYPE {
-	{FNU, XL_CELL_NUMBER},
+/** Cell type from format type (sorted by key) */
+inline constexpr tools::TableEntry<int, int> CELL_TYPE_FROM_FORMAT_TYPE[] {
 	{FUN, XL_CELL_NUMBER},
-	{FGE, XL_CELL_NUMBER},
 	{FDT, XL_CELL_DATE},
+	{FNU, XL_CELL_NUMBER},
+	{FGE, XL_CELL_NUMBER},
 	{FTX, XL_CELL_NUMBER}  // Yes, number can be formatted as text
 };
+static_assert(tools::isSortedTable(CELL_TYPE_FROM_FORMAT_TYPE), "CELL_TYPE_FROM_FORMAT_TYPE must be sorted");
 /** BOF codes */
-const std::vector<int> BOF_CODES = {
+inline constexpr int BOF_CODES[] {
 	0x0809, 0x0409, 0x0209, 0x0009
 };
-/** Error text from code */
-const std::unordered_map<int, std::string> ERROR_TEXT_FROM_CODE {
+/** Error text from code (sorted by key) */
+inline constexpr tools::TableEntry<int, const char*> ERROR_TEXT_FROM_CODE[] {
 	{0x00, "#NULL!"},  // Intersection of two cell ranges is empty
 	{0x07, "#DIV/0!"}, // Division by zero
 	{0x0F, "#VALUE!"}, // Wrong type of operand
@@ -159,15 +163,17 @@ const std::unordered_map<int, std::string> ERROR_TEXT_FROM_CODE {
 	{0x24, "#NUM!"},   // Value range overflow
 	{0x2A, "#N/A"}     // Argument or function not available
 };
-/** Error code from text */
-const std::unordered_map<std::string, int> ERROR_CODE_FROM_TEXT {
-	{"#NULL!",  0x00},  // Intersection of two cell ranges is empty
+static_assert(tools::isSortedTable(ERROR_TEXT_FROM_CODE), "ERROR_TEXT_FROM_CODE must be sorted");
+/** Error code from text (sorted by key) */
+inline constexpr tools::TableEntry<std::string_view, int> ERROR_CODE_FROM_TEXT[] {
 	{"#DIV/0!", 0x07},  // Division by zero
-	{"#VALUE!", 0x0F},  // Wrong type of operand
-	{"#REF!",   0x17},  // Illegal or deleted cell reference
+	{"#N/A",    0x2A},  // Argument or function not available
 	{"#NAME?",  0x1D},  // Wrong function or range name
+	{"#NULL!",  0x00},  // Intersection of two cell ranges is empty
 	{"#NUM!",   0x24},  // Value range overflow
-	{"#N/A",    0x2A}   // Argument or function not available
+	{"#REF!",   0x17},  // Illegal or deleted cell reference
+	{"#VALUE!", 0x0F}   // Wrong type of operand
 };
+static_assert(tools::isSortedTable(ERROR_CODE_FROM_TEXT), "ERROR_CODE_FROM_TEXT must be sorted");
 
 }  // End namespace
\ No newline at end of file
@@ -6,7 +6,9 @@
  * @copyright python-excel (https://github.com/python-excel/xlrd)
  * @date      02.12.2016 -- 29.01.2018
  */
+#include <algorithm>
 #include <fstream>
+#include <string_view>
 
 #include "encoding/encoding.hpp"
 #include "tools.hpp"
@@ -32,33 +34,35 @@ const int XL_WORKBOOK_GLOBALS_4W = 0x100;
 const int XL_WORKSHEET = 0x10;
 const int XL_BOUNDSHEET_WORKSHEET = 0x00;
 /** BIFF supported versions */
-const std::vector<int> SUPPORTED_VERSIONS {80, 70, 50, 45, 40, 30, 21, 20};
-/** BOF length list */
-const std::unordered_map<int, int> BOF_LENGTH {
-	{0x0809, 8},
-	{0x0409, 6},
+constexpr int SUPPORTED_VERSIONS[] {80, 70, 50, 45, 40, 30, 21, 20};
+/** BOF length list (sorted by key) */
+constexpr tools::TableEntry<int, int> BOF_LENGTH[] {
+	{0x0009, 4},
 	{0x0209, 6},
-	{0x0009, 4}
+	{0x0409, 6},
+	{0x0809, 8}
 };
-/** Get built-in name from code */
-const std::unordered_map<std::string, std::string> BUILTIN_NAME_FROM_CODE {
-	{"Consolidate_Area", "\x00"},
-	{"Auto_Open",        "\x01"},
+static_assert(tools::isSortedTable(BOF_LENGTH), "BOF_LENGTH must be sorted");
+/** Get built-in name from code (sorted by key) */
+constexpr tools::TableEntry<std::string_view, const char*> BUILTIN_NAME_FROM_CODE[] {
+	{"Auto_Activate",    "\x0A"},
 	{"Auto_Close",       "\x02"},
-	{"Extract",          "\x03"},
-	{"Database",         "\x04"},
+	{"Auto_Deactivate",  "\x0B"},
+	{"Auto_Open",        "\x01"},
+	{"Consolidate_Area", "\x00"},
 	{"Criteria",         "\x05"},
+	{"Data_Form",        "\x09"},
+	{"Database",         "\x04"},
+	{"Extract",          "\x03"},
 	{"Print_Area",       "\x06"},
 	{"Print_Titles",     "\x07"},
 	{"Recorder",         "\x08"},
-	{"Data_Form",        "\x09"},
-	{"Auto_Activate",    "\x0A"},
-	{"Auto_Deactivate",  "\x0B"},
 	{"Sheet_Title",      "\x0C"},
 	{"_FilterDatabase",  "\x0D"}
 };
-/** Get encoding from codepage */
-const std::unordered_map<int, std::string> ENCODING_FROM_CODEPAGE {
+static_assert(tools::isSortedTable(BUILTIN_NAME_FROM_CODE), "BUILTIN_NAME_FROM_CODE must be sorted");
+/** Get encoding from codepage (sorted by key) */
+constexpr tools::TableEntry<int, const char*> ENCODING_FROM_CODEPAGE[] {
 	{1200,  "UTF-16LE"},
 	{10000, "MacRoman"},
 	{10006, "MacGreek"},
@@ -69,8 +73,9 @@ const std::unordered_map<int, std::string> ENCODING_FROM_CODEPAGE {
 	{32768, "MacRoman"},
 	{32769, "CP1252"}
 };
-/** BIFF text version */
-const std::unordered_map<int, std::string> BIFF_TEXT {
+static_assert(tools::isSortedTable(ENCODING_FROM_CODEPAGE), "ENCODING_FROM_CODEPAGE must be sorted");
+/** BIFF text version (sorted by key) */
+constexpr tools::TableEntry<int, const char*> BIFF_TEXT[] {
 	{0,  "(not BIFF)"},
 	{20, "2.0"},
 	{21, "2.1"},
@@ -82,10 +87,17 @@ const std::unordered_map<int, std::string> BIFF_TEXT {
 	{80, "8"},
 	{85, "8X"}
 };
+static_assert(tools::isSortedTable(BIFF_TEXT), "BIFF_TEXT must be sorted");
 
 // Book public:
-Book::Book(const std::string& fileName, std::string &text, bool addStyle)
-: Cfb(fileName), m_contentText(text), m_addStyle(addStyle) {}
+Book::Book(const std::string& fileName, std::string &text, [[maybe_unused]] bool addStyle,
+		   std::pmr::memory_resource* resource)
+: Cfb(fileName), m_contentText(text)
+#ifndef DOCPARSER_TEXT_ONLY
+, m_addStyle(addStyle)
+#endif
+, m_sharedStrings(resource)
+{}
 
 void Book::openWorkbookXls() {
 	// Read CFB part
@@ -98,10 +110,12 @@ void Book::openWorkbookXls() {
 	m_biffVersion = getBiffVersion(XL_WORKBOOK_GLOBALS);
 	if (!m_biffVersion)
 		throw std::logic_error("Can't determine file's BIFF version");
-	if (find(SUPPORTED_VERSIONS.begin(), SUPPORTED_VERSIONS.end(), m_biffVersion) ==
-		SUPPORTED_VERSIONS.end()
+	if (std::find(std::begin(SUPPORTED_VERSIONS), std::end(SUPPORTED_VERSIONS), m_biffVersion) ==
+		std::end(SUPPORTED_VERSIONS)
 	)
-		throw std::invalid_argument("BIFF version "+ BIFF_TEXT.at(m_biffVersion) +" is not supported");
+		throw std::invalid_argument(
+			std::string("BIFF version ") + tools::tableAt(BIFF_TEXT, m_biffVersion) +" is not supported"
+		);
 
 	if (m_biffVersion <= 40) {
 		// No workbook globals, only 1 worksheet
@@ -115,7 +129,7 @@ void Book::openWorkbookXls() {
 		parseGlobals();
 		m_sheetList.clear();
 		size_t sheetCount = m_sheetNames.size();
-		for (size_t i = 0; i < sheetCount; ++i)
+		for (size_t i = 0; i < sheetCount && !isPastDeadline(); ++i)
 			getSheet(i);
 	}
 	m_sheetCount = m_sheetList.size();
@@ -169,8 +183,8 @@ void Book::getEncoding() {
 			m_codePage = 1200;  // utf16le
 	}
 	else {
-		if (ENCODING_FROM_CODEPAGE.find(m_codePage) != ENCODING_FROM_CODEPAGE.end())
-			m_encoding = ENCODING_FROM_CODEPAGE.at(m_codePage);
+		if (const auto encoding = tools::findInTable(ENCODING_FROM_CODEPAGE, m_codePage))
+			m_encoding = *encoding;
 		else if (300 <= m_codePage && m_codePage <= 1999)
 			m_encoding = "cp" + std::to_string(m_codePage);
 		else
@@ -290,7 +304,7 @@ int Book::getBiffVersion(int streamSign) {
 	//int savpos  = m_position;
 	m_position += 4;
 
-	if (find(BOF_CODES.begin(), BOF_CODES.end(), signature) == BOF_CODES.end())
+	if (std::find(std::begin(BOF_CODES), std::end(BOF_CODES), signature) == std::end(BOF_CODES))
 		throw std::invalid_argument("Unsupported format, or corrupt file: Expected BOF record");
 	if (length < 4 || length > 20)
 		throw std::invalid_argument(
@@ -298,7 +312,7 @@ int Book::getBiffVersion(int streamSign) {
 			std::to_string(length) +") for BOF record type " + std::to_string(signature)
 		);
 
-	std::string padding(std::max(0, BOF_LENGTH.at(signature) - length), '\0');
+	std::string padding(std::max(0, tools::tableAt(BOF_LENGTH, signature) - length), '\0');
 	std::string data = m_workBook.substr(m_position, length);
 	if (data.size() < length)
 		throw std::invalid_argument("Unsupported format, or corrupt file: Incomplete BOF record[2]");
@@ -635,8 +649,8 @@ void Book::handleName(const std::string& data) {
 
 	if (!nobj.m_builtIn)
 		nobj.m_name = internalName;
-    else if (BUILTIN_NAME_FROM_CODE.find(internalName) != BUILTIN_NAME_FROM_CODE.end())
-		nobj.m_name = BUILTIN_NAME_FROM_CODE.at(internalName);
+	else if (const auto name = tools::findInTable(BUILTIN_NAME_FROM_CODE, internalName))
+		nobj.m_name = *name;
 	else
 		nobj.m_name = "??Unknown??";
 	nobj.m_rawFormula = data.substr(pos);
@@ -735,7 +749,7 @@ void Book::unpackSst(const std::vector<std::string>& dataTable, int stringCount)
 				dataLength = data.size();
 			}
 		}
-		m_sharedStrings.push_back(result);
+		m_sharedStrings.emplace_back(result);
 	}
 }
 
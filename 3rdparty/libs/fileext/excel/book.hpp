@@ -8,7 +8,9 @@
  */
 #pragma once
 
+#include <chrono>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -47,9 +49,12 @@ public:
 	 *     Should read and add styles to HTML-tree
 	 * @param mergingMode
 	 *     Colspan/rowspan processing mode
+	 * @param[in] resource
+	 *     Memory of shared strings (arena of conversion)
 	 * @since 1.0
 	 */
-    Book(const std::string& fileName, std::string& text, bool addStyle);
+    Book(const std::string& fileName, std::string& text, bool addStyle,
+         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	/**
 	 * @brief
@@ -160,8 +165,27 @@ public:
 
 	/** Result HTML tree */
     std::string& m_contentText;
+#ifdef DOCPARSER_TEXT_ONLY
+    /** Styles are never read in text-only build, style code is eliminated as dead */
+    static constexpr bool m_addStyle = false;
+#else
     /** Should read and add styles to HTML-tree */
     const bool m_addStyle;
+#endif
+	/** Read shared strings with the fast text-run scanner (xlsx) */
+	bool m_fastText = false;
+	/** Sheets aren't read past this time point (see FileExtension::setDeadline()) */
+	std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+
+	/**
+	 * @brief
+	 *     Check if `m_deadline` has passed
+	 * @since 1.2
+	 */
+	bool isPastDeadline() const {
+		return m_deadline != std::chrono::steady_clock::time_point::max() &&
+			   std::chrono::steady_clock::now() >= m_deadline;
+	}
 	/** Current position in the stream  */
 	int m_position = 0;
 	/**
@@ -172,7 +196,7 @@ public:
 	/** The number of worksheets in workbook */
 	size_t m_sheetCount;
 	/** All strings in workbook */
-	std::vector<std::string> m_sharedStrings;
+	std::pmr::vector<std::pmr::string> m_sharedStrings;
 	/** Sheet list */
 	std::vector<Sheet> m_sheetList;
 	/** Sheets names list */
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "fileext/fileext.hpp"
+#include "fileext/ooxml/ooxml.hpp"
 
 
 /**
@@ -26,8 +27,10 @@ namespace excel {
  * @class Excel
  * @brief
  *     Excel files (xls/xlsx) into HTML сonverter
+ * @details
+ *     The package session of an xlsx file stays open after convert().
  */
-class Excel: public fileext::FileExtension {
+class Excel: public fileext::FileExtension, public ooxml::Ooxml {
 public:
 	/**
 	 * @param[in] fileName
@@ -6,7 +6,12 @@
  * @copyright python-excel (https://github.com/python-excel/xlrd)
  * @date      02.12.2016 -- 28.01.2018
  */
+#include <algorithm>
+#include <iterator>
 #include <regex>
+#include <string_view>
+
+#include "tools.hpp"
 
 #include "biffh.hpp"
 
@@ -15,8 +20,8 @@
 
 namespace excel {
 
-/** Standard for US English locale format code types */
-const std::unordered_map<int, int> STD_FORMAT_CODE_TYPES {
+/** Standard for US English locale format code types (sorted by key) */
+constexpr tools::TableEntry<int, int> STD_FORMAT_CODE_TYPES[] {
 	{0,  FGE}, {1,  FNU}, {2,  FNU}, {3,  FNU}, {4,  FNU},
 	{5,  FNU}, {6,  FNU}, {7,  FNU}, {8,  FNU}, {9,  FNU},
 	{10, FNU}, {11, FNU}, {12, FNU}, {13, FNU}, {14, FDT},
@@ -33,8 +38,9 @@ const std::unordered_map<int, int> STD_FORMAT_CODE_TYPES {
 	{73, FDT}, {74, FDT}, {75, FDT}, {76, FDT}, {77, FDT},
 	{78, FDT}, {79, FDT}, {80, FDT}, {81, FDT}
 };
-/** Standard for US English locale format string */
-const std::unordered_map<int, std::string> STD_FORMAT_STRINGS {
+static_assert(tools::isSortedTable(STD_FORMAT_CODE_TYPES), "STD_FORMAT_CODE_TYPES must be sorted");
+/** Standard for US English locale format string (sorted by key) */
+constexpr tools::TableEntry<int, const char*> STD_FORMAT_STRINGS[] {
 	{0x00, "General"},
 	{0x01, "0"},
 	{0x02, "0.00"},
@@ -72,17 +78,18 @@ const std::unordered_map<int, std::string> STD_FORMAT_STRINGS {
 	{0x30, "##0.0E+0"},
 	{0x31, "@"}
 };
-/** Non date formats */
-const std::unordered_map<std::string, int> NON_DATE_FORMATS {
-	{"0.00E+00", 1},
-	{"##0.0E+0", 1},
-	{"General",  1},
-	{"GENERAL",  1},  // OOo Calc 1.1.4 does this
-	{"general",  1},  // pyExcelerator 0.6.3 does this
-	{"@",        1}
+static_assert(tools::isSortedTable(STD_FORMAT_STRINGS), "STD_FORMAT_STRINGS must be sorted");
+/** Non date formats (sorted) */
+constexpr std::string_view NON_DATE_FORMATS[] {
+	"##0.0E+0",
+	"0.00E+00",
+	"@",
+	"GENERAL",  // OOo Calc 1.1.4 does this
+	"General",
+	"general"   // pyExcelerator 0.6.3 does this
 };
 /** Built-in style name list */
-const std::vector<std::string> BUILIT_STYLE_NAMES {
+constexpr const char* BUILIT_STYLE_NAMES[] {
 	"Normal",
 	"RowLevel_",
 	"ColLevel_",
@@ -94,23 +101,26 @@ const std::vector<std::string> BUILIT_STYLE_NAMES {
 	"Hyperlink",
 	"Followed Hyperlink"
 };
-/** Skip charecters dictionary */
-const std::unordered_map<char, int> SKIP_CHAR_DICT {
-	{' ', 1}, {'$', 1}, {')', 1}, {'(', 1},
+/** Skip charecters dictionary (sorted by key) */
+constexpr tools::TableEntry<char, int> SKIP_CHAR_DICT[] {
+	{' ', 1}, {'$', 1}, {'(', 1}, {')', 1},
 	{'+', 1}, {'-', 1}, {'/', 1}, {':', 1}
 };
-/** Date charecters dictionary */
-const std::unordered_map<char, int> DATE_CHAR_DICT {
-	{'y', 5}, {'Y', 5}, {'m', 5}, {'M', 5},
-	{'d', 5}, {'D', 5}, {'h', 5}, {'H', 5},
-	{'s', 5}, {'S', 5}
+static_assert(tools::isSortedTable(SKIP_CHAR_DICT), "SKIP_CHAR_DICT must be sorted");
+/** Date charecters dictionary (sorted by key) */
+constexpr tools::TableEntry<char, int> DATE_CHAR_DICT[] {
+	{'D', 5}, {'H', 5}, {'M', 5}, {'S', 5},
+	{'Y', 5}, {'d', 5}, {'h', 5}, {'m', 5},
+	{'s', 5}, {'y', 5}
 };
-/** Number charecters dictionary */
-const std::unordered_map<char, int> NUMBER_CHAR_DICT = {
-	{'0', 5}, {'#', 5}, {'?', 5}
+static_assert(tools::isSortedTable(DATE_CHAR_DICT), "DATE_CHAR_DICT must be sorted");
+/** Number charecters dictionary (sorted by key) */
+constexpr tools::TableEntry<char, int> NUMBER_CHAR_DICT[] {
+	{'#', 5}, {'0', 5}, {'?', 5}
 };
+static_assert(tools::isSortedTable(NUMBER_CHAR_DICT), "NUMBER_CHAR_DICT must be sorted");
 /** BIFF 5 default palette */
-const std::vector<std::vector<unsigned char>> DEFAULT_PALETTE_B5 {
+constexpr unsigned char DEFAULT_PALETTE_B5[][3] {
 	{  0,   0,   0}, {255, 255, 255}, {255,   0,   0}, {  0, 255,   0},
 	{  0,   0, 255}, {255, 255,   0}, {255,   0, 255}, {  0, 255, 255},
 	{128,   0,   0}, {  0, 128,   0}, {  0,   0, 128}, {128, 128,   0},
@@ -126,11 +136,8 @@ const std::vector<std::vector<unsigned char>> DEFAULT_PALETTE_B5 {
 	{  0,  51, 102}, { 51, 153, 102}, {  0,  51,   0}, { 51,  51,   0},
 	{153,  51,   0}, {153,  51, 102}, { 51,  51, 153}, { 51,  51,  51}
 };
-/** BIFF 2 default palette */
-const std::vector<std::vector<unsigned char>> DEFAULT_PALETTE_B2(DEFAULT_PALETTE_B5.begin(),
-																 DEFAULT_PALETTE_B5.begin() + 16);
 /** BIFF 8 default palette */
-const std::vector<std::vector<unsigned char>> DEFAULT_PALETTE_B8 {  // {red, green, blue}
+constexpr unsigned char DEFAULT_PALETTE_B8[][3] {  // {red, green, blue}
 	{  0,   0,   0}, {255, 255, 255}, {255,   0,   0}, {  0, 255,   0}, // 0
 	{  0,   0, 255}, {255, 255,   0}, {255,   0, 255}, {  0, 255, 255}, // 4
 	{128,   0,   0}, {  0, 128,   0}, {  0,   0, 128}, {128, 128,   0}, // 8
@@ -146,19 +153,28 @@ const std::vector<std::vector<unsigned char>> DEFAULT_PALETTE_B8 {  // {red, gre
 	{  0,  51, 102}, { 51, 153, 102}, {  0,  51,   0}, { 51,  51,   0}, // 48
 	{153,  51,   0}, {153,  51, 102}, { 51,  51, 153}, { 51,  51,  51}  // 52
 };
-/** XLS Default palette */
-const std::unordered_map<int, std::vector<std::vector<unsigned char>>> DEFAULT_PALETTE {
-	{80, DEFAULT_PALETTE_B8},
-	{70, DEFAULT_PALETTE_B5},
-	{50, DEFAULT_PALETTE_B5},
-	{45, DEFAULT_PALETTE_B2},
-	{40, DEFAULT_PALETTE_B2},
-	{30, DEFAULT_PALETTE_B2},
-	{21, DEFAULT_PALETTE_B2},
-	{20, DEFAULT_PALETTE_B2}
+/** Default palette entry: first `size` colors of `colors` */
+struct DefaultPalette {
+	const unsigned char (*colors)[3];
+	int size;
+};
+/** XLS Default palette (sorted by key). BIFF 2 palette is first 16 colors of BIFF 5 one */
+constexpr tools::TableEntry<int, DefaultPalette> DEFAULT_PALETTE[] {
+	{20, {DEFAULT_PALETTE_B5, 16}},
+	{21, {DEFAULT_PALETTE_B5, 16}},
+	{30, {DEFAULT_PALETTE_B5, 16}},
+	{40, {DEFAULT_PALETTE_B5, 16}},
+	{45, {DEFAULT_PALETTE_B5, 16}},
+	{50, {DEFAULT_PALETTE_B5, static_cast<int>(std::size(DEFAULT_PALETTE_B5))}},
+	{70, {DEFAULT_PALETTE_B5, static_cast<int>(std::size(DEFAULT_PALETTE_B5))}},
+	{80, {DEFAULT_PALETTE_B8, static_cast<int>(std::size(DEFAULT_PALETTE_B8))}}
 };
-/** Format bracketed text regex */
-const std::regex FORMAT_BRACKETED_TEXT("\\[[^\\]]*\\]");
+static_assert(tools::isSortedTable(DEFAULT_PALETTE), "DEFAULT_PALETTE must be sorted");
+/** Format bracketed text regex (compiled on first use) */
+static const std::regex& formatBracketedText() {
+	static const std::regex regex("\\[[^\\]]*\\]");
+	return regex;
+}
 
 // Formatting public:
 Formatting::Formatting(Book* book)
@@ -170,12 +186,14 @@ void Formatting::initializeBook() {
 		return;
 	// Add 8 invariant colors
 	for (int i = 0; i < 8; ++i)
-		m_book->m_colorMap[i] = DEFAULT_PALETTE_B8[i];
+		m_book->m_colorMap[i].assign(std::begin(DEFAULT_PALETTE_B8[i]), std::end(DEFAULT_PALETTE_B8[i]));
 	// Add default palette depending on the version
-	auto& defaultPalette = DEFAULT_PALETTE.at(m_book->m_biffVersion);
-	int paletteSize = static_cast<int>(defaultPalette.size());
-	for (int i = 0; i < paletteSize; ++i)
-		m_book->m_colorMap[i+8] = defaultPalette[i];
+	const auto& defaultPalette = tools::tableAt(DEFAULT_PALETTE, m_book->m_biffVersion);
+	int paletteSize = defaultPalette.size;
+	for (int i = 0; i < paletteSize; ++i) {
+		const auto& color = defaultPalette.colors[i];
+		m_book->m_colorMap[i+8].assign(std::begin(color), std::end(color));
+	}
 	// Add the specials -- None means the RGB value is not known
 	// System window text color for border lines
 	//m_book->m_colorMap[paletteSize+8]   = {255, 255, 255};
@@ -310,12 +328,12 @@ void Formatting::handleXf(const std::string& data) {
 	// Fill in known standard formats, i.e. do this once before process first XF record
 	if (m_book->m_biffVersion >= 50 && !m_book->m_xfCount) {
 		for (const auto& x : STD_FORMAT_CODE_TYPES) {
-			if (m_book->m_formatMap.find(x.first) == m_book->m_formatMap.end()) {
+			if (m_book->m_formatMap.find(x.key) == m_book->m_formatMap.end()) {
 				// Note: many standard format codes (mostly CJK date formats) have format strings that
 				// vary by locale. Type (date or numeric) is recorded but formatString will be `None`
-				const int& type = STD_FORMAT_CODE_TYPES.at(x.first);
-				m_book->m_formatMap.emplace(x.first, Format(x.first, type,
-															STD_FORMAT_STRINGS.at(x.first)));
+				const int& type = x.value;
+				m_book->m_formatMap.emplace(x.key, Format(x.key, type,
+														  tools::tableAt(STD_FORMAT_STRINGS, x.key)));
 			}
 		}
 	}
@@ -546,7 +564,7 @@ void Formatting::handleXf(const std::string& data) {
 	int cellType = XL_CELL_NUMBER;
 	if (m_book->m_formatMap.find(xf.m_formatKey) != m_book->m_formatMap.end()) {
 		unsigned char type = m_book->m_formatMap[xf.m_formatKey].m_type;
-		cellType = CELL_TYPE_FROM_FORMAT_TYPE.at(type);
+		cellType = tools::tableAt(CELL_TYPE_FROM_FORMAT_TYPE, type);
 	}
 	m_book->m_xfIndexXlTypeMap[xf.m_xfIndex] = cellType;
 
@@ -631,7 +649,7 @@ void Formatting::xfEpilogue() {
 		int cellType = XL_CELL_TEXT;
 		if (m_book->m_formatMap.find(xf.m_formatKey) != m_book->m_formatMap.end()) {
 			unsigned char type = m_book->m_formatMap[xf.m_formatKey].m_type;
-			cellType = CELL_TYPE_FROM_FORMAT_TYPE.at(type);
+			cellType = tools::tableAt(CELL_TYPE_FROM_FORMAT_TYPE, type);
 		}
 		m_book->m_xfIndexXlTypeMap[xf.m_xfIndex] = cellType;
 
@@ -663,7 +681,7 @@ bool Formatting::isDateFormattedString(const std::string& format) {
 				state = 1;
 			else if (find(ch.begin(), ch.end(), c) == ch.end())
 				state = 2;
-			else if (SKIP_CHAR_DICT.find(c) == SKIP_CHAR_DICT.end())
+			else if (!tools::findInTable(SKIP_CHAR_DICT, c))
 				str += c;
 		}
 		else if (state == 1) {
@@ -676,8 +694,8 @@ bool Formatting::isDateFormattedString(const std::string& format) {
 		}
 	}
 
-	str = std::regex_replace(str, FORMAT_BRACKETED_TEXT, "");
-	if (NON_DATE_FORMATS.find(str) != NON_DATE_FORMATS.end())
+	str = std::regex_replace(str, formatBracketedText(), "");
+	if (std::binary_search(std::begin(NON_DATE_FORMATS), std::end(NON_DATE_FORMATS), str))
 		return false;
 
 	state = 0;
@@ -685,10 +703,10 @@ bool Formatting::isDateFormattedString(const std::string& format) {
 	int dateCount = 0;
 	int numCount  = 0;
 	for (const auto& c : str) {
-		if (DATE_CHAR_DICT.find(c) == DATE_CHAR_DICT.end())
-			dateCount += DATE_CHAR_DICT.at(c);
-		else if (NUMBER_CHAR_DICT.find(c) == NUMBER_CHAR_DICT.end())
-			numCount += NUMBER_CHAR_DICT.at(c);
+		if (!tools::findInTable(DATE_CHAR_DICT, c))
+			dateCount += tools::tableAt(DATE_CHAR_DICT, c);
+		else if (!tools::findInTable(NUMBER_CHAR_DICT, c))
+			numCount += tools::tableAt(NUMBER_CHAR_DICT, c);
 		//else if (c == ';')
 		//	got_sep = 1;
 	}
@@ -700,6 +718,7 @@ bool Formatting::isDateFormattedString(const std::string& format) {
 	return (dateCount > numCount);
 }
 
+#ifndef DOCPARSER_TEXT_ONLY
 int Formatting::getNearestColorIndex(std::unordered_map<int, std::vector<unsigned char>>& colorMap,
 									 std::vector<unsigned char>& rgb)
 {
@@ -720,6 +739,7 @@ int Formatting::getNearestColorIndex(std::unordered_map<int, std::vector<unsigne
 	}
 	return bestColor;
 }
+#endif
 
 
 // Format public:
@@ -120,6 +120,7 @@ public:
 	 */
 	static bool isDateFormattedString(const std::string& format);
 
+#ifndef DOCPARSER_TEXT_ONLY
 	/**
 	 * @brief
 	 *     Find nearest object color index in palette
@@ -136,6 +137,7 @@ public:
 	 */
 	static int getNearestColorIndex(std::unordered_map<int, std::vector<unsigned char>>& colorMap,
 									std::vector<unsigned char>& rgb);
+#endif
 
 	/** Pointer to parent Book object */
 	Book* m_book;
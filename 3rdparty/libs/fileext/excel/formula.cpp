@@ -6,7 +6,8 @@
  * @copyright python-excel (https://github.com/python-excel/xlrd)
  * @date      02.12.2016 -- 29.01.2018
  */
-#include <tuple>
+#include <algorithm>
+#include <array>
 #include <unordered_map>
 #include <math.h>
 
@@ -20,274 +21,281 @@
 namespace excel {
 
 /** List separator. Probably should depend on locale */
-const std::string LIST_SEPARATOR = ",";
+constexpr char LIST_SEPARATOR[] = ",";
 /** Default leaf rank */
 const char LEAF_RANK = 90;
 /** Default dunction rank */
 const char FUNC_RANK = 90;
-/** index, {name, min#args, max#args, flags, #known_args, return_type, kargs) */
-const std::unordered_map<int, std::tuple<std::string, char, char>> FUNC_DEFINITIONS {
-    {0,   std::tuple<std::string, char, char>("COUNT",            0, 30)},
-    {1,   std::tuple<std::string, char, char>("IF",               2,  3)},
-    {2,   std::tuple<std::string, char, char>("ISNA",             1,  1)},
-    {3,   std::tuple<std::string, char, char>("ISERROR",          1,  1)},
-    {4,   std::tuple<std::string, char, char>("SUM",              0, 30)},
-    {5,   std::tuple<std::string, char, char>("AVERAGE",          1, 30)},
-    {6,   std::tuple<std::string, char, char>("MIN",              1, 30)},
-    {7,   std::tuple<std::string, char, char>("MAX",              1, 30)},
-    {8,   std::tuple<std::string, char, char>("ROW",              0,  1)},
-    {9,   std::tuple<std::string, char, char>("COLUMN",           0,  1)},
-    {10,  std::tuple<std::string, char, char>("NA",               0,  0)},
-    {11,  std::tuple<std::string, char, char>("NPV",              2, 30)},
-    {12,  std::tuple<std::string, char, char>("STDEV",            1, 30)},
-    {13,  std::tuple<std::string, char, char>("DOLLAR",           1,  2)},
-    {14,  std::tuple<std::string, char, char>("FIXED",            2,  3)},
-    {15,  std::tuple<std::string, char, char>("SIN",              1,  1)},
-    {16,  std::tuple<std::string, char, char>("COS",              1,  1)},
-    {17,  std::tuple<std::string, char, char>("TAN",              1,  1)},
-    {18,  std::tuple<std::string, char, char>("ATAN",             1,  1)},
-    {19,  std::tuple<std::string, char, char>("PI",               0,  0)},
-    {20,  std::tuple<std::string, char, char>("SQRT",             1,  1)},
-    {21,  std::tuple<std::string, char, char>("EXP",              1,  1)},
-    {22,  std::tuple<std::string, char, char>("LN",               1,  1)},
-    {23,  std::tuple<std::string, char, char>("LOG10",            1,  1)},
-    {24,  std::tuple<std::string, char, char>("ABS",              1,  1)},
-    {25,  std::tuple<std::string, char, char>("INT",              1,  1)},
-    {26,  std::tuple<std::string, char, char>("SIGN",             1,  1)},
-    {27,  std::tuple<std::string, char, char>("ROUND",            2,  2)},
-    {28,  std::tuple<std::string, char, char>("LOOKUP",           2,  3)},
-    {29,  std::tuple<std::string, char, char>("INDEX",            2,  4)},
-    {30,  std::tuple<std::string, char, char>("REPT",             2,  2)},
-    {31,  std::tuple<std::string, char, char>("MID",              3,  3)},
-    {32,  std::tuple<std::string, char, char>("LEN",              1,  1)},
-    {33,  std::tuple<std::string, char, char>("VALUE",            1,  1)},
-    {34,  std::tuple<std::string, char, char>("TRUE",             0,  0)},
-    {35,  std::tuple<std::string, char, char>("FALSE",            0,  0)},
-    {36,  std::tuple<std::string, char, char>("AND",              1, 30)},
-    {37,  std::tuple<std::string, char, char>("OR",               1, 30)},
-    {38,  std::tuple<std::string, char, char>("NOT",              1,  1)},
-    {39,  std::tuple<std::string, char, char>("MOD",              2,  2)},
-    {40,  std::tuple<std::string, char, char>("DCOUNT",           3,  3)},
-    {41,  std::tuple<std::string, char, char>("DSUM",             3,  3)},
-    {42,  std::tuple<std::string, char, char>("DAVERAGE",         3,  3)},
-    {43,  std::tuple<std::string, char, char>("DMIN",             3,  3)},
-    {44,  std::tuple<std::string, char, char>("DMAX",             3,  3)},
-    {45,  std::tuple<std::string, char, char>("DSTDEV",           3,  3)},
-    {46,  std::tuple<std::string, char, char>("VAR",              1, 30)},
-    {47,  std::tuple<std::string, char, char>("DVAR",             3,  3)},
-    {48,  std::tuple<std::string, char, char>("TEXT",             2,  2)},
-    {49,  std::tuple<std::string, char, char>("LINEST",           1,  4)},
-    {50,  std::tuple<std::string, char, char>("TREND",            1,  4)},
-    {51,  std::tuple<std::string, char, char>("LOGEST",           1,  4)},
-    {52,  std::tuple<std::string, char, char>("GROWTH",           1,  4)},
-    {56,  std::tuple<std::string, char, char>("PV",               3,  5)},
-    {57,  std::tuple<std::string, char, char>("FV",               3,  5)},
-    {58,  std::tuple<std::string, char, char>("NPER",             3,  5)},
-    {59,  std::tuple<std::string, char, char>("PMT",              3,  5)},
-    {60,  std::tuple<std::string, char, char>("RATE",             3,  6)},
-    {61,  std::tuple<std::string, char, char>("MIRR",             3,  3)},
-    {62,  std::tuple<std::string, char, char>("IRR",              1,  2)},
-    {63,  std::tuple<std::string, char, char>("RAND",             0,  0)},
-    {64,  std::tuple<std::string, char, char>("MATCH",            2,  3)},
-    {65,  std::tuple<std::string, char, char>("DATE",             3,  3)},
-    {66,  std::tuple<std::string, char, char>("TIME",             3,  3)},
-    {67,  std::tuple<std::string, char, char>("DAY",              1,  1)},
-    {68,  std::tuple<std::string, char, char>("MONTH",            1,  1)},
-    {69,  std::tuple<std::string, char, char>("YEAR",             1,  1)},
-    {70,  std::tuple<std::string, char, char>("WEEKDAY",          1,  2)},
-    {71,  std::tuple<std::string, char, char>("HOUR",             1,  1)},
-    {72,  std::tuple<std::string, char, char>("MINUTE",           1,  1)},
-    {73,  std::tuple<std::string, char, char>("SECOND",           1,  1)},
-    {74,  std::tuple<std::string, char, char>("NOW",              0,  0)},
-    {75,  std::tuple<std::string, char, char>("AREAS",            1,  1)},
-    {76,  std::tuple<std::string, char, char>("ROWS",             1,  1)},
-    {77,  std::tuple<std::string, char, char>("COLUMNS",          1,  1)},
-    {78,  std::tuple<std::string, char, char>("OFFSET",           3,  5)},
-    {82,  std::tuple<std::string, char, char>("SEARCH",           2,  3)},
-    {83,  std::tuple<std::string, char, char>("TRANSPOSE",        1,  1)},
-    {86,  std::tuple<std::string, char, char>("TYPE",             1,  1)},
-    {92,  std::tuple<std::string, char, char>("SERIESSUM",        4,  4)},
-    {97,  std::tuple<std::string, char, char>("ATAN2",            2,  2)},
-    {98,  std::tuple<std::string, char, char>("ASIN",             1,  1)},
-    {99,  std::tuple<std::string, char, char>("ACOS",             1,  1)},
-    {100, std::tuple<std::string, char, char>("CHOOSE",           2, 30)},
-    {101, std::tuple<std::string, char, char>("HLOOKUP",          3,  4)},
-    {102, std::tuple<std::string, char, char>("VLOOKUP",          3,  4)},
-    {105, std::tuple<std::string, char, char>("ISREF",            1,  1)},
-    {109, std::tuple<std::string, char, char>("LOG",              1,  2)},
-    {111, std::tuple<std::string, char, char>("CHAR",             1,  1)},
-    {112, std::tuple<std::string, char, char>("LOWER",            1,  1)},
-    {113, std::tuple<std::string, char, char>("UPPER",            1,  1)},
-    {114, std::tuple<std::string, char, char>("PROPER",           1,  1)},
-    {115, std::tuple<std::string, char, char>("LEFT",             1,  2)},
-    {116, std::tuple<std::string, char, char>("RIGHT",            1,  2)},
-    {117, std::tuple<std::string, char, char>("EXACT",            2,  2)},
-    {118, std::tuple<std::string, char, char>("TRIM",             1,  1)},
-    {119, std::tuple<std::string, char, char>("REPLACE",          4,  4)},
-    {120, std::tuple<std::string, char, char>("SUBSTITUTE",       3,  4)},
-    {121, std::tuple<std::string, char, char>("CODE",             1,  1)},
-    {124, std::tuple<std::string, char, char>("FIND",             2,  3)},
-    {125, std::tuple<std::string, char, char>("CELL",             1,  2)},
-    {126, std::tuple<std::string, char, char>("ISERR",            1,  1)},
-    {127, std::tuple<std::string, char, char>("ISTEXT",           1,  1)},
-    {128, std::tuple<std::string, char, char>("ISNUMBER",         1,  1)},
-    {129, std::tuple<std::string, char, char>("ISBLANK",          1,  1)},
-    {130, std::tuple<std::string, char, char>("T",                1,  1)},
-    {131, std::tuple<std::string, char, char>("N",                1,  1)},
-    {140, std::tuple<std::string, char, char>("DATEVALUE",        1,  1)},
-    {141, std::tuple<std::string, char, char>("TIMEVALUE",        1,  1)},
-    {142, std::tuple<std::string, char, char>("SLN",              3,  3)},
-    {143, std::tuple<std::string, char, char>("SYD",              4,  4)},
-    {144, std::tuple<std::string, char, char>("DDB",              4,  5)},
-    {148, std::tuple<std::string, char, char>("INDIRECT",         1,  2)},
-    {162, std::tuple<std::string, char, char>("CLEAN",            1,  1)},
-    {163, std::tuple<std::string, char, char>("MDETERM",          1,  1)},
-    {164, std::tuple<std::string, char, char>("MINVERSE",         1,  1)},
-    {165, std::tuple<std::string, char, char>("MMULT",            2,  2)},
-    {167, std::tuple<std::string, char, char>("IPMT",             4,  6)},
-    {168, std::tuple<std::string, char, char>("PPMT",             4,  6)},
-    {169, std::tuple<std::string, char, char>("COUNTA",           0, 30)},
-    {183, std::tuple<std::string, char, char>("PRODUCT",          0, 30)},
-    {184, std::tuple<std::string, char, char>("FACT",             1,  1)},
-    {189, std::tuple<std::string, char, char>("DPRODUCT",         3,  3)},
-    {190, std::tuple<std::string, char, char>("ISNONTEXT",        1,  1)},
-    {193, std::tuple<std::string, char, char>("STDEVP",           1, 30)},
-    {194, std::tuple<std::string, char, char>("VARP",             1, 30)},
-    {195, std::tuple<std::string, char, char>("DSTDEVP",          3,  3)},
-    {196, std::tuple<std::string, char, char>("DVARP",            3,  3)},
-    {197, std::tuple<std::string, char, char>("TRUNC",            1,  2)},
-    {198, std::tuple<std::string, char, char>("ISLOGICAL",        1,  1)},
-    {199, std::tuple<std::string, char, char>("DCOUNTA",          3,  3)},
-    {204, std::tuple<std::string, char, char>("USDOLLAR",         1,  2)},
-    {205, std::tuple<std::string, char, char>("FINDB",            2,  3)},
-    {206, std::tuple<std::string, char, char>("SEARCHB",          2,  3)},
-    {207, std::tuple<std::string, char, char>("REPLACEB",         4,  4)},
-    {208, std::tuple<std::string, char, char>("LEFTB",            1,  2)},
-    {209, std::tuple<std::string, char, char>("RIGHTB",           1,  2)},
-    {210, std::tuple<std::string, char, char>("MIDB",             3,  3)},
-    {211, std::tuple<std::string, char, char>("LENB",             1,  1)},
-    {212, std::tuple<std::string, char, char>("ROUNDUP",          2,  2)},
-    {213, std::tuple<std::string, char, char>("ROUNDDOWN",        2,  2)},
-    {214, std::tuple<std::string, char, char>("ASC",              1,  1)},
-    {215, std::tuple<std::string, char, char>("DBCS",             1,  1)},
-    {216, std::tuple<std::string, char, char>("RANK",             2,  3)},
-    {219, std::tuple<std::string, char, char>("ADDRESS",          2,  5)},
-    {220, std::tuple<std::string, char, char>("DAYS360",          2,  3)},
-    {221, std::tuple<std::string, char, char>("TODAY",            0,  0)},
-    {222, std::tuple<std::string, char, char>("VDB",              5,  7)},
-    {227, std::tuple<std::string, char, char>("MEDIAN",           1, 30)},
-    {228, std::tuple<std::string, char, char>("SUMPRODUCT",       1, 30)},
-    {229, std::tuple<std::string, char, char>("SINH",             1,  1)},
-    {230, std::tuple<std::string, char, char>("COSH",             1,  1)},
-    {231, std::tuple<std::string, char, char>("TANH",             1,  1)},
-    {232, std::tuple<std::string, char, char>("ASINH",            1,  1)},
-    {233, std::tuple<std::string, char, char>("ACOSH",            1,  1)},
-    {234, std::tuple<std::string, char, char>("ATANH",            1,  1)},
-    {235, std::tuple<std::string, char, char>("DGET",             3,  3)},
-    {244, std::tuple<std::string, char, char>("INFO",             1,  1)},
-    {247, std::tuple<std::string, char, char>("DB",               4,  5)},
-    {252, std::tuple<std::string, char, char>("FREQUENCY",        2,  2)},
-    {261, std::tuple<std::string, char, char>("ERROR.TYPE",       1,  1)},
-    {269, std::tuple<std::string, char, char>("AVEDEV",           1, 30)},
-    {270, std::tuple<std::string, char, char>("BETADIST",         3,  5)},
-    {271, std::tuple<std::string, char, char>("GAMMALN",          1,  1)},
-    {272, std::tuple<std::string, char, char>("BETAINV",          3,  5)},
-    {273, std::tuple<std::string, char, char>("BINOMDIST",        4,  4)},
-    {274, std::tuple<std::string, char, char>("CHIDIST",          2,  2)},
-    {275, std::tuple<std::string, char, char>("CHIINV",           2,  2)},
-    {276, std::tuple<std::string, char, char>("COMBIN",           2,  2)},
-    {277, std::tuple<std::string, char, char>("CONFIDENCE",       3,  3)},
-    {278, std::tuple<std::string, char, char>("CRITBINOM",        3,  3)},
-    {279, std::tuple<std::string, char, char>("EVEN",             1,  1)},
-    {280, std::tuple<std::string, char, char>("EXPONDIST",        3,  3)},
-    {281, std::tuple<std::string, char, char>("FDIST",            3,  3)},
-    {282, std::tuple<std::string, char, char>("FINV",             3,  3)},
-    {283, std::tuple<std::string, char, char>("FISHER",           1,  1)},
-    {284, std::tuple<std::string, char, char>("FISHERINV",        1,  1)},
-    {285, std::tuple<std::string, char, char>("FLOOR",            2,  2)},
-    {286, std::tuple<std::string, char, char>("GAMMADIST",        4,  4)},
-    {287, std::tuple<std::string, char, char>("GAMMAINV",         3,  3)},
-    {288, std::tuple<std::string, char, char>("CEILING",          2,  2)},
-    {289, std::tuple<std::string, char, char>("HYPGEOMDIST",      4,  4)},
-    {290, std::tuple<std::string, char, char>("LOGNORMDIST",      3,  3)},
-    {291, std::tuple<std::string, char, char>("LOGINV",           3,  3)},
-    {292, std::tuple<std::string, char, char>("NEGBINOMDIST",     3,  3)},
-    {293, std::tuple<std::string, char, char>("NORMDIST",         4,  4)},
-    {294, std::tuple<std::string, char, char>("NORMSDIST",        1,  1)},
-    {295, std::tuple<std::string, char, char>("NORMINV",          3,  3)},
-    {296, std::tuple<std::string, char, char>("NORMSINV",         1,  1)},
-    {297, std::tuple<std::string, char, char>("STANDARDIZE",      3,  3)},
-    {298, std::tuple<std::string, char, char>("ODD",              1,  1)},
-    {299, std::tuple<std::string, char, char>("PERMUT",           2,  2)},
-    {300, std::tuple<std::string, char, char>("POISSON",          3,  3)},
-    {301, std::tuple<std::string, char, char>("TDIST",            3,  3)},
-    {302, std::tuple<std::string, char, char>("WEIBULL",          4,  4)},
-    {303, std::tuple<std::string, char, char>("SUMXMY2",          2,  2)},
-    {304, std::tuple<std::string, char, char>("SUMX2MY2",         2,  2)},
-    {305, std::tuple<std::string, char, char>("SUMX2PY2",         2,  2)},
-    {306, std::tuple<std::string, char, char>("CHITEST",          2,  2)},
-    {307, std::tuple<std::string, char, char>("CORREL",           2,  2)},
-    {308, std::tuple<std::string, char, char>("COVAR",            2,  2)},
-    {309, std::tuple<std::string, char, char>("FORECAST",         3,  3)},
-    {310, std::tuple<std::string, char, char>("FTEST",            2,  2)},
-    {311, std::tuple<std::string, char, char>("INTERCEPT",        2,  2)},
-    {312, std::tuple<std::string, char, char>("PEARSON",          2,  2)},
-    {313, std::tuple<std::string, char, char>("RSQ",              2,  2)},
-    {314, std::tuple<std::string, char, char>("STEYX",            2,  2)},
-    {315, std::tuple<std::string, char, char>("SLOPE",            2,  2)},
-    {316, std::tuple<std::string, char, char>("TTEST",            4,  4)},
-    {317, std::tuple<std::string, char, char>("PROB",             3,  4)},
-    {318, std::tuple<std::string, char, char>("DEVSQ",            1, 30)},
-    {319, std::tuple<std::string, char, char>("GEOMEAN",          1, 30)},
-    {320, std::tuple<std::string, char, char>("HARMEAN",          1, 30)},
-    {321, std::tuple<std::string, char, char>("SUMSQ",            0, 30)},
-    {322, std::tuple<std::string, char, char>("KURT",             1, 30)},
-    {323, std::tuple<std::string, char, char>("SKEW",             1, 30)},
-    {324, std::tuple<std::string, char, char>("ZTEST",            2,  3)},
-    {325, std::tuple<std::string, char, char>("LARGE",            2,  2)},
-    {326, std::tuple<std::string, char, char>("SMALL",            2,  2)},
-    {327, std::tuple<std::string, char, char>("QUARTILE",         2,  2)},
-    {328, std::tuple<std::string, char, char>("PERCENTILE",       2,  2)},
-    {329, std::tuple<std::string, char, char>("PERCENTRANK",      2,  3)},
-    {330, std::tuple<std::string, char, char>("MODE",             1, 30)},
-    {331, std::tuple<std::string, char, char>("TRIMMEAN",         2,  2)},
-    {332, std::tuple<std::string, char, char>("TINV",             2,  2)},
-    {336, std::tuple<std::string, char, char>("CONCATENATE",      0, 30)},
-    {337, std::tuple<std::string, char, char>("POWER",            2,  2)},
-    {342, std::tuple<std::string, char, char>("RADIANS",          1,  1)},
-    {343, std::tuple<std::string, char, char>("DEGREES",          1,  1)},
-    {344, std::tuple<std::string, char, char>("SUBTOTAL",         2, 30)},
-    {345, std::tuple<std::string, char, char>("SUMIF",            2,  3)},
-    {346, std::tuple<std::string, char, char>("COUNTIF",          2,  2)},
-    {347, std::tuple<std::string, char, char>("COUNTBLANK",       1,  1)},
-    {350, std::tuple<std::string, char, char>("ISPMT",            4,  4)},
-    {351, std::tuple<std::string, char, char>("DATEDIF",          3,  3)},
-    {352, std::tuple<std::string, char, char>("DATESTRING",       1,  1)},
-    {353, std::tuple<std::string, char, char>("NUMBERSTRING",     2,  2)},
-    {354, std::tuple<std::string, char, char>("ROMAN",            1,  2)},
-    {358, std::tuple<std::string, char, char>("GETPIVOTDATA",     2,  2)},
-    {359, std::tuple<std::string, char, char>("HYPERLINK",        1,  2)},
-    {360, std::tuple<std::string, char, char>("PHONETIC",         1,  1)},
-    {361, std::tuple<std::string, char, char>("AVERAGEA",         1, 30)},
-    {362, std::tuple<std::string, char, char>("MAXA",             1, 30)},
-    {363, std::tuple<std::string, char, char>("MINA",             1, 30)},
-    {364, std::tuple<std::string, char, char>("STDEVPA",          1, 30)},
-    {365, std::tuple<std::string, char, char>("VARPA",            1, 30)},
-    {366, std::tuple<std::string, char, char>("STDEVA",           1, 30)},
-    {367, std::tuple<std::string, char, char>("VARA",             1, 30)},
-    {368, std::tuple<std::string, char, char>("BAHTTEXT",         1,  1)},
-    {369, std::tuple<std::string, char, char>("THAIDAYOFWEEK",    1,  1)},
-    {370, std::tuple<std::string, char, char>("THAIDIGIT",        1,  1)},
-    {371, std::tuple<std::string, char, char>("THAIMONTHOFYEAR",  1,  1)},
-    {372, std::tuple<std::string, char, char>("THAINUMSOUND",     1,  1)},
-    {373, std::tuple<std::string, char, char>("THAINUMSTRING",    1,  1)},
-    {374, std::tuple<std::string, char, char>("THAISTRINGLENGTH", 1,  1)},
-    {375, std::tuple<std::string, char, char>("ISTHAIDIGIT",      1,  1)},
-    {376, std::tuple<std::string, char, char>("ROUNDBAHTDOWN",    1,  1)},
-    {377, std::tuple<std::string, char, char>("ROUNDBAHTUP",      1,  1)},
-    {378, std::tuple<std::string, char, char>("THAIYEAR",         1,  1)},
-    {379, std::tuple<std::string, char, char>("RTD",              2,  5)}
+/** Built-in function definition */
+struct FuncDefinition {
+    const char* name;  ///< Function name
+    char minArgCount;  ///< Min argument count
+    char maxArgCount;  ///< Max argument count
 };
+/** index, {name, min#args, max#args} (sorted by index) */
+constexpr tools::TableEntry<int, FuncDefinition> FUNC_DEFINITIONS[] {
+    {0,   {"COUNT",            0, 30}},
+    {1,   {"IF",               2,  3}},
+    {2,   {"ISNA",             1,  1}},
+    {3,   {"ISERROR",          1,  1}},
+    {4,   {"SUM",              0, 30}},
+    {5,   {"AVERAGE",          1, 30}},
+    {6,   {"MIN",              1, 30}},
+    {7,   {"MAX",              1, 30}},
+    {8,   {"ROW",              0,  1}},
+    {9,   {"COLUMN",           0,  1}},
+    {10,  {"NA",               0,  0}},
+    {11,  {"NPV",              2, 30}},
+    {12,  {"STDEV",            1, 30}},
+    {13,  {"DOLLAR",           1,  2}},
+    {14,  {"FIXED",            2,  3}},
+    {15,  {"SIN",              1,  1}},
+    {16,  {"COS",              1,  1}},
+    {17,  {"TAN",              1,  1}},
+    {18,  {"ATAN",             1,  1}},
+    {19,  {"PI",               0,  0}},
+    {20,  {"SQRT",             1,  1}},
+    {21,  {"EXP",              1,  1}},
+    {22,  {"LN",               1,  1}},
+    {23,  {"LOG10",            1,  1}},
+    {24,  {"ABS",              1,  1}},
+    {25,  {"INT",              1,  1}},
+    {26,  {"SIGN",             1,  1}},
+    {27,  {"ROUND",            2,  2}},
+    {28,  {"LOOKUP",           2,  3}},
+    {29,  {"INDEX",            2,  4}},
+    {30,  {"REPT",             2,  2}},
+    {31,  {"MID",              3,  3}},
+    {32,  {"LEN",              1,  1}},
+    {33,  {"VALUE",            1,  1}},
+    {34,  {"TRUE",             0,  0}},
+    {35,  {"FALSE",            0,  0}},
+    {36,  {"AND",              1, 30}},
+    {37,  {"OR",               1, 30}},
+    {38,  {"NOT",              1,  1}},
+    {39,  {"MOD",              2,  2}},
+    {40,  {"DCOUNT",           3,  3}},
+    {41,  {"DSUM",             3,  3}},
+    {42,  {"DAVERAGE",         3,  3}},
+    {43,  {"DMIN",             3,  3}},
+    {44,  {"DMAX",             3,  3}},
+    {45,  {"DSTDEV",           3,  3}},
+    {46,  {"VAR",              1, 30}},
+    {47,  {"DVAR",             3,  3}},
+    {48,  {"TEXT",             2,  2}},
+    {49,  {"LINEST",           1,  4}},
+    {50,  {"TREND",            1,  4}},
+    {51,  {"LOGEST",           1,  4}},
+    {52,  {"GROWTH",           1,  4}},
+    {56,  {"PV",               3,  5}},
+    {57,  {"FV",               3,  5}},
+    {58,  {"NPER",             3,  5}},
+    {59,  {"PMT",              3,  5}},
+    {60,  {"RATE",             3,  6}},
+    {61,  {"MIRR",             3,  3}},
+    {62,  {"IRR",              1,  2}},
+    {63,  {"RAND",             0,  0}},
+    {64,  {"MATCH",            2,  3}},
+    {65,  {"DATE",             3,  3}},
+    {66,  {"TIME",             3,  3}},
+    {67,  {"DAY",              1,  1}},
+    {68,  {"MONTH",            1,  1}},
+    {69,  {"YEAR",             1,  1}},
+    {70,  {"WEEKDAY",          1,  2}},
+    {71,  {"HOUR",             1,  1}},
+    {72,  {"MINUTE",           1,  1}},
+    {73,  {"SECOND",           1,  1}},
+    {74,  {"NOW",              0,  0}},
+    {75,  {"AREAS",            1,  1}},
+    {76,  {"ROWS",             1,  1}},
+    {77,  {"COLUMNS",          1,  1}},
+    {78,  {"OFFSET",           3,  5}},
+    {82,  {"SEARCH",           2,  3}},
+    {83,  {"TRANSPOSE",        1,  1}},
+    {86,  {"TYPE",             1,  1}},
+    {92,  {"SERIESSUM",        4,  4}},
+    {97,  {"ATAN2",            2,  2}},
+    {98,  {"ASIN",             1,  1}},
+    {99,  {"ACOS",             1,  1}},
+    {100, {"CHOOSE",           2, 30}},
+    {101, {"HLOOKUP",          3,  4}},
+    {102, {"VLOOKUP",          3,  4}},
+    {105, {"ISREF",            1,  1}},
+    {109, {"LOG",              1,  2}},
+    {111, {"CHAR",             1,  1}},
+    {112, {"LOWER",            1,  1}},
+    {113, {"UPPER",            1,  1}},
+    {114, {"PROPER",           1,  1}},
+    {115, {"LEFT",             1,  2}},
+    {116, {"RIGHT",            1,  2}},
+    {117, {"EXACT",            2,  2}},
+    {118, {"TRIM",             1,  1}},
+    {119, {"REPLACE",          4,  4}},
+    {120, {"SUBSTITUTE",       3,  4}},
+    {121, {"CODE",             1,  1}},
+    {124, {"FIND",             2,  3}},
+    {125, {"CELL",             1,  2}},
+    {126, {"ISERR",            1,  1}},
+    {127, {"ISTEXT",           1,  1}},
+    {128, {"ISNUMBER",         1,  1}},
+    {129, {"ISBLANK",          1,  1}},
+    {130, {"T",                1,  1}},
+    {131, {"N",                1,  1}},
+    {140, {"DATEVALUE",        1,  1}},
+    {141, {"TIMEVALUE",        1,  1}},
+    {142, {"SLN",              3,  3}},
+    {143, {"SYD",              4,  4}},
+    {144, {"DDB",              4,  5}},
+    {148, {"INDIRECT",         1,  2}},
+    {162, {"CLEAN",            1,  1}},
+    {163, {"MDETERM",          1,  1}},
+    {164, {"MINVERSE",         1,  1}},
+    {165, {"MMULT",            2,  2}},
+    {167, {"IPMT",             4,  6}},
+    {168, {"PPMT",             4,  6}},
+    {169, {"COUNTA",           0, 30}},
+    {183, {"PRODUCT",          0, 30}},
+    {184, {"FACT",             1,  1}},
+    {189, {"DPRODUCT",         3,  3}},
+    {190, {"ISNONTEXT",        1,  1}},
+    {193, {"STDEVP",           1, 30}},
+    {194, {"VARP",             1, 30}},
+    {195, {"DSTDEVP",          3,  3}},
+    {196, {"DVARP",            3,  3}},
+    {197, {"TRUNC",            1,  2}},
+    {198, {"ISLOGICAL",        1,  1}},
+    {199, {"DCOUNTA",          3,  3}},
+    {204, {"USDOLLAR",         1,  2}},
+    {205, {"FINDB",            2,  3}},
+    {206, {"SEARCHB",          2,  3}},
+    {207, {"REPLACEB",         4,  4}},
+    {208, {"LEFTB",            1,  2}},
+    {209, {"RIGHTB",           1,  2}},
+    {210, {"MIDB",             3,  3}},
+    {211, {"LENB",             1,  1}},
+    {212, {"ROUNDUP",          2,  2}},
+    {213, {"ROUNDDOWN",        2,  2}},
+    {214, {"ASC",              1,  1}},
+    {215, {"DBCS",             1,  1}},
+    {216, {"RANK",             2,  3}},
+    {219, {"ADDRESS",          2,  5}},
+    {220, {"DAYS360",          2,  3}},
+    {221, {"TODAY",            0,  0}},
+    {222, {"VDB",              5,  7}},
+    {227, {"MEDIAN",           1, 30}},
+    {228, {"SUMPRODUCT",       1, 30}},
+    {229, {"SINH",             1,  1}},
+    {230, {"COSH",             1,  1}},
+    {231, {"TANH",             1,  1}},
+    {232, {"ASINH",            1,  1}},
+    {233, {"ACOSH",            1,  1}},
+    {234, {"ATANH",            1,  1}},
+    {235, {"DGET",             3,  3}},
+    {244, {"INFO",             1,  1}},
+    {247, {"DB",               4,  5}},
+    {252, {"FREQUENCY",        2,  2}},
+    {261, {"ERROR.TYPE",       1,  1}},
+    {269, {"AVEDEV",           1, 30}},
+    {270, {"BETADIST",         3,  5}},
+    {271, {"GAMMALN",          1,  1}},
+    {272, {"BETAINV",          3,  5}},
+    {273, {"BINOMDIST",        4,  4}},
+    {274, {"CHIDIST",          2,  2}},
+    {275, {"CHIINV",           2,  2}},
+    {276, {"COMBIN",           2,  2}},
+    {277, {"CONFIDENCE",       3,  3}},
+    {278, {"CRITBINOM",        3,  3}},
+    {279, {"EVEN",             1,  1}},
+    {280, {"EXPONDIST",        3,  3}},
+    {281, {"FDIST",            3,  3}},
+    {282, {"FINV",             3,  3}},
+    {283, {"FISHER",           1,  1}},
+    {284, {"FISHERINV",        1,  1}},
+    {285, {"FLOOR",            2,  2}},
+    {286, {"GAMMADIST",        4,  4}},
+    {287, {"GAMMAINV",         3,  3}},
+    {288, {"CEILING",          2,  2}},
+    {289, {"HYPGEOMDIST",      4,  4}},
+    {290, {"LOGNORMDIST",      3,  3}},
+    {291, {"LOGINV",           3,  3}},
+    {292, {"NEGBINOMDIST",     3,  3}},
+    {293, {"NORMDIST",         4,  4}},
+    {294, {"NORMSDIST",        1,  1}},
+    {295, {"NORMINV",          3,  3}},
+    {296, {"NORMSINV",         1,  1}},
+    {297, {"STANDARDIZE",      3,  3}},
+    {298, {"ODD",              1,  1}},
+    {299, {"PERMUT",           2,  2}},
+    {300, {"POISSON",          3,  3}},
+    {301, {"TDIST",            3,  3}},
+    {302, {"WEIBULL",          4,  4}},
+    {303, {"SUMXMY2",          2,  2}},
+    {304, {"SUMX2MY2",         2,  2}},
+    {305, {"SUMX2PY2",         2,  2}},
+    {306, {"CHITEST",          2,  2}},
+    {307, {"CORREL",           2,  2}},
+    {308, {"COVAR",            2,  2}},
+    {309, {"FORECAST",         3,  3}},
+    {310, {"FTEST",            2,  2}},
+    {311, {"INTERCEPT",        2,  2}},
+    {312, {"PEARSON",          2,  2}},
+    {313, {"RSQ",              2,  2}},
+    {314, {"STEYX",            2,  2}},
+    {315, {"SLOPE",            2,  2}},
+    {316, {"TTEST",            4,  4}},
+    {317, {"PROB",             3,  4}},
+    {318, {"DEVSQ",            1, 30}},
+    {319, {"GEOMEAN",          1, 30}},
+    {320, {"HARMEAN",          1, 30}},
+    {321, {"SUMSQ",            0, 30}},
+    {322, {"KURT",             1, 30}},
+    {323, {"SKEW",             1, 30}},
+    {324, {"ZTEST",            2,  3}},
+    {325, {"LARGE",            2,  2}},
+    {326, {"SMALL",            2,  2}},
+    {327, {"QUARTILE",         2,  2}},
+    {328, {"PERCENTILE",       2,  2}},
+    {329, {"PERCENTRANK",      2,  3}},
+    {330, {"MODE",             1, 30}},
+    {331, {"TRIMMEAN",         2,  2}},
+    {332, {"TINV",             2,  2}},
+    {336, {"CONCATENATE",      0, 30}},
+    {337, {"POWER",            2,  2}},
+    {342, {"RADIANS",          1,  1}},
+    {343, {"DEGREES",          1,  1}},
+    {344, {"SUBTOTAL",         2, 30}},
+    {345, {"SUMIF",            2,  3}},
+    {346, {"COUNTIF",          2,  2}},
+    {347, {"COUNTBLANK",       1,  1}},
+    {350, {"ISPMT",            4,  4}},
+    {351, {"DATEDIF",          3,  3}},
+    {352, {"DATESTRING",       1,  1}},
+    {353, {"NUMBERSTRING",     2,  2}},
+    {354, {"ROMAN",            1,  2}},
+    {358, {"GETPIVOTDATA",     2,  2}},
+    {359, {"HYPERLINK",        1,  2}},
+    {360, {"PHONETIC",         1,  1}},
+    {361, {"AVERAGEA",         1, 30}},
+    {362, {"MAXA",             1, 30}},
+    {363, {"MINA",             1, 30}},
+    {364, {"STDEVPA",          1, 30}},
+    {365, {"VARPA",            1, 30}},
+    {366, {"STDEVA",           1, 30}},
+    {367, {"VARA",             1, 30}},
+    {368, {"BAHTTEXT",         1,  1}},
+    {369, {"THAIDAYOFWEEK",    1,  1}},
+    {370, {"THAIDIGIT",        1,  1}},
+    {371, {"THAIMONTHOFYEAR",  1,  1}},
+    {372, {"THAINUMSOUND",     1,  1}},
+    {373, {"THAINUMSTRING",    1,  1}},
+    {374, {"THAISTRINGLENGTH", 1,  1}},
+    {375, {"ISTHAIDIGIT",      1,  1}},
+    {376, {"ROUNDBAHTDOWN",    1,  1}},
+    {377, {"ROUNDBAHTUP",      1,  1}},
+    {378, {"THAIYEAR",         1,  1}},
+    {379, {"RTD",              2,  5}}
+};
+static_assert(tools::isSortedTable(FUNC_DEFINITIONS), "FUNC_DEFINITIONS must be sorted");
 /**
  * SZTABN[code] -> the number of bytes to consume. Which N to use? Depends on biff_version.
  * Value | Description
@@ -295,55 +303,56 @@ const std::unordered_map<int, std::tuple<std::string, char, char>> FUNC_DEFINITI
  *   -1  | Variable
  *   -2  | Code not implemented in this version
  */
-const std::vector<signed char> SZTAB0 {
+constexpr std::array<signed char, 64> SZTAB0 {{
     -2, 4, 4, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -2,-1, 8,
     4, 2, 2, 3, 9, 8, 2, 3, 8, 4, 7, 5, 5, 5, 2, 4, 7, 4, 7, 2, 2, -2, -2, -2, -2, -2, -2,
     -2, -2, 3, -2, -2, -2, -2, -2, -2, -2
-};
-const std::vector<signed char> SZTAB1 {
+}};
+constexpr std::array<signed char, 64> SZTAB1 {{
     -2, 5, 5, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -2, -1, 11, 5,
     2, 2, 3, 9, 9, 2, 3, 11, 4, 7, 7, 7, 7, 3, 4, 7, 4, 7, 3, 3, -2, -2, -2, -2, -2, -2, -2,
     -2, 3, -2, -2, -2, -2, -2, -2, -2
-};
-const std::vector<signed char> SZTAB2 {
+}};
+constexpr std::array<signed char, 64> SZTAB2 {{
     -2, 5, 5, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -2, -1, 11, 5,
     2, 2, 3, 9, 9, 3, 4, 11, 4, 7, 7, 7, 7, 3, 4, 7, 4, 7, 3, 3, -2, -2, -2, -2, -2, -2, -2,
     -2, -2, -2, -2, -2, -2, -2, -2, -2
-};
-const std::vector<signed char> SZTAB3 {
+}};
+constexpr std::array<signed char, 64> SZTAB3 {{
     -2, 5, 5, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -2, -1, -2, -2,
     2, 2, 3, 9, 9, 3, 4, 15, 4, 7, 7, 7, 7, 3, 4, 7, 4, 7, 3, 3, -2, -2, -2, -2, -2, -2, -2,
     -2, -2, 25, 18, 21, 18, 21, -2, -2
-};
-const std::vector<signed char> SZTAB4 {
+}};
+constexpr std::array<signed char, 64> SZTAB4 {{
     -2, 5, 5, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -2, -2,
     2, 2, 3, 9, 9, 3, 4, 5, 5, 9, 7, 7, 7, 3, 5, 9, 5, 9, 3, 3, -2, -2, -2, -2, -2, -2, -2,
     -2, -2, 7, 7, 11, 7, 11, -2, -2
+}};
+constexpr tools::TableEntry<int, const std::array<signed char, 64>*> SZDICT[] {
+    {20, &SZTAB0},
+    {21, &SZTAB0},
+    {30, &SZTAB1},
+    {40, &SZTAB2},
+    {45, &SZTAB2},
+    {50, &SZTAB3},
+    {70, &SZTAB3},
+    {80, &SZTAB4}
 };
-const std::unordered_map<int, std::vector<signed char>> SZDICT {
-    {20, SZTAB0},
-    {21, SZTAB0},
-    {30, SZTAB1},
-    {40, SZTAB2},
-    {45, SZTAB2},
-    {50, SZTAB3},
-    {70, SZTAB3},
-    {80, SZTAB4}
-};
+static_assert(tools::isSortedTable(SZDICT), "SZDICT must be sorted");
 /**
  * This dictionary can be used to produce text version of internal codes
  * that Excel uses for error cells
  */
-const std::vector<int> ERROR_CODES {0x07, 0x08, 0x0A, 0x0B, 0x1C, 0x1D, 0x2F};
+constexpr int ERROR_CODES[] {0x07, 0x08, 0x0A, 0x0B, 0x1C, 0x1D, 0x2F};
 /** Operation name list */
-const std::vector<std::string> OPERATION_NAMES {
+constexpr std::array<const char*, 64> OPERATION_NAMES {{
     "Unk00", "Exp", "Tbl", "Add", "Sub", "Mul", "Div", "Power", "Concat", "LT", "LE", "EQ",
     "GE", "GT", "NE", "Isect", "List", "Range", "Uplus", "Uminus", "Percent", "Paren", "MissArg",
     "Str", "Extended", "Attr", "Sheet", "EndSheet", "Err", "Bool", "Int", "Num", "Array", "Func",
     "FuncVar", "Name", "Ref", "Area", "MemArea", "MemErr", "MemNoMem", "MemFunc", "RefErr",
     "AreaErr", "RefN", "AreaN", "MemAreaN", "MemNoMemN", "", "", "", "", "", "", "", "", "FuncCE",
     "NameX", "Ref3d", "Area3d", "RefErr3d", "AreaErr3d", "", ""
-};
+}};
 
 // Formula public:
 Formula::Formula(Book* book)
@@ -353,7 +362,7 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
     try {
         if (level > 10)
             throw std::logic_error("Excessive indirect references in NAME formula");
-        const std::vector<signed char>& sztab = SZDICT.at(m_book->m_biffVersion);
+        const std::array<signed char, 64>& sztab = *tools::tableAt(SZDICT, m_book->m_biffVersion);
         std::string data = name.m_rawFormula;
         bool relDelta    = true;  // All defined name formulas use "Method B" [OOo docs]
         bool hasRelation = false;
@@ -372,7 +381,7 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
             char opType  = (op & 0x60) >> 5;
             int  opIndex = opType ? opCode : opCode + 32;
             char size    = sztab[opIndex];
-            const std::string& opName = OPERATION_NAMES.at(opIndex);
+            const char* opName = OPERATION_NAMES.at(opIndex);
 
             if (size == -2)
                 throw std::logic_error(
@@ -603,7 +612,7 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
                     else {
                         kind  = oERR;
                         value = m_book->readByte<unsigned char>(data, pos+1, 1);
-                        text  = "\"" + ERROR_TEXT_FROM_CODE.at(static_cast<int>(value)) + "\"";
+                        text  = "\"" + std::string(tools::tableAt(ERROR_TEXT_FROM_CODE, static_cast<int>(value))) + "\"";
                     }
                     // Operand(kind, value, LEAF_RANK, text)
                     stack.push_back(Operand(kind, {}, LEAF_RANK, text, std::to_string(value)));
@@ -626,13 +635,14 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
                 int recordSize       = 1 + (m_book->m_biffVersion >= 40);
                 unsigned short funcx = m_book->readByte<unsigned short>(data, pos+1, recordSize);
 
-                if (FUNC_DEFINITIONS.find(funcx) == FUNC_DEFINITIONS.end()) {
+                const FuncDefinition* func = tools::findInTable(FUNC_DEFINITIONS, funcx);
+                if (!func) {
                     stack.push_back(unkOp);
                 }
                 else {
                     std::string opText;
-                    std::string funcName = std::get<0>(FUNC_DEFINITIONS.at(funcx));
-                    char argCount        = std::get<1>(FUNC_DEFINITIONS.at(funcx));
+                    std::string funcName = func->name;
+                    char argCount        = func->minArgCount;
                     if (argCount) {
                         std::string argtext;
                         for (int i = 0; i < argCount; ++i) {
@@ -657,13 +667,14 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
                 unsigned char  argCount = m_book->readByte<unsigned char>(data,  pos+1, 1) % 128;
                 unsigned short funcx    = m_book->readByte<unsigned short>(data, pos+2, recordSize) % 32768;
 
-                if (FUNC_DEFINITIONS.find(funcx) == FUNC_DEFINITIONS.end()) {
+                const FuncDefinition* func = tools::findInTable(FUNC_DEFINITIONS, funcx);
+                if (!func) {
                     stack.push_back(unkOp);
                 }
                 else {
-                    std::string funcName = std::get<0>(FUNC_DEFINITIONS.at(funcx));
-                    //char minArgCount     = std::get<1>(FUNC_DEFINITIONS[funcx]);
-                    //char maxArgCount     = std::get<2>(FUNC_DEFINITIONS[funcx]);
+                    std::string funcName = func->name;
+                    //char minArgCount     = func->minArgCount;
+                    //char maxArgCount     = func->maxArgCount;
 
                     std::string argtext;
                     for (int i = 0; i < argCount; ++i) {
@@ -999,7 +1010,7 @@ void Formula::evaluateFormula(Name& name, int nameIndex, int level) {
                 }
                 stack.push_back(res);
             }
-            else if (find(ERROR_CODES.begin(), ERROR_CODES.end(), opCode) != ERROR_CODES.end()) {
+            else if (std::find(std::begin(ERROR_CODES), std::end(ERROR_CODES), opCode) != std::end(ERROR_CODES)) {
                 hasError = true;
                 stack.push_back(errorOp);
             }
@@ -6,6 +6,9 @@
  * @copyright python-excel (https://github.com/python-excel/xlrd)
  * @date      02.12.2016 -- 10.02.2018
  */
+#include <array>
+#include <string_view>
+
 #include "tools.hpp"
 
 #include "biffh.hpp"
@@ -18,122 +21,126 @@
 namespace excel {
 
 /** XL_SHRFMLA types */
-const std::vector<int> XL_SHRFMLA_ETC {
+constexpr int XL_SHRFMLA_ETC[] {
 	XL_SHRFMLA, XL_ARRAY, XL_TABLEOP, XL_TABLEOP2, XL_ARRAY2, XL_TABLEOP_B2
 };
+#ifndef DOCPARSER_TEXT_ONLY
 /** Cell horizontal aligment list */
-const std::vector<std::string> CELL_HORZ_ALIGN {
+constexpr const char* CELL_HORZ_ALIGN[] {
 	"left", "left", "center", "right", "justify", "justify", "center", "center"
 };
 /** Cell vertical aligment list */
-const std::vector<std::string> CELL_VERT_ALIGN {
+constexpr const char* CELL_VERT_ALIGN[] {
 	"top", "middle", "bottom", "middle", "middle"
 };
 /** Cell border type list */
-const std::vector<std::string> CELL_BORDER_TYPE {
+constexpr const char* CELL_BORDER_TYPE[] {
 	"none", "solid", "solid", "dashed", "dotted", "solid", "double", "dotted",
 	"dashed", "dashed", "dashed", "dotted", "dotted", "dashed"
 };
 /** Cell border size list */
-const std::vector<int> CELL_BORDER_SIZE {
+constexpr int CELL_BORDER_SIZE[] {
 	1, 1, 2, 1, 1, 3, 1, 1, 2, 1, 2, 1, 2, 3
 };
 
-/** Table parts background color map. `type`: {`firstRow`, `evenRow`, `oddRow`} */
-const std::unordered_map<int, std::vector<std::string>> TABLE_BACKGROUND {
+/** Table parts background color map (sorted by key). `type`: {`firstRow`, `evenRow`, `oddRow`} */
+constexpr tools::TableEntry<int, std::array<std::string_view, 3>> TABLE_BACKGROUND[] {
 	// Light
-	{101, {"", "D9D9D9", ""}},
-	{102, {"", "DDEBF7", ""}},
-	{103, {"", "FCE4D6", ""}},
-	{104, {"", "EDEDED", ""}},
-	{105, {"", "2CC", ""}},
-	{106, {"", "D9E1F2", ""}},
-	{107, {"", "E2EFDA", ""}},
-	{108, {"000000", "", ""}},
-	{109, {"5B9BD5", "", ""}},
-	{110, {"ED7D31", "", ""}},
-	{111, {"A5A5A5", "", ""}},
-	{112, {"FFC000", "", ""}},
-	{113, {"4472C4", "", ""}},
-	{114, {"70AD47", "", ""}},
-	{115, {"", "D9D9D9", ""}},
-	{116, {"", "DDEBF7", ""}},
-	{117, {"", "FCE4D6", ""}},
-	{118, {"", "EDEDED", ""}},
-	{119, {"", "FFC000", ""}},
-	{120, {"", "D9E1F2", ""}},
-	{121, {"", "E2EFDA", ""}},
+	{101, {{"", "D9D9D9", ""}}},
+	{102, {{"", "DDEBF7", ""}}},
+	{103, {{"", "FCE4D6", ""}}},
+	{104, {{"", "EDEDED", ""}}},
+	{105, {{"", "2CC", ""}}},
+	{106, {{"", "D9E1F2", ""}}},
+	{107, {{"", "E2EFDA", ""}}},
+	{108, {{"000000", "", ""}}},
+	{109, {{"5B9BD5", "", ""}}},
+	{110, {{"ED7D31", "", ""}}},
+	{111, {{"A5A5A5", "", ""}}},
+	{112, {{"FFC000", "", ""}}},
+	{113, {{"4472C4", "", ""}}},
+	{114, {{"70AD47", "", ""}}},
+	{115, {{"", "D9D9D9", ""}}},
+	{116, {{"", "DDEBF7", ""}}},
+	{117, {{"", "FCE4D6", ""}}},
+	{118, {{"", "EDEDED", ""}}},
+	{119, {{"", "FFC000", ""}}},
+	{120, {{"", "D9E1F2", ""}}},
+	{121, {{"", "E2EFDA", ""}}},
 	// Medium
-	{201, {"000000", "D9D9D9", ""}},
-	{202, {"5B9BD5", "DDEBF7", ""}},
-	{203, {"ED7D31", "FCE4D6", ""}},
-	{204, {"A5A5A5", "EDEDED", ""}},
-	{205, {"FFC000", "2CC", ""}},
-	{206, {"4472C4", "D9E1F2", ""}},
-	{207, {"70AD47", "E2EFDA", ""}},
-	{208, {"000000", "A6A6A6", "D9D9D9"}},
-	{209, {"5B9BD5", "BDD7EE", "DDEBF7"}},
-	{210, {"ED7D31", "F8CBAD", "FCE4D6"}},
-	{211, {"A5A5A5", "DBDBDB", "EDEDED"}},
-	{212, {"FFC000", "FFE699", "FFF2CC"}},
-	{213, {"4472C4", "B4C6E7", "D9E1F2"}},
-	{214, {"70AD47", "C6E0B4", "E2EFDA"}},
-	{215, {"000000", "D9D9D9", ""}},
-	{216, {"5B9BD5", "D9D9D9", ""}},
-	{217, {"ED7D31", "D9D9D9", ""}},
-	{218, {"A5A5A5", "D9D9D9", ""}},
-	{219, {"FFC000", "D9D9D9", ""}},
-	{220, {"4472C4", "D9D9D9", ""}},
-	{221, {"70AD47", "D9D9D9", ""}},
-	{222, {"D9D9D9", "A6A6A6", "D9D9D9"}},
-	{223, {"DDEBF7", "BDD7EE", "DDEBF7"}},
-	{224, {"FCE4D6", "F8CBAD", "FCE4D6"}},
-	{225, {"EDEDED", "DBDBDB", "EDEDED"}},
-	{226, {"FFF2CC", "FFE699", "FFF2CC"}},
-	{227, {"D9E1F2", "B4C6E7", "D9E1F2"}},
-	{228, {"E2EFDA", "C6E0B4", "E2EFDA"}},
+	{201, {{"000000", "D9D9D9", ""}}},
+	{202, {{"5B9BD5", "DDEBF7", ""}}},
+	{203, {{"ED7D31", "FCE4D6", ""}}},
+	{204, {{"A5A5A5", "EDEDED", ""}}},
+	{205, {{"FFC000", "2CC", ""}}},
+	{206, {{"4472C4", "D9E1F2", ""}}},
+	{207, {{"70AD47", "E2EFDA", ""}}},
+	{208, {{"000000", "A6A6A6", "D9D9D9"}}},
+	{209, {{"5B9BD5", "BDD7EE", "DDEBF7"}}},
+	{210, {{"ED7D31", "F8CBAD", "FCE4D6"}}},
+	{211, {{"A5A5A5", "DBDBDB", "EDEDED"}}},
+	{212, {{"FFC000", "FFE699", "FFF2CC"}}},
+	{213, {{"4472C4", "B4C6E7", "D9E1F2"}}},
+	{214, {{"70AD47", "C6E0B4", "E2EFDA"}}},
+	{215, {{"000000", "D9D9D9", ""}}},
+	{216, {{"5B9BD5", "D9D9D9", ""}}},
+	{217, {{"ED7D31", "D9D9D9", ""}}},
+	{218, {{"A5A5A5", "D9D9D9", ""}}},
+	{219, {{"FFC000", "D9D9D9", ""}}},
+	{220, {{"4472C4", "D9D9D9", ""}}},
+	{221, {{"70AD47", "D9D9D9", ""}}},
+	{222, {{"D9D9D9", "A6A6A6", "D9D9D9"}}},
+	{223, {{"DDEBF7", "BDD7EE", "DDEBF7"}}},
+	{224, {{"FCE4D6", "F8CBAD", "FCE4D6"}}},
+	{225, {{"EDEDED", "DBDBDB", "EDEDED"}}},
+	{226, {{"FFF2CC", "FFE699", "FFF2CC"}}},
+	{227, {{"D9E1F2", "B4C6E7", "D9E1F2"}}},
+	{228, {{"E2EFDA", "C6E0B4", "E2EFDA"}}},
 	// Dark
-	{301, {"000", "404040", "737373"}},
-	{302, {"000", "2F75B5", "5B9BD5"}},
-	{303, {"000", "C65911", "ED7D31"}},
-	{304, {"000", "7B7B7B", "A5A5A5"}},
-	{305, {"000", "BF8F00", "FFC000"}},
-	{306, {"000", "305496", "4472C4"}},
-	{307, {"000", "548235", "70AD47"}},
-	{308, {"000", "A6A6A6", "D9D9D9"}},
-	{309, {"ED7D31", "BDD7EE", "DDEBF7"}},
-	{310, {"FFC000", "DBDBDB", "EDEDED"}},
-	{311, {"70AD47", "B4C6E7", "D9E1F2"}}
+	{301, {{"000", "404040", "737373"}}},
+	{302, {{"000", "2F75B5", "5B9BD5"}}},
+	{303, {{"000", "C65911", "ED7D31"}}},
+	{304, {{"000", "7B7B7B", "A5A5A5"}}},
+	{305, {{"000", "BF8F00", "FFC000"}}},
+	{306, {{"000", "305496", "4472C4"}}},
+	{307, {{"000", "548235", "70AD47"}}},
+	{308, {{"000", "A6A6A6", "D9D9D9"}}},
+	{309, {{"ED7D31", "BDD7EE", "DDEBF7"}}},
+	{310, {{"FFC000", "DBDBDB", "EDEDED"}}},
+	{311, {{"70AD47", "B4C6E7", "D9E1F2"}}}
 };
-/** Table parts font color map. `type`: {`firstRow`, `otherRow`} */
-const std::unordered_map<int, std::vector<std::string>> TABLE_COLOR {
+static_assert(tools::isSortedTable(TABLE_BACKGROUND), "TABLE_BACKGROUND must be sorted");
+/** Table parts font color map (sorted by key). `type`: {`firstRow`, `otherRow`} */
+constexpr tools::TableEntry<int, std::array<std::string_view, 2>> TABLE_COLOR[] {
 	// Light
-	{102, {"2F75B5", "2F75B5"}},
-	{103, {"C65911", "C65911"}},
-	{104, {"7B7B7B", "7B7B7B"}},
-	{105, {"BF8F00", "BF8F00"}},
-	{106, {"305496", "305496"}},
-	{107, {"548235", "548235"}},
-	{108, {"fff", ""}},
+	{102, {{"2F75B5", "2F75B5"}}},
+	{103, {{"C65911", "C65911"}}},
+	{104, {{"7B7B7B", "7B7B7B"}}},
+	{105, {{"BF8F00", "BF8F00"}}},
+	{106, {{"305496", "305496"}}},
+	{107, {{"548235", "548235"}}},
+	{108, {{"fff", ""}}},
 	// Medium
-	{201, {"fff", ""}},
-	{202, {"fff", ""}},
-	{203, {"fff", ""}},
-	{204, {"fff", ""}},
-	{205, {"fff", ""}},
-	{206, {"fff", ""}},
-	{207, {"fff", ""}},
-	{208, {"fff", ""}},
+	{201, {{"fff", ""}}},
+	{202, {{"fff", ""}}},
+	{203, {{"fff", ""}}},
+	{204, {{"fff", ""}}},
+	{205, {{"fff", ""}}},
+	{206, {{"fff", ""}}},
+	{207, {{"fff", ""}}},
+	{208, {{"fff", ""}}},
 	// Dark
-	{301, {"fff", "fff"}},
-	{302, {"fff", "fff"}},
-	{303, {"fff", "fff"}},
-	{304, {"fff", "fff"}},
-	{305, {"fff", "fff"}},
-	{306, {"fff", "fff"}},
-	{307, {"fff", "fff"}},
-	{308, {"fff", ""}},
+	{301, {{"fff", "fff"}}},
+	{302, {{"fff", "fff"}}},
+	{303, {{"fff", "fff"}}},
+	{304, {{"fff", "fff"}}},
+	{305, {{"fff", "fff"}}},
+	{306, {{"fff", "fff"}}},
+	{307, {{"fff", "fff"}}},
+	{308, {{"fff", ""}}}
 };
+static_assert(tools::isSortedTable(TABLE_COLOR), "TABLE_COLOR must be sorted");
+#endif  // DOCPARSER_TEXT_ONLY
 
 
 // public:
@@ -319,7 +326,7 @@ void Sheet::read() {
                         m_book->getRecordParts(code2, size2, data2);
                         if (code2 == XL_STRING || code2 == XL_STRING_B2)
                             gotString = true;
-                        else if (find(XL_SHRFMLA_ETC.begin(), XL_SHRFMLA_ETC.end(), code2) == XL_SHRFMLA_ETC.end())
+                        else if (std::find(std::begin(XL_SHRFMLA_ETC), std::end(XL_SHRFMLA_ETC), code2) == std::end(XL_SHRFMLA_ETC))
                             throw std::logic_error(
                                     "Expected SHRFMLA, ARRAY, TABLEOP* or STRING record; found " +
                                     std::to_string(code2)
@@ -501,7 +508,7 @@ void Sheet::read() {
             //else if (code == XL_FEAT11) {
             //	handleFeat11(data);
             //}
-            else if (find(BOF_CODES.begin(), BOF_CODES.end(), code) != BOF_CODES.end()) {
+            else if (std::find(std::begin(BOF_CODES), std::end(BOF_CODES), code) != std::end(BOF_CODES)) {
                 //unsigned short version = m_book->readByte<unsigned short>(data, 0, 2);
                 //unsigned short bofType = m_book->readByte<unsigned short>(data, 2, 2);
                 unsigned short code2;
@@ -639,7 +646,9 @@ void Sheet::read() {
                         m_book->readByte<unsigned char>(data, 7, 1),
                         m_book->readByte<unsigned char>(data, 8, 1),
                     };
+#ifndef DOCPARSER_TEXT_ONLY
                     m_gridlineColorIndex = Formatting::getNearestColorIndex(m_book->m_colorMap, m_gridlineColor);
+#endif
                 }
 
                 m_showFormula            = (options >> 0) & 1;
@@ -903,7 +912,9 @@ void Sheet::read() {
                         m_book->readByte<unsigned char>(data, 11, 1),
                         m_book->readByte<unsigned char>(data, 12, 1)
                     };
+#ifndef DOCPARSER_TEXT_ONLY
                     m_gridlineColorIndex = Formatting::getNearestColorIndex(m_book->m_colorMap, m_gridlineColor);
+#endif
                 }
             }
         }
@@ -918,9 +929,10 @@ void Sheet::read() {
     }
 }
 
-void Sheet::append(const std::string &value)
+void Sheet::append(std::string_view value)
 {
-    m_sheetContent += value + '\n';
+    m_sheetContent += value;
+    m_sheetContent += '\n';
 }
 
 #if 0
@@ -1144,7 +1156,7 @@ int Sheet::insertXfB20(const std::string& cellAttributes, bool isStyle) {
 	}
 
 	Format fmt = m_book->m_formatMap[xf.m_formatKey];
-	int cellty = CELL_TYPE_FROM_FORMAT_TYPE.at(fmt.m_type);
+	int cellty = tools::tableAt(CELL_TYPE_FROM_FORMAT_TYPE, fmt.m_type);
 	m_book->m_xfIndexXlTypeMap[xf.m_xfIndex]  = cellty;
 	m_cellAttributesToXfIndex[cellAttributes] = xfx;
 	return xfx;
@@ -1535,6 +1547,7 @@ double Sheet::unpackRK(const std::string& data) const {
 	}
 }
 
+#ifndef DOCPARSER_TEXT_ONLY
 void Sheet::addCellStyle(pugi::xml_node& node, const XF& xf, int rowIndex, int colIndex) {
 	auto& cellFont  = m_book->m_fontList[xf.m_fontIndex];
 	auto  fontColor = getColor(cellFont.m_color);
@@ -1551,15 +1564,15 @@ void Sheet::addCellStyle(pugi::xml_node& node, const XF& xf, int rowIndex, int c
 			cRange[2] <= colIndex && colIndex <= cRange[3]
 		) {
 			if (cRange[0] == rowIndex) {
-				getTableColor(styleMap["color"], TABLE_COLOR.at(cRange[4]), 0);
-				getTableColor(styleMap["background"], TABLE_BACKGROUND.at(cRange[4]), 0);
+				getTableColor(styleMap["color"], tools::tableAt(TABLE_COLOR, cRange[4])[0]);
+				getTableColor(styleMap["background"], tools::tableAt(TABLE_BACKGROUND, cRange[4])[0]);
 			}
 			/*else {
-				getTableColor(styleMap["color"], TABLE_COLOR[cRange[4]], 1);
+				getTableColor(styleMap["color"], tools::tableAt(TABLE_COLOR, cRange[4])[1]);
 				if ((rowIndex - cRange[0]) % 2)
-					getTableColor(styleMap["background"], TABLE_BACKGROUND[cRange[4]], 1);
+					getTableColor(styleMap["background"], tools::tableAt(TABLE_BACKGROUND, cRange[4])[1]);
 				else
-					getTableColor(styleMap["background"], TABLE_BACKGROUND[cRange[4]], 2);
+					getTableColor(styleMap["background"], tools::tableAt(TABLE_BACKGROUND, cRange[4])[2]);
 			}*/
 			break;
 		}
@@ -1679,11 +1692,10 @@ std::string Sheet::getColor(const XFColor& color) const {
 			std::to_string(result[1]) +", "+ std::to_string(result[2]) +")";
 }
 
-void Sheet::getTableColor(std::string& style, const std::vector<std::string>& colorMap,
-						  int colorIndex) const
-{
-	if (static_cast<int>(colorMap.size()) > colorIndex && !colorMap[colorIndex].empty())
-		style = "#" + colorMap[colorIndex];
+void Sheet::getTableColor(std::string& style, std::string_view color) const {
+	if (!color.empty())
+		style = "#" + std::string(color);
 }
+#endif  // DOCPARSER_TEXT_ONLY
 
 }  // End namespace
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <pugixml.hpp>
@@ -168,7 +169,7 @@ public:
 	 */
 	void putCell(int rowIndex, int colIndex, const std::string& value, int xfIndex);
 
-    void append(const std::string &value);
+    void append(std::string_view value);
 
 	/**
 	 * @brief
@@ -554,6 +555,7 @@ private:
 	 */
 	double unpackRK(const std::string& data) const;
 
+#ifndef DOCPARSER_TEXT_ONLY
 	/**
 	 * @brief
 	 *     Add style to cell node in HTML-tree
@@ -607,13 +609,12 @@ private:
 	 *     Get table color value
 	 * @param[out] style
 	 *     Result style value
-	 * @param[in] colorMap
-	 *     Color map
-	 * @param[in] colorIndex
-	 *     Color index
+	 * @param[in] color
+	 *     Color value from table parts color map
 	 * @since 1.0
 	 */
-	void getTableColor(std::string& style, const std::vector<std::string>& colorMap, int colorIndex) const;
+	void getTableColor(std::string& style, std::string_view color) const;
+#endif  // DOCPARSER_TEXT_ONLY
 
 	/** Sheet record start position */
 	int m_position;
@@ -7,6 +7,10 @@
  * @date      02.12.2016 -- 28.01.2018
  */
 #include "tools.hpp"
+#include "fileext/ooxml/prefetch.hpp"
+#include "fileext/ooxml/textscan.hpp"
+#include "fileext/ooxml/xmlreader.hpp"
+#include "fileext/ooxml/xmltag.hpp"
 
 #include "sheet.hpp"
 
@@ -19,86 +23,94 @@ namespace excel {
 const long int X12_MAX_ROWS = 1048576; // 2^20
 /** XLSX max column count */
 const int X12_MAX_COLS      = 16384;   // 2^14
-/** Uppercase relations index */
-const std::unordered_map<char, int> UPPERCASE_REL_INDEX {
-	{'1', 0},  {'3', 0},  {'2', 0},  {'5', 0},  {'4', 0},  {'7', 0},  {'6', 0},
-	{'9', 0},  {'8', 0},  {'A', 1},  {'C', 3},  {'B', 2},  {'E', 5},  {'D', 4},
-	{'G', 7},  {'F', 6},  {'I', 9},  {'H', 8},  {'K', 11}, {'J', 10}, {'M', 13},
-	{'L', 12}, {'O', 15}, {'N', 14}, {'Q', 17}, {'P', 16}, {'S', 19}, {'R', 18},
-	{'U', 21}, {'T', 20}, {'W', 23}, {'V', 22}, {'Y', 25}, {'X', 24}, {'Z', 26}
-};
-/** Horizontal aligment types */
-const std::unordered_map<std::string, int> XLSX_HORZ_ALIGN {
+/**
+ * Uppercase relations index: `1`..`9` => `0`, `A`..`Z` => `1`..`26`.
+ * Returns -1 for characters which can't appear in cell name
+ */
+constexpr int upperCaseRelIndex(char c) {
+	if (c >= '1' && c <= '9')
+		return 0;
+	if (c >= 'A' && c <= 'Z')
+		return c - 'A' + 1;
+	return -1;
+}
+/** Horizontal aligment types (sorted by key) */
+constexpr tools::TableEntry<std::string_view, int> XLSX_HORZ_ALIGN[] {
 	{"",                 0},
-	{"general",          0},
-	{"left",             1},
 	{"center",           2},
-	{"right",            3},
+	{"centerContinuous", 6},
+	{"distributed",      7},
 	{"fill",             4},
+	{"general",          0},
 	{"justify",          5},
-	{"centerContinuous", 6},
-	{"distributed",      7}
+	{"left",             1},
+	{"right",            3}
 };
-/** Vertical aligment types */
-const std::unordered_map<std::string, int> XLSX_VERT_ALIGN {
+static_assert(tools::isSortedTable(XLSX_HORZ_ALIGN), "XLSX_HORZ_ALIGN must be sorted");
+/** Vertical aligment types (sorted by key) */
+constexpr tools::TableEntry<std::string_view, int> XLSX_VERT_ALIGN[] {
 	{"",            0},
-	{"top",         0},
-	{"center",      1},
 	{"bottom",      2},
+	{"center",      1},
+	{"distributed", 4},
 	{"justify",     3},
-	{"distributed", 4}
+	{"top",         0}
 };
-/** Border types */
-const std::unordered_map<std::string, int> XLSX_BORDER_TYPE {
+static_assert(tools::isSortedTable(XLSX_VERT_ALIGN), "XLSX_VERT_ALIGN must be sorted");
+/** Border types (sorted by key) */
+constexpr tools::TableEntry<std::string_view, int> XLSX_BORDER_TYPE[] {
 	{"",                 0},
-	{"thin",             1},
-	{"medium",           2},
+	{"dashDot",          9},
+	{"dashDotDot",       11},
 	{"dashed",           3},
 	{"dotted",           4},
-	{"thick",            5},
 	{"double",           6},
 	{"hair",             7},
-	{"mediumDashed",     8},
-	{"dashDot",          9},
+	{"medium",           2},
 	{"mediumDashDot",    10},
-	{"dashDotDot",       11},
 	{"mediumDashDotDot", 12},
-	{"slantDashDot",     13}
+	{"mediumDashed",     8},
+	{"slantDashDot",     13},
+	{"thick",            5},
+	{"thin",             1}
 };
-/** Fill pattern types */
-const std::unordered_map<std::string, int> XLSX_FILL_PATTERN {
+static_assert(tools::isSortedTable(XLSX_BORDER_TYPE), "XLSX_BORDER_TYPE must be sorted");
+/** Fill pattern types (sorted by key) */
+constexpr tools::TableEntry<std::string_view, int> XLSX_FILL_PATTERN[] {
 	{"",                0},
-	{"none",            0},
-	{"solid",           1},
-	{"mediumGray",      2},
-	{"darkGray",        3},
-	{"lightGray",       4},
-	{"darkHorizontal",  5},
-	{"darkVertical",    6},
 	{"darkDown",        7},
-	{"darkUp",          8},
+	{"darkGray",        3},
 	{"darkGrid",        9},
+	{"darkHorizontal",  5},
 	{"darkTrellis",     10},
-	{"lightHorizontal", 11},
-	{"lightVertical",   12},
+	{"darkUp",          8},
+	{"darkVertical",    6},
+	{"gray0625",        18},
+	{"gray125",         17},
 	{"lightDown",       13},
-	{"lightUp",         14},
+	{"lightGray",       4},
 	{"lightGrid",       15},
+	{"lightHorizontal", 11},
 	{"lightTrellis",    16},
-	{"gray125",         17},
-	{"gray0625",        18}
+	{"lightUp",         14},
+	{"lightVertical",   12},
+	{"mediumGray",      2},
+	{"none",            0},
+	{"solid",           1}
 };
+static_assert(tools::isSortedTable(XLSX_FILL_PATTERN), "XLSX_FILL_PATTERN must be sorted");
 
 // Xlsx
-Xlsx::Xlsx(Book* book)
-	: m_book(book) {}
+Xlsx::Xlsx(Book* book, std::shared_ptr<const ooxml::Archive> archive)
+	: Ooxml(std::move(archive)), m_book(book) {}
 
 void Xlsx::openWorkbookXlsx() {
-	X12Styles x12style(m_book);
+	// All workbook, sheet, style and comment parts are read from one session
+	X12Styles x12style(m_book, archive());
 	x12style.handleTheme();
 	x12style.handleStream();
 
-	X12Book x12book(m_book);
+	X12Book x12book(m_book, archive());
 	x12book.handleSst();
 	x12book.handleRelations();
 	x12book.handleProperties();
@@ -107,8 +119,8 @@ void Xlsx::openWorkbookXlsx() {
 
 
 // X12General
-X12General::X12General(Book* book)
-	: m_book(book) {}
+X12General::X12General(Book* book, std::shared_ptr<const ooxml::Archive> archive)
+	: Ooxml(std::move(archive)), m_book(book) {}
 
 std::string X12General::getNodeText(const pugi::xml_node& node) {
 	std::string result = node.child_value();
@@ -120,12 +132,12 @@ std::string X12General::getNodeText(const pugi::xml_node& node) {
 std::string X12General::getTextFromSiIs(const pugi::xml_node& node) {
 	std::string result;
 	for (const auto& child : node) {
-		std::string tag = child.name();
-		if (tag == "t")
+		const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+		if (tag == ooxml::XmlTag::T)
 			result += getNodeText(child);
-		else if (tag == "r") {
+		else if (tag == ooxml::XmlTag::R) {
 			for (const auto& tNode : child) {
-				if (tNode.name() == std::string("t"))
+				if (ooxml::tagOf(tNode.name()) == ooxml::XmlTag::T)
 					result += getNodeText(tNode);
 			}
 		}
@@ -142,22 +154,96 @@ void X12General::hexToColor(std::vector<unsigned char>& colorMap, const std::str
 
 
 // X12Book public:
-X12Book::X12Book(Book* book)
-: X12General(book) {
+X12Book::X12Book(Book* book, std::shared_ptr<const ooxml::Archive> archive)
+: X12General(book, std::move(archive)) {
 	m_book->m_sheetCount = 0;
 }
 
 void X12Book::handleSst() {
-	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "xl/sharedstrings.xml", tree);
+	if (m_book->m_fastText) {
+		handleSstFast();
+		return;
+	}
+
+	// The table can be huge, so it's streamed. Same rules as `getTextFromSiIs()`:
+	// text of `t` children of `si` and of its `r` runs
+	using Token = ooxml::XmlReader::Token;
+	ooxml::XmlReader reader(archive().get(), "xl/sharedstrings.xml");
+	std::string value;
+	std::string text;
+	int siDepth  = 0;
+	bool inRun   = false;
+	bool inText  = false;
+	bool preserve = false;
+	for (auto token = reader.next(); token != Token::End; token = reader.next()) {
+		if (token == Token::StartElement) {
+			const ooxml::XmlTag tag = ooxml::tagOf(reader.name());
+			if (tag == ooxml::XmlTag::Si) {
+				siDepth = reader.depth();
+				value.clear();
+			}
+			else if (siDepth && tag == ooxml::XmlTag::R && reader.depth() == siDepth + 1) {
+				inRun = true;
+			}
+			else if (siDepth && tag == ooxml::XmlTag::T &&
+					 (reader.depth() == siDepth + 1 || (inRun && reader.depth() == siDepth + 2))) {
+				inText   = true;
+				preserve = reader.rawAttribute("space") == "preserve";
+				text.clear();
+			}
+		}
+		else if (token == Token::Text) {
+			if (inText)
+				text += reader.text();
+		}
+		else if (token == Token::EndElement) {
+			const ooxml::XmlTag tag = ooxml::tagOf(reader.name());
+			if (inText && tag == ooxml::XmlTag::T) {
+				value += preserve ? text : tools::trim(text, "\t\n \r");
+				inText = false;
+			}
+			else if (inRun && tag == ooxml::XmlTag::R) {
+				inRun = false;
+			}
+			else if (siDepth && tag == ooxml::XmlTag::Si && reader.depth() == siDepth) {
+				m_book->m_sharedStrings.emplace_back(value);
+				siDepth = 0;
+			}
+		}
+	}
+}
 
-	for (const auto& node : tree.select_nodes("//si"))
-		m_book->m_sharedStrings.emplace_back(getTextFromSiIs(node.node()));
+void X12Book::handleSstFast() {
+	std::string storage;
+	std::string_view xml;
+	if (!extractFile("xl/sharedstrings.xml", xml, storage))
+		return;
+
+	// Phonetic runs (`rPh`) are not part of the string
+	const ooxml::TextScanner scanner("t", "si", "rPh");
+	std::string value;
+	std::string text;
+	scanner.scan(xml, text, [&](ooxml::TextScanner::Event event) {
+		switch (event) {
+		case ooxml::TextScanner::Event::BlockStart:
+			value.clear();
+			text.clear();
+			break;
+		case ooxml::TextScanner::Event::TextEnd:
+			value += tools::trim(text, "\t\n \r");
+			text.clear();
+			break;
+		case ooxml::TextScanner::Event::BlockEnd:
+			m_book->m_sharedStrings.emplace_back(value);
+			break;
+		}
+		return true;
+	});
 }
 
 void X12Book::handleRelations() {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "xl/_rels/workbook.xml.rels", tree);
+	extractFile("xl/_rels/workbook.xml.rels", tree);
 
 	for (const auto& node : tree.child("Relationships")) {
 		std::string relId   = node.attribute("Id").value();
@@ -178,7 +264,7 @@ void X12Book::handleProperties() {
 		return;
 
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "docprops/core.xml", tree);
+	extractFile("docprops/core.xml", tree);
 
 	for (const auto& node : tree.select_nodes("//dc:creator"))
 		m_book->m_properties["creator"] = node.node().child_value();
@@ -199,17 +285,29 @@ void X12Book::handleStream() {
 	formatting.initializeBook();
 
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "xl/workbook.xml", tree);
+	extractFile("xl/workbook.xml", tree);
 
-	for (const auto& node : tree.select_nodes("//definedNames")) {
-		handleDefinedNames(node.node());
-	}
-	for (const auto& node : tree.select_nodes("//workbookPr")) {
-		std::string date = node.node().attribute("date1904").value();
+	const auto workbook = tree.child("workbook");
+	if (const auto definedNames = workbook.child("definedNames"))
+		handleDefinedNames(definedNames);
+	if (const auto workbookPr = workbook.child("workbookPr")) {
+		std::string date = workbookPr.attribute("date1904").value();
 		m_book->m_dateMode = (date == "1" || date == "true" || date == "on") ? 1 : 0;
 	}
-	for (const auto& node : tree.select_nodes("//sheet")) {
-		handleSheet(node.node());
+	// Worksheets are inflated a few at a time, on the executor's idle helpers too
+	const auto sheetNodes = workbook.child("sheets").children("sheet");
+	std::vector<std::string> sheetParts;
+	for (const auto& node : sheetNodes) {
+		std::string relId = node.attribute("r:id").value();
+		if (m_relIdToType[relId] == "worksheet")
+			sheetParts.push_back(m_relIdToPath[relId]);
+	}
+	ooxml::PartPrefetcher prefetcher(archive(), std::move(sheetParts));
+
+	for (const auto& node : sheetNodes) {
+		if (m_book->isPastDeadline())
+			break;
+		handleSheet(node, prefetcher);
 	}
 }
 
@@ -235,7 +333,7 @@ void X12Book::handleDefinedNames(const pugi::xml_node& node) {
 	createNameMap();
 }
 
-void X12Book::handleSheet(const pugi::xml_node& node) {
+void X12Book::handleSheet(const pugi::xml_node& node, ooxml::PartPrefetcher& prefetcher) {
 	size_t sheetIndex = m_book->m_sheetCount;
 	std::string relId = node.attribute("r:id").value();
 	int sheetId       = node.attribute("sheetId").as_int();
@@ -272,9 +370,18 @@ void X12Book::handleSheet(const pugi::xml_node& node) {
 	size_t found = target.find_last_of("/");
 	std::string relFileName = "xl/worksheets/_rels/"+ target.substr(found + 1) +".rels";
 
-	X12Sheet x12sheet(m_book, sheet);
+	X12Sheet x12sheet(m_book, archive(), sheet);
 	x12sheet.handleRelations(relFileName);
-	x12sheet.handleStream(target);
+	// Sheets that weren't prefetched (e.g. huge ones) are streamed from the archive
+	std::string content;
+	if (prefetcher.take(target, content)) {
+		ooxml::XmlReader reader(content);
+		x12sheet.handleStream(reader);
+	}
+	else {
+		ooxml::XmlReader reader(archive().get(), target);
+		x12sheet.handleStream(reader);
+	}
 
 	for (const auto& rel : x12sheet.m_relIdToType) {
 		if (rel.second == "comments") {
@@ -317,12 +424,12 @@ void X12Book::createNameMap() {
 
 
 // X12Sheet public:
-X12Sheet::X12Sheet(Book* book, Sheet& sheet)
-	: X12General(book), m_sheet(sheet) {}
+X12Sheet::X12Sheet(Book* book, std::shared_ptr<const ooxml::Archive> archive, Sheet& sheet)
+	: X12General(book, std::move(archive)), m_sheet(sheet) {}
 
 void X12Sheet::handleRelations(const std::string& fileName) {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, fileName, tree);
+	extractFile(fileName, tree);
 
 	for (const auto& node : tree.child("Relationships")) {
 		std::string relId   = node.attribute("Id").value();
@@ -339,45 +446,77 @@ void X12Sheet::handleRelations(const std::string& fileName) {
 	}
 }
 
-void X12Sheet::handleStream(const std::string& fileName) {
-	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, fileName, tree);
+void X12Sheet::handleStream(ooxml::XmlReader& reader) {
+	// Sheet is streamed; only one record at a time is loaded into a small DOM
+	using Token = ooxml::XmlReader::Token;
+	pugi::xml_document fragment;
+	std::string xml;
+	for (auto token = reader.next(); token != Token::End; token = reader.next()) {
+		if (token != Token::StartElement)
+			continue;
+		if (m_book->isPastDeadline())
+			break;
+
+		void (X12Sheet::*handler)(const pugi::xml_node&) = nullptr;
+		switch (ooxml::tagOf(reader.name())) {
+		case ooxml::XmlTag::Row:
+			handler = &X12Sheet::handleRow;
+			break;
+		case ooxml::XmlTag::Col:
+			handler = &X12Sheet::handleCol;
+			break;
+		case ooxml::XmlTag::MergeCell:
+			handler = &X12Sheet::handleMergedCells;
+			break;
+		case ooxml::XmlTag::TablePart:
+			handler = &X12Sheet::handleTableParts;
+			break;
+		case ooxml::XmlTag::Dimension:
+			handler = &X12Sheet::handleDimensions;
+			break;
+		default:
+			continue;
+		}
 
-	for (const auto& node : tree.select_nodes("//mergeCell"))
-		handleMergedCells(node.node());
-	for (const auto& node : tree.select_nodes("//tablePart"))
-		handleTableParts(node.node());
-	for (const auto& node : tree.select_nodes("//col"))
-		handleCol(node.node());
-	for (const auto& node : tree.select_nodes("//row"))
-		handleRow(node.node());
-	for (const auto& node : tree.select_nodes("//dimension"))
-		handleDimensions(node.node());
+		if (!reader.readElement(xml))
+			break;
+		// `xml` isn't touched until the next record replaces the fragment
+		fragment.load_buffer_inplace(&xml[0], xml.size());
+		(this->*handler)(fragment.first_child());
+	}
 }
 
 void X12Sheet::handleComments(const std::string& fileName) {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, fileName, tree);
+	extractFile(fileName, tree);
 
+	const auto comments = tree.child("comments");
 	std::vector<std::string> authors;
-	for (const auto& node : tree.select_nodes("//author")) {
-		authors.push_back(node.node().child_value());
+	for (const auto& node : comments.child("authors").children("author")) {
+		authors.push_back(node.child_value());
 	}
-	for (const auto& node : tree.select_nodes("//comment")) {
-		auto nd = node.node();
+	for (const auto& nd : comments.child("commentList").children("comment")) {
 		Note note;
-		note.m_author = authors[nd.attribute("authorId").as_int()];
+		size_t authorId = nd.attribute("authorId").as_uint();
+		if (authorId < authors.size())
+			note.m_author = authors[authorId];
 		cellNameToIndex(nd.attribute("ref").value(), note.m_rowIndex, note.m_colIndex);
-		for (const auto& child : nd.select_nodes("//t"))
-			note.m_text += getNodeText(child.node()) +" ";
+		// Comment text is a rich string: `t` children and `t` of `r` runs
+		for (const auto& child : nd.child("text")) {
+			const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+			if (tag == ooxml::XmlTag::T)
+				note.m_text += getNodeText(child) +" ";
+			else if (tag == ooxml::XmlTag::R)
+				note.m_text += getNodeText(child.child("t")) +" ";
+		}
 		m_sheet.m_cellNoteMap[{note.m_rowIndex, note.m_colIndex}] = note;
 	}
 }
 
+#ifndef DOCPARSER_TEXT_ONLY
 void X12Sheet::getDrawingRelationshipMap(int sheetIndex) {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName,
-					   "xl/drawings/_rels/drawing"+ std::to_string(sheetIndex + 1)+".xml.rels", tree);
+	extractFile("xl/drawings/_rels/drawing"+ std::to_string(sheetIndex + 1)+".xml.rels", tree);
 
 	for (const auto& node : tree.child("Relationships")) {
 		auto id = node.attribute("Id").value();
@@ -389,8 +528,7 @@ void X12Sheet::getDrawingRelationshipMap(int sheetIndex) {
 #if 0
 void X12Sheet::handleImages(int sheetIndex, pugi::xml_node& htmlNode) {
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName,
-					   "xl/drawings/drawing"+ std::to_string(sheetIndex + 1)+".xml", tree);
+	extractFile("xl/drawings/drawing"+ std::to_string(sheetIndex + 1)+".xml", tree);
 
 	for (const auto& node : tree.child("xdr:wsDr")) {
 		std::string imageId = node.select_node(".//a:blip").node().attribute("r:embed").value();
@@ -403,7 +541,7 @@ void X12Sheet::handleImages(int sheetIndex, pugi::xml_node& htmlNode) {
 		// Load image
 		std::string ext = path.substr(path.find_last_of('.') + 1);
 		std::string imageData;
-		Ooxml::extractFile(m_book->m_fileName, path, imageData);
+		extractFile(path, imageData);
 		m_book->m_imageList.emplace_back(std::make_pair(std::move(imageData), ext));
 
 		// Add image node
@@ -416,6 +554,7 @@ void X12Sheet::handleImages(int sheetIndex, pugi::xml_node& htmlNode) {
 	}
 }
 #endif
+#endif  // DOCPARSER_TEXT_ONLY
 
 // X12Sheet private:
 void X12Sheet::handleCol(const pugi::xml_node& node) {
@@ -480,12 +619,11 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
                     charIndex += 1;
                     if (c == '$')
                         continue;
-                    if (UPPERCASE_REL_INDEX.find(c) == UPPERCASE_REL_INDEX.end())
+                    int lv = upperCaseRelIndex(c);
+                    if (lv < 0)
                         throw std::logic_error(
                                 "Unexpected character "+ std::string(1, c) +" in cell name "+ cellName
                                 );
-
-                    int lv = UPPERCASE_REL_INDEX.at(c);
                     if (lv) {
                         colIndex = colIndex * 26 + lv;
                     }
@@ -510,13 +648,13 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // into float() OR there's no text in which case it's a BLANK cell
             if (cellType.empty()) {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "v")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::V)
                         value = child.child_value();
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = getNodeText(child);
                     else
-                        throw std::logic_error("Unexpected tag " + childName);
+                        throw std::logic_error(std::string("Unexpected tag ") + child.name());
                 }
                 if (value.empty()) {
                     //				if (m_book->m_addStyle)
@@ -531,15 +669,15 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // text which can go straight into int()
             else if (cellType == "s") {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "v")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::V)
                         value = child.child_value();
                     // Formula not expected here, but gnumeric does it
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = child.child_value();
                     else
                         throw std::logic_error(
-                                "Cell type "+ cellType +" has unexpected child <"+ childName +"> at rowx="+
+                                "Cell type "+ cellType +" has unexpected child <"+ child.name() +"> at rowx="+
                                 std::to_string(m_rowIndex) +" colx="+ std::to_string(colIndex)
                                 );
                 }
@@ -559,14 +697,14 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // all text cells are str with no formula. <v> child can contain escapes
             else if (cellType == "str") {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "v")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::V)
                         value = getNodeText(child);
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = getNodeText(child);
                     else
                         throw std::logic_error(
-                                "Cell type "+ cellType +" has unexpected child <"+ childName +"> at rowx="+
+                                "Cell type "+ cellType +" has unexpected child <"+ child.name() +"> at rowx="+
                                 std::to_string(m_rowIndex) +" colx="+ std::to_string(colIndex)
                                 );
                 }
@@ -577,14 +715,14 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // cnv_xsd_boolean; ECMA standard is silent; Excel 2007 writes 0 or 1
             else if (cellType == "b") {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "v")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::V)
                         value = child.child_value();
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = getNodeText(child);
                     else
                         throw std::logic_error(
-                                "Cell type "+ cellType +" has unexpected child <"+ childName +"> at rowx="+
+                                "Cell type "+ cellType +" has unexpected child <"+ child.name() +"> at rowx="+
                                 std::to_string(m_rowIndex) +" colx="+ std::to_string(colIndex)
                                 );
                 }
@@ -594,18 +732,18 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // e = error. <v> child contains e.g. "#REF!"
             else if (cellType == "e") {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "v")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::V)
                         value = child.child_value();
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = getNodeText(child);
                     else
                         throw std::logic_error(
-                                "Cell type "+ cellType +" has unexpected child <"+ childName +"> at rowx="+
+                                "Cell type "+ cellType +" has unexpected child <"+ child.name() +"> at rowx="+
                                 std::to_string(m_rowIndex) +" colx="+ std::to_string(colIndex)
                                 );
                 }
-                m_sheet.append(std::to_string(ERROR_CODE_FROM_TEXT.at(value)));
+                m_sheet.append(std::to_string(tools::tableAt(ERROR_CODE_FROM_TEXT, value)));
                 //			m_sheet.putCell(m_rowIndex, colIndex, std::to_string(ERROR_CODE_FROM_TEXT.at(value)),
                 //							xfIndex);
             }
@@ -613,16 +751,16 @@ void X12Sheet::handleRow(const pugi::xml_node& node) {
             // text (including rich text) cells without having to build a shared string table (SST)
             else if (cellType == "inlineStr") {
                 for (const auto& child : cellNode) {
-                    std::string childName = child.name();
-                    if (childName == "is")
+                    const ooxml::XmlTag childTag = ooxml::tagOf(child.name());
+                    if (childTag == ooxml::XmlTag::Is)
                         value = getTextFromSiIs(child);
-                    else if (childName == "v")
+                    else if (childTag == ooxml::XmlTag::V)
                         value = child.child_value();
-                    else if (childName == "f")
+                    else if (childTag == ooxml::XmlTag::F)
                         formula = child.child_value();
                     else
                         throw std::logic_error(
-                                "Cell type "+ cellType +" has unexpected child <"+ childName +"> at rowx="+
+                                "Cell type "+ cellType +" has unexpected child <"+ child.name() +"> at rowx="+
                                 std::to_string(m_rowIndex) +" colx="+ std::to_string(colIndex)
                                 );
                 }
@@ -690,7 +828,7 @@ void X12Sheet::handleTableParts(const pugi::xml_node& node) {
 
 	// Extract file data
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, relFileName, tree);
+	extractFile(relFileName, tree);
 
 	auto nd = tree.child("table");
 	std::string ref = nd.attribute("ref").value();
@@ -731,12 +869,11 @@ void X12Sheet::cellNameToIndex(const std::string& cellName, int& rowIndex,
 
 	for (const auto& c : cellName) {
 		charIndex += 1;
-		if (UPPERCASE_REL_INDEX.find(c) == UPPERCASE_REL_INDEX.end())
+		int lv = upperCaseRelIndex(c);
+		if (lv < 0)
 			throw std::logic_error(
 				"Unexpected character "+ std::string(1, c) +" in cell name "+ cellName
 			);
-
-		int lv = UPPERCASE_REL_INDEX.at(c);
 		if (lv) {
 			colIndex = colIndex * 26 + lv;
 		}
@@ -762,6 +899,7 @@ void X12Sheet::cellNameToIndex(const std::string& cellName, int& rowIndex,
 	rowIndex = stoi(cellName.substr(charIndex)) - 1;
 }
 
+#ifndef DOCPARSER_TEXT_ONLY
 void X12Sheet::getImageSize(const pugi::xml_node& xmlNode, pugi::xml_node& htmlNode) const {
 	auto child = xmlNode.select_node(".//a:xfrm").node().child("a:ext");
 	if (!child)
@@ -774,11 +912,12 @@ void X12Sheet::getImageSize(const pugi::xml_node& xmlNode, pugi::xml_node& htmlN
 	style += "height: " + std::to_string(height) + "px;";
 	htmlNode.append_attribute("style") = style.c_str();
 }
+#endif
 
 
 // X12Styles public:
-X12Styles::X12Styles(Book* book)
-: X12General(book) {
+X12Styles::X12Styles(Book* book, std::shared_ptr<const ooxml::Archive> archive)
+: X12General(book, std::move(archive)) {
 	for (int i = 14; i < 23; ++i)
 		m_isDateFormat[i] = 1;
 	for (int i = 45; i < 48; ++i)
@@ -792,7 +931,7 @@ void X12Styles::handleTheme() {
 		return;
 
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "xl/theme/theme1.xml", tree);
+	extractFile("xl/theme/theme1.xml", tree);
 
 	int colorIndex = -2;
 	for (const auto& node : tree.select_nodes("//a:sysClr")) {
@@ -811,7 +950,7 @@ void X12Styles::handleStream() {
 		return;
 
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_book->m_fileName, "xl/styles.xml", tree);
+	extractFile("xl/styles.xml", tree);
 
 	int fontIndex = 0;
 	for (const auto& node : tree.select_nodes("//numFmt"))
@@ -840,27 +979,27 @@ void X12Styles::handleFont(const pugi::xml_node& node, int fontIndex) {
 	f.m_fontIndex = fontIndex;
 
 	for (const auto& child : node) {
-		std::string childName = child.name();
-		if (childName == "name")
+		const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+		if (tag == ooxml::XmlTag::Name)
 			f.m_name = child.attribute("val").value();
-		else if (childName == "sz")
+		else if (tag == ooxml::XmlTag::Sz)
 			f.m_height = child.attribute("val").as_int() * 20;
-		else if (childName == "color")
+		else if (tag == ooxml::XmlTag::Color)
 			extractColor(child, f.m_color);
-		else if (childName == "vertAlign") {
+		else if (tag == ooxml::XmlTag::VertAlign) {
 			std::string val = child.attribute("val").value();
 			if (val == "superscript")
 				f.m_escapement = 1;
 			if (val == "subscript")
 				f.m_escapement = 2;
 		}
-		else if (childName == "family")
+		else if (tag == ooxml::XmlTag::Family)
 			f.m_family = child.attribute("val").as_int();
-		else if (childName == "b")
+		else if (tag == ooxml::XmlTag::B)
 			f.m_isBold = true;
-		else if (childName == "i")
+		else if (tag == ooxml::XmlTag::I)
 			f.m_isItalic = true;
-		else if (childName == "u") {
+		else if (tag == ooxml::XmlTag::U) {
 			f.m_isUnderlined = true;
 			std::string value = child.attribute("val").value();
 			if (value == "double" || value == "doubleAccounting")
@@ -868,7 +1007,7 @@ void X12Styles::handleFont(const pugi::xml_node& node, int fontIndex) {
 			else
 				f.m_underlineType = 1;
 		}
-		else if (childName == "strike")
+		else if (tag == ooxml::XmlTag::Strike)
 			f.m_isStruckOut = true;
 	}
 
@@ -882,25 +1021,25 @@ void X12Styles::handleBorder(const pugi::xml_node& node) {
 	border.m_diagUp   = node.attribute("diagonalUp");
 
 	for (const auto& child : node) {
-		std::string childName = child.name();
-		if (childName == "left") {
-			border.m_leftLineStyle = XLSX_BORDER_TYPE.at(child.attribute("style").value());
+		const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+		if (tag == ooxml::XmlTag::Left) {
+			border.m_leftLineStyle = tools::tableAt(XLSX_BORDER_TYPE, child.attribute("style").value());
 			extractColor(child.first_child(), border.m_leftColor);
 		}
-		else if (childName == "right") {
-			border.m_rightLineStyle = XLSX_BORDER_TYPE.at(child.attribute("style").value());
+		else if (tag == ooxml::XmlTag::Right) {
+			border.m_rightLineStyle = tools::tableAt(XLSX_BORDER_TYPE, child.attribute("style").value());
 			extractColor(child.first_child(), border.m_rightColor);
 		}
-		else if (childName == "top") {
-			border.m_topLineStyle = XLSX_BORDER_TYPE.at(child.attribute("style").value());
+		else if (tag == ooxml::XmlTag::Top) {
+			border.m_topLineStyle = tools::tableAt(XLSX_BORDER_TYPE, child.attribute("style").value());
 			extractColor(child.first_child(), border.m_topColor);
 		}
-		else if (childName == "bottom") {
-			border.m_bottomLineStyle = XLSX_BORDER_TYPE.at(child.attribute("style").value());
+		else if (tag == ooxml::XmlTag::Bottom) {
+			border.m_bottomLineStyle = tools::tableAt(XLSX_BORDER_TYPE, child.attribute("style").value());
 			extractColor(child.first_child(), border.m_bottomColor);
 		}
-		else if (childName == "diagonal") {
-			border.m_diagLineStyle = XLSX_BORDER_TYPE.at(child.attribute("style").value());
+		else if (tag == ooxml::XmlTag::Diagonal) {
+			border.m_diagLineStyle = tools::tableAt(XLSX_BORDER_TYPE, child.attribute("style").value());
 			extractColor(child.first_child(), border.m_diagColor);
 		}
 	}
@@ -911,13 +1050,13 @@ void X12Styles::handleBorder(const pugi::xml_node& node) {
 void X12Styles::handleBackground(const pugi::xml_node& node) {
 	XFBackground background;
 
-	background.m_fillPattern = XLSX_FILL_PATTERN.at(node.attribute("patternType").value());
+	background.m_fillPattern = tools::tableAt(XLSX_FILL_PATTERN, node.attribute("patternType").value());
 
 	for (const auto& child : node) {
-		std::string childName = child.name();
-		if (childName == "fgColor")
+		const ooxml::XmlTag tag = ooxml::tagOf(child.name());
+		if (tag == ooxml::XmlTag::FgColor)
 			extractColor(child, background.m_patternColor);
-		else if (childName == "bgColor")
+		else if (tag == ooxml::XmlTag::BgColor)
 			extractColor(child, background.m_backgroundColor);
 	}
 
@@ -926,10 +1065,10 @@ void X12Styles::handleBackground(const pugi::xml_node& node) {
 
 void X12Styles::handleXf(const pugi::xml_node& node) {
 	int xfIndex;
-	std::string parentName = node.parent().name();
-	if (parentName == "cellStyleXfs")
+	const ooxml::XmlTag parentTag = ooxml::tagOf(node.parent().name());
+	if (parentTag == ooxml::XmlTag::CellStyleXfs)
 		xfIndex = m_xfCount[0]++;
-	else if (parentName == "cellXfs")
+	else if (parentTag == ooxml::XmlTag::CellXfs)
 		xfIndex = m_xfCount[1]++;
 
 	XF xf;
@@ -945,9 +1084,9 @@ void X12Styles::handleXf(const pugi::xml_node& node) {
 
 	auto align = node.child("alignment");
 	if (align) {
-		xf.m_alignment.m_horizontalAlign = XLSX_HORZ_ALIGN.at(align.attribute("horizontal").value());
+		xf.m_alignment.m_horizontalAlign = tools::tableAt(XLSX_HORZ_ALIGN, align.attribute("horizontal").value());
 		xf.m_alignment.m_isTextWrapped   = align.attribute("wrapText").as_int();
-		xf.m_alignment.m_verticalAlign   = XLSX_VERT_ALIGN.at(align.attribute("vertical").value());
+		xf.m_alignment.m_verticalAlign   = tools::tableAt(XLSX_VERT_ALIGN, align.attribute("vertical").value());
 		xf.m_alignment.m_indentLevel     = align.attribute("indent").as_int();
 		xf.m_alignment.m_isShrinkToFit   = align.attribute("shrinkToFit");
 		//xf.m_alignment.m_textDirection = ???
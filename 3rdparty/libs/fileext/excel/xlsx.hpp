@@ -8,12 +8,16 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <pugixml.hpp>
 
 #include "fileext/ooxml/ooxml.hpp"
+#include "fileext/ooxml/prefetch.hpp"
+#include "fileext/ooxml/xmlreader.hpp"
 
 #include "book.hpp"
 #include "format.hpp"
@@ -31,9 +35,11 @@ public:
 	/**
 	 * @param[in] book
 	 *     Pointer to parent Book object
+	 * @param[in] archive
+	 *     Opened package of the book
 	 * @since 1.0
 	 */
-	Xlsx(Book* book);
+	Xlsx(Book* book, std::shared_ptr<const ooxml::Archive> archive);
 
 	/**
 	 * @brief
@@ -57,9 +63,11 @@ public:
 	/**
 	 * @param[in] book
 	 *     Pointer to parent Book object
+	 * @param[in] archive
+	 *     Archive session shared with the other workbook parts
 	 * @since 1.0
 	 */
-	X12General(Book* book);
+	X12General(Book* book, std::shared_ptr<const ooxml::Archive> archive);
 
 	/**
 	 * @brief
@@ -111,9 +119,11 @@ public:
 	/**
 	 * @param book
 	 *     Pointer to parent Book object
+	 * @param[in] archive
+	 *     Archive session shared with the other workbook parts
 	 * @since 1.0
 	 */
-	X12Book(Book* book);
+	X12Book(Book* book, std::shared_ptr<const ooxml::Archive> archive);
 
 	/**
 	 * @brief
@@ -144,6 +154,13 @@ public:
 	void handleStream();
 
 private:
+	/**
+	 * @brief
+	 *     Read SST with fast text-run scanner
+	 * @since 1.2
+	 */
+	void handleSstFast();
+
 	/**
 	 * @brief
 	 *     Read defined names data
@@ -158,9 +175,11 @@ private:
 	 *     Read sheet data
 	 * @param[in] node
 	 *     Node in XML-tree
+	 * @param[in] prefetcher
+	 *     Prefetcher of worksheet parts
 	 * @since 1.0
 	 */
-	void handleSheet(const pugi::xml_node& node);
+	void handleSheet(const pugi::xml_node& node, ooxml::PartPrefetcher& prefetcher);
 
 	/**
 	 * @brief
@@ -190,11 +209,13 @@ public:
 	/**
 	 * @param[in] book
 	 *     Pointer to parent Book object
+	 * @param[in] archive
+	 *     Archive session shared with the other workbook parts
 	 * @param[in] sheet
 	 *     Reference to SHEET object
 	 * @since 1.0
 	 */
-	X12Sheet(Book* book, Sheet& sheet);
+	X12Sheet(Book* book, std::shared_ptr<const ooxml::Archive> archive, Sheet& sheet);
 
 	/**
 	 * @brief
@@ -208,11 +229,11 @@ public:
 	/**
 	 * @brief
 	 *     Read main stream data
-	 * @param[in] fileName
-	 *     XML data file name
+	 * @param[in] reader
+	 *     Reader of worksheet part
 	 * @since 1.0
 	 */
-	void handleStream(const std::string& fileName);
+	void handleStream(ooxml::XmlReader& reader);
 
 	/**
 	 * @brief
@@ -223,6 +244,7 @@ public:
 	 */
 	void handleComments(const std::string& fileName);
 
+#ifndef DOCPARSER_TEXT_ONLY
 	/**
 	 * @brief
 	 *     Get drawing relationship map from `xl/drawings/_rels/drawingN.xml.rels`
@@ -242,6 +264,7 @@ public:
 	 * @since 1.1
 	 */
 	void handleImages(int sheetIndex, pugi::xml_node& htmlNode);
+#endif
 
 	/** Map relation id to path */
 	std::unordered_map<std::string, std::string> m_relIdToPath;
@@ -313,6 +336,7 @@ private:
 	void cellNameToIndex(const std::string& cellName, int& rowIndex,int& colIndex,
 						 bool noCol = false);
 
+#ifndef DOCPARSER_TEXT_ONLY
 	/**
 	 * @brief
 	 *     Get image size and update `img` tag
@@ -323,11 +347,14 @@ private:
 	 * @since 1.1
 	 */
 	void getImageSize(const pugi::xml_node& xmlNode, pugi::xml_node& htmlNode) const;
+#endif
 
 	/** Reference to SHEET object */
 	Sheet& m_sheet;
+#ifndef DOCPARSER_TEXT_ONLY
 	/** Drawing relationship map */
 	std::unordered_map<std::string, std::string> m_drawingRelationshipMap;
+#endif
 	/** Row index */
 	int m_rowIndex = -1;
 };
@@ -343,9 +370,11 @@ public:
 	/**
 	 * @param[in] book
 	 *     Pointer to parent Book object
+	 * @param[in] archive
+	 *     Archive session shared with the other workbook parts
 	 * @since 1.0
 	 */
-	X12Styles(Book* book);
+	X12Styles(Book* book, std::shared_ptr<const ooxml::Archive> archive);
 
 	/**
 	 * @brief
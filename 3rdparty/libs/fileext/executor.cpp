@@ -0,0 +1,105 @@
+/**
+ * @brief   Worker threads shared by all conversions of the process
+ * @package fileext
+ * @file    executor.cpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#include <algorithm>
+#include <exception>
+#include <system_error>
+
+#include "executor.hpp"
+
+
+namespace fileext {
+
+// Executor public:
+Executor& Executor::shared() {
+	static Executor executor(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return executor;
+}
+
+Executor::Executor(size_t threads) {
+	try {
+		for (size_t i = 0; i < threads; ++i)
+			m_threads.emplace_back(&Executor::work, this);
+	}
+	catch (const std::system_error&) {
+		// Fewer helpers (or none) only means less parallelism
+	}
+}
+
+Executor::~Executor() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_queued.notify_all();
+	for (auto& thread : m_threads)
+		thread.join();
+}
+
+void Executor::run(size_t helpers, const std::function<void()>& helper, const std::function<void()>& caller) {
+	Job job {&helper, std::min(helpers, m_threads.size()), 0};
+	const bool isQueued = job.pending > 0;
+	if (isQueued) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queue.push_back(&job);
+		}
+		if (helpers == 1)
+			m_queued.notify_one();
+		else
+			m_queued.notify_all();
+	}
+
+	std::exception_ptr error;
+	try {
+		caller();
+	}
+	catch (...) {
+		error = std::current_exception();
+	}
+
+	if (isQueued) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (job.pending > 0) {
+			job.pending = 0;
+			m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), &job), m_queue.end());
+		}
+		m_finished.wait(lock, [&job] { return job.running == 0; });
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+// private:
+void Executor::work() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_queued.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+		if (m_stop)
+			break;
+
+		Job* job = m_queue.front();
+		if (--job->pending == 0)
+			m_queue.pop_front();
+		++job->running;
+		lock.unlock();
+
+		try {
+			(*job->helper)();
+		}
+		catch (...) {
+			// The caller finishes the work, a helper only takes part of it
+		}
+
+		lock.lock();
+		--job->running;
+		m_finished.notify_all();
+	}
+}
+
+}  // End namespace
@@ -0,0 +1,113 @@
+/**
+ * @brief   Worker threads shared by all conversions of the process
+ * @package fileext
+ * @file    executor.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace fileext {
+
+/**
+ * @class Executor
+ * @brief
+ *     Fixed set of helper threads for parallel parts of a conversion
+ * @details
+ *     Parsers don't start threads of their own: a document converted on each
+ *     of several application threads would multiply them. Instead the calling
+ *     thread always does its share of the work and borrows idle helpers of
+ *     the shared executor, which has one thread less than there are cores.
+ *
+ *     The caller never waits for a helper that hasn't started yet: once its own
+ *     share is done, requests still queued are dropped, so nested use (a part
+ *     handler running another parallel job) can't deadlock.
+ */
+class Executor {
+public:
+	/**
+	 * @brief
+	 *     Executor of the process, helper threads are started on first use
+	 * @since 1.2
+	 */
+	static Executor& shared();
+
+	/**
+	 * @param[in] threads
+	 *     Number of helper threads
+	 * @since 1.2
+	 */
+	explicit Executor(size_t threads);
+
+	/** Stops and joins the helpers */
+	~Executor();
+
+	Executor(const Executor&) = delete;
+	Executor& operator=(const Executor&) = delete;
+
+	/**
+	 * @brief
+	 *     Number of helper threads
+	 * @since 1.2
+	 */
+	size_t size() const { return m_threads.size(); }
+
+	/**
+	 * @brief
+	 *     Run job on the calling thread and on up to `helpers` idle helpers
+	 * @details
+	 *     Both functions are expected to take work items from a shared queue
+	 *     until it is empty. Returns when `caller` and every started helper
+	 *     run are done. Exceptions of `caller` are rethrown after that,
+	 *     exceptions of `helper` are dropped.
+	 * @param[in] helpers
+	 *     Maximum number of helper runs
+	 * @param[in] helper
+	 *     Work of a helper thread
+	 * @param[in] caller
+	 *     Work of the calling thread
+	 * @since 1.2
+	 */
+	void run(size_t helpers, const std::function<void()>& helper, const std::function<void()>& caller);
+
+private:
+	/** Helper runs requested by one run() call */
+	struct Job {
+		const std::function<void()>* helper;
+		/** Runs not started yet */
+		size_t pending;
+		/** Runs in progress */
+		size_t running;
+	};
+
+	/**
+	 * @brief
+	 *     Loop of a helper thread
+	 * @since 1.2
+	 */
+	void work();
+
+	/** Helper threads */
+	std::vector<std::thread> m_threads;
+	/** Jobs with pending runs */
+	std::deque<Job*> m_queue;
+	/** Guards m_queue, m_stop and the jobs */
+	std::mutex m_mutex;
+	/** Signals queued jobs and stop */
+	std::condition_variable m_queued;
+	/** Signals finished helper runs */
+	std::condition_variable m_finished;
+	/** Set by the destructor */
+	bool m_stop = false;
+};
+
+}  // End namespace
@@ -16,10 +16,6 @@
 
 namespace fileext {
 
-/** Config script file path */
-const std::string LIB_PATH = tools::PROGRAM_PATH + "/files/libs";
-const std::string SCRIPT_FILE = LIB_PATH + "/xpathconfig.min.js";
-
 // public:
 FileExtension::FileExtension(const std::string& fileName)
 	: m_fileName(fileName) {}
@@ -72,7 +68,13 @@ bool FileExtension::safeAppendText(const std::string& text)
 
 bool FileExtension::shouldStopProcessing() const
 {
-	return m_truncationEnabled && m_text.size() >= m_maxBytes;
+	return (m_truncationEnabled && m_text.size() >= m_maxBytes) || isPastDeadline();
+}
+
+bool FileExtension::isPastDeadline() const
+{
+	return m_deadline != std::chrono::steady_clock::time_point::max() &&
+		   std::chrono::steady_clock::now() >= m_deadline;
 }
 
 std::string FileExtension::truncateAtBoundary(const std::string& text, size_t maxLength) const
@@ -11,10 +11,16 @@
 // Uncomment this line to enable downloading images from URL (requires `cUrl` library)
 // #define DOWNLOAD_IMAGES
 
+// Define `DOCPARSER_TEXT_ONLY` (cmake -DDOCPARSER_TEXT_ONLY=ON) to compile out HTML-tree, styles
+// and images. Converters only fill `m_text` in this mode
+
+#include <chrono>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <pugixml.hpp>
 
+#include "arena.hpp"
 
 /**
  * @namespace fileext
@@ -23,6 +29,9 @@
  */
 namespace fileext {
 
+/** Default nesting cap of block walks */
+constexpr unsigned DEFAULT_MAX_NESTING = 256;
+
 /**
  * @class FileExtension
  * @brief
@@ -53,8 +62,15 @@ public:
 	 */
     virtual int convert(bool addStyle = true, bool extractImages = false, char mergingMode = 0) = 0;
 
+protected:
+	/** Arena of the lookup tables, declared first: everything allocated from it is destroyed before it */
+	Arena m_arena;
+
+public:
+#ifndef DOCPARSER_TEXT_ONLY
 	/** Result HTML tree */
 	pugi::xml_document m_htmlTree;
+#endif
 
     std::string m_text = "";
 
@@ -87,6 +103,40 @@ public:
 	 */
 	void markAsTruncated() { m_truncated = true; }
 
+	/**
+	 * @brief Use fast text-run extraction instead of full parsing, if the format supports it
+	 * @details Only text elements and paragraph boundaries are read, structure
+	 *          (lists, tables, hyperlink targets) is not interpreted
+	 * @param[in] enabled Fast mode switch
+	 * @since 1.2
+	 */
+	void setFastTextMode(bool enabled) { m_fastText = enabled; }
+
+	/**
+	 * @brief Convert content held in memory instead of reading the file
+	 * @details Used for embedded documents. `m_fileName` only names the content then.
+	 *          Supported by docx, pptx, xlsx, xls, doc and ppt converters
+	 * @param[in] content File content, must outlive convert()
+	 * @since 1.2
+	 */
+	void setContent(std::string_view content) { m_content = content; }
+
+	/**
+	 * @brief Set nesting cap of block walks (tables in tables, text boxes, links)
+	 * @details Content nested deeper is skipped, the walk itself never recurses
+	 * @param[in] depth Maximum number of open containers
+	 * @since 1.2
+	 */
+	void setMaxNesting(unsigned depth) { m_maxNesting = depth; }
+
+	/**
+	 * @brief Stop reading once the time point is reached, the text read so far is kept
+	 * @details Checked by shouldStopProcessing() and between parts of a document
+	 * @param[in] deadline Time point, `time_point::max()` (the default) for none
+	 * @since 1.2
+	 */
+	void setDeadline(std::chrono::steady_clock::time_point deadline) { m_deadline = deadline; }
+
 protected:
 //    int m_maxLen = 0;
 	/** Name of processing file */
@@ -104,14 +154,28 @@ protected:
 	char m_mergingMode = 0;
 	/** True if should extract images */
 	bool m_extractImages = false;
+#ifndef DOCPARSER_TEXT_ONLY
 	/** List of images (binary data and extension) */
 	std::vector<std::pair<std::string, std::string>> m_imageList;
+#endif
 
 	/** Truncation control members */
 	size_t m_maxBytes = 0;           // 0 means no limit
 	bool m_truncationEnabled = false; // Truncation switch
 	bool m_truncated = false;        // Truncation status flag
 
+	/** Fast text-run extraction mode */
+	bool m_fastText = false;
+
+	/** File content given by setContent(), empty to read `m_fileName` */
+	std::string_view m_content;
+
+	/** Nesting cap given by setMaxNesting() */
+	unsigned m_maxNesting = DEFAULT_MAX_NESTING;
+
+	/** Deadline given by setDeadline() */
+	std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+
 	/**
 	 * @brief Safely append text with truncation control
 	 * @param[in] text Text to append
@@ -121,12 +185,18 @@ protected:
 	bool safeAppendText(const std::string& text);
 
 	/**
-	 * @brief Check if processing should stop due to truncation
+	 * @brief Check if processing should stop due to truncation or deadline
 	 * @return true if processing should stop
 	 * @since 1.1.2
 	 */
 	bool shouldStopProcessing() const;
 
+	/**
+	 * @brief Check if the deadline given by setDeadline() has passed
+	 * @since 1.2
+	 */
+	bool isPastDeadline() const;
+
 	/**
 	 * @brief Truncate text at reasonable boundary (sentence, word, etc.)
 	 * @param[in] text Text to truncate
@@ -9,6 +9,8 @@
 #include <fstream>
 #include <string.h>
 
+#include "fileext/ooxml/xmltag.hpp"
+
 #include "odf.hpp"
 
 #include <iostream>
@@ -18,16 +20,15 @@ namespace odf {
 Odf::Odf(const std::string& fileName)
     : FileExtension(fileName)
 {
-    m_cmdHandlers["table:table"] = &Odf::parseODFXMLTable;
-    m_cmdHandlers["text:p"] = &Odf::parseODFXMLPara;
-    m_cmdHandlers["text:a"] = &Odf::parserODFXMLUrl;
 }
 
 int  Odf::convert(bool addStyle, bool extractImages, char mergingMode)
 {
+	openArchive(m_fileName);
 	pugi::xml_document tree;
-	Ooxml::extractFile(m_fileName, "content.xml", tree);
-    m_text = parseXmlData(tree);
+	extractFile("content.xml", tree);
+    m_text.clear();
+    parseXmlData(tree);
 
     return 0;
 }
@@ -38,69 +39,63 @@ std::string Odf::xmlLocateName(const pugi::xml_node &node)
     return p ? p + 1 : node.name();
 }
 
-void Odf::parseODFXMLTable(Odf *parser, pugi::xml_node &node, std::string &text)
-{
-    std::string cellStr;
-    for (const auto &rowNode : node.children("table:table-row")) {
-        cellStr.clear();
-        for (auto &cellNode : rowNode.children("table:table-cell")) {
-            cellStr += parser->parseXmlData(cellNode) + '\n';
-        }
-        text += cellStr;
-    }
-}
-
-void Odf::parseODFXMLPara(Odf *parser, pugi::xml_node &node, std::string &text)
-{
-    text += parser->parseXmlData(node) + '\n';
-}
-
-void Odf::parserODFXMLUrl(Odf *parser, pugi::xml_node &node, std::string &text)
-{
-    text += parser->parseXmlData(node) + '\n';
-}
-
-std::string Odf::parseXmlData(const pugi::xml_node &node)
+void Odf::parseXmlData(const pugi::xml_node &node)
 {
-    auto curNode = node.first_child();
-    std::string text;
-    do {
-        if (!executeCommand(curNode, text)) {
-            if (curNode.first_child()) {
-                curNode = curNode.first_child();
+    // Frame 0 is the node itself: it doesn't end with line break
+    std::vector<Frame> stack;
+    stack.push_back({node, node.first_child(), pugi::xml_node(), false});
+    while (!stack.empty()) {
+        Frame &frame = stack.back();
+        if (frame.isTable) {
+            // Rows outside of `table:table-row` (header rows, row groups) aren't read
+            while (!frame.next && frame.row) {
+                frame.row  = frame.row.next_sibling("table:table-row");
+                frame.next = frame.row.child("table:table-cell");
+            }
+            if (!frame.next) {
+                stack.pop_back();
                 continue;
             }
+            const pugi::xml_node cell = frame.next;
+            frame.next = cell.next_sibling("table:table-cell");
+            if (stack.size() < m_maxNesting)
+                stack.push_back({cell, cell.first_child(), pugi::xml_node(), false});
+            continue;
         }
 
-        if (curNode.next_sibling())
-            curNode = curNode.next_sibling();
-        else {
-            // Borland C++ workaround
-            while (!curNode.next_sibling() && curNode != node && !curNode.parent().empty()) {
-                curNode = curNode.parent();
-            }
-
-            if (curNode != node)
-                curNode = curNode.next_sibling();
+        const pugi::xml_node curNode = frame.next;
+        if (!curNode) {
+            stack.pop_back();
+            if (!stack.empty())
+                m_text += '\n';
+            continue;
         }
-    } while (curNode && curNode != node);
 
-    return text;
-}
+        // Frame content is skipped by the walk, it is read by the frame itself
+        const ooxml::XmlTag tag = ooxml::tagOf(curNode.name());
+        const bool isTable = tag == ooxml::XmlTag::TableTable;
+        const bool isFrame = isTable || tag == ooxml::XmlTag::TextP || tag == ooxml::XmlTag::TextA;
+        if (!isFrame && curNode.first_child())
+            frame.next = curNode.first_child();
+        else {
+            auto nextNode = curNode;
+            while (!nextNode.next_sibling() && nextNode != frame.root)
+                nextNode = nextNode.parent();
+            frame.next = nextNode != frame.root ? nextNode.next_sibling() : pugi::xml_node();
+        }
 
-bool Odf::executeCommand(pugi::xml_node &node, std::string &text)
-{
-    const auto &it = m_cmdHandlers.find(node.name());
-    if (it != m_cmdHandlers.end()) {
-        (*it->second)(this, node, text);
-        return true;
-    } else {
-        std::string value = node.value();
-        if (!value.empty())
-            text += value;
+        if (!isFrame)
+            m_text += curNode.value();
+        else if (stack.size() < m_maxNesting) {
+            // `frame` is invalidated here
+            if (isTable) {
+                const pugi::xml_node row = curNode.child("table:table-row");
+                stack.push_back({curNode, row.child("table:table-cell"), row, true});
+            }
+            else
+                stack.push_back({curNode, curNode.first_child(), pugi::xml_node(), false});
+        }
     }
-
-    return false;
 }
 
 }  // End namespace
@@ -9,7 +9,7 @@
 #pragma once
 
 #include <string>
-#include <map>
+#include <vector>
 #include <pugixml.hpp>
 
 #include "fileext/fileext.hpp"
@@ -29,7 +29,6 @@ namespace odf {
  */
 class Odf: public fileext::FileExtension, public ooxml::Ooxml {
 public:
-    typedef void (*CommandHandler)(Odf *, pugi::xml_node &, std::string &);
     typedef std::vector<std::string> svector;
 	/**
 	 * @param[in] fileName
@@ -54,16 +53,34 @@ public:
 	 */
     int convert(bool addStyle = true, bool extractImages = false, char mergingMode = 0) override;
 private:
-    std::string xmlLocateName(const pugi::xml_node &node);
-    std::string parseXmlData(const pugi::xml_node &node);
-    bool executeCommand(pugi::xml_node &node, std::string &text);
+    /**
+     * @brief
+     *     Open element of content walk
+     */
+    struct Frame {
+        /** Paragraph, link, table cell or table */
+        pugi::xml_node root;
+        /** Next node to read (next cell of current row for table) */
+        pugi::xml_node next;
+        /** Current row (table) */
+        pugi::xml_node row;
+        /** True for `table:table` */
+        bool isTable;
+    };
 
-    static void parseODFXMLTable(Odf *parser, pugi::xml_node &node, std::string &text);
-    static void parseODFXMLPara(Odf *parser, pugi::xml_node &node, std::string &text);
-    static void parserODFXMLUrl(Odf *parser, pugi::xml_node &node, std::string &text);
+    std::string xmlLocateName(const pugi::xml_node &node);
 
-private:
-    std::map<std::string, CommandHandler> m_cmdHandlers;
+    /**
+     * @brief
+     *     Append text of node content to `m_text`
+     * @details
+     *     Paragraphs, links and table cells are frames of an explicit stack and
+     *     end with line break. Elements nested deeper than the nesting cap are skipped.
+     * @param[in] node
+     *     Document or element
+     * @since 1.2
+     */
+    void parseXmlData(const pugi::xml_node &node);
 };
 
 }  // End namespace
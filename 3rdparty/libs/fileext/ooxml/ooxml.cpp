@@ -5,86 +5,554 @@
  * @author  dmryutov (dmryutov@gmail.com)
  * @date    01.01.2017 -- 18.10.2017
  */
+#include <algorithm>
 #include <iostream>
+#include <new>
 #include <zip.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "ooxml.hpp"
+#include "tools.hpp"
 
 namespace ooxml {
 
-void Ooxml::extractFile(const std::string &zipName, const std::string &fileName,
-                        pugi::xml_document &tree)
+/** Packages up to this size are prefetched completely, bigger ones (mostly media) on demand */
+constexpr size_t PREFETCH_WHOLE_LIMIT = 16 * 1024 * 1024;
+/** Zip record signatures and sizes */
+constexpr uint32_t LOCAL_HEADER_SIGNATURE   = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_CD_SIGNATURE      = 0x06054b50;
+constexpr size_t LOCAL_HEADER_SIZE   = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t END_OF_CD_SIZE      = 22;
+
+/**
+ * Namespaces of `mc:Choice` that hold the same text as the fallback or more.
+ * Missing ones (e.g. `w16se` symbols) keep their text in the fallback only
+ */
+constexpr tools::TableEntry<std::string_view, bool> UNDERSTOOD_NAMESPACES[] {
+    {"a14",  true},
+    {"a15",  true},
+    {"a16",  true},
+    {"cx",   true},
+    {"cx1",  true},
+    {"cx2",  true},
+    {"cx4",  true},
+    {"m",    true},
+    {"p14",  true},
+    {"p15",  true},
+    {"v",    true},
+    {"w14",  true},
+    {"w15",  true},
+    {"wp14", true},
+    {"wpc",  true},
+    {"wpg",  true},
+    {"wpi",  true},
+    {"wps",  true}
+};
+static_assert(tools::isSortedTable(UNDERSTOOD_NAMESPACES), "UNDERSTOOD_NAMESPACES must be sorted");
+
+/** Read little-endian integer from zip record */
+template<typename T>
+static T readLe(const char *data)
 {
-    size_t size;
-    auto content = getFileContent(zipName, fileName, size);
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8 * i);
+    return value;
+}
 
-    //tree.load_string(static_cast<const char*>(content));
-    if (content != nullptr) {
-        tree.load_buffer(content, size);
-        free(content);
+/** ASCII case folding, same rules as `ZIP_FL_NOCASE` */
+static std::string foldCase(std::string_view name)
+{
+    std::string result(name);
+    for (auto &c : result) {
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
     }
+    return result;
 }
 
-void Ooxml::extractFile(const std::string &zipName, const std::string &fileName,
-                        std::string &buffer)
+// Archive
+Archive::Archive(const std::string &zipName)
+    : m_zipName(zipName)
 {
-    size_t size;
-    auto content = getFileContent(zipName, fileName, size);
+    if (!openMapped(zipName)) {
+        int errcode = 0;
+        m_archive = zip_open(zipName.c_str(), ZIP_CHECKCONS | ZIP_RDONLY, &errcode);
+    }
+    readEntryIndex();
+}
+
+Archive::Archive(const std::string &zipName, std::string_view content)
+    : m_zipName(zipName)
+{
+    if (!content.empty() && openBuffer(content.data(), content.size()))
+        readEntryIndex();
+}
+
+Archive::~Archive()
+{
+    if (m_archive)
+        zip_discard(m_archive);
+    if (m_isMapped)
+        munmap(const_cast<char *>(m_map), m_mapSize);
+}
+
+bool Archive::exists(const std::string &fileName) const
+{
+    return locate(fileName) != -1;
+}
+
+bool Archive::extractFile(const std::string &fileName, pugi::xml_document &tree) const
+{
+    std::string_view data;
+    if (view(fileName, data)) {
+        tree.load_buffer(data.data(), data.size());
+        return true;
+    }
+
+    // Inflate straight into memory owned by the document, pugixml parses it in place
+    uint64_t size = 0;
+    auto *zipFile = openEntry(m_archive, fileName, size);
+    if (!zipFile)
+        return false;
+
+    void *content = pugi::get_memory_allocation_function()(size > 0 ? size : 1);
+    if (!content) {
+        zip_fclose(zipFile);
+        throw std::bad_alloc();
+    }
+    bool ok = zip_fread(zipFile, content, size) != -1;
+    zip_fclose(zipFile);
 
-    if (content != nullptr) {
-        buffer = std::string(static_cast<const char *>(content), size);
-        free(content);
+    if (!ok) {
+        pugi::get_memory_deallocation_function()(content);
+        return false;
     }
+    tree.load_buffer_inplace_own(content, size);
+    return true;
 }
 
-bool Ooxml::exists(const std::string &zipName, const std::string &fileName)
+bool Archive::extractFile(const std::string &fileName, std::string &buffer, uint64_t sizeLimit) const
 {
-    int errcode = 0;
-    auto *archive = zip_open(zipName.c_str(), ZIP_CHECKCONS, &errcode);
-    if (!archive)
+    return readEntry(m_archive, fileName, buffer, sizeLimit);
+}
+
+bool Archive::view(const std::string &fileName, std::string_view &data) const
+{
+    if (!m_map)
         return false;
 
-    auto index = zip_name_locate(archive, fileName.c_str(), ZIP_FL_NOCASE);
-    zip_close(archive);
+    int64_t index = locate(fileName);
+    if (index == -1)
+        return false;
 
-    return index != -1;
+    zip_stat_t statBuffer;
+    if (zip_stat_index(m_archive, index, 0, &statBuffer) != 0 ||
+        statBuffer.comp_method != ZIP_CM_STORE || statBuffer.encryption_method != 0 ||
+        statBuffer.comp_size != statBuffer.size)
+        return false;
+
+    const char *content = entryData(m_archive, index, statBuffer.size);
+    if (!content)
+        return false;
+
+    data = std::string_view(content, statBuffer.size);
+    return true;
+}
+
+std::vector<std::string> Archive::entries(std::string_view prefix) const
+{
+    std::vector<std::string> result;
+    const std::string foldedPrefix = foldCase(prefix);
+    for (const auto &entry : m_entryIndex) {
+        if (entry.first.compare(0, foldedPrefix.size(), foldedPrefix) == 0) {
+            if (const char *name = zip_get_name(m_archive, entry.second, 0))
+                result.emplace_back(name);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
 }
 
 // private:
-void *Ooxml::getFileContent(const std::string &zipName, const std::string &fileName, size_t &size)
+zip *Archive::openReader() const
 {
-    size = 0;
-    int errcode = 0;
-    auto *archive = zip_open(zipName.c_str(), ZIP_CHECKCONS, &errcode);
-    if (!archive)
+    if (!m_archive)
+        return nullptr;
+
+    zip *reader = nullptr;
+    if (m_map) {
+        // The directory was validated by the main handle, no ZIP_CHECKCONS
+        zip_error_t error;
+        zip_error_init(&error);
+        zip_source_t *source = zip_source_buffer_create(m_map, m_mapSize, 0, &error);
+        if (source) {
+            reader = zip_open_from_source(source, ZIP_RDONLY, &error);
+            if (!reader)
+                zip_source_free(source);
+        }
+        zip_error_fini(&error);
+    }
+    else {
+        int errcode = 0;
+        reader = zip_open(m_zipName.c_str(), ZIP_RDONLY, &errcode);
+    }
+    return reader;
+}
+
+bool Archive::readEntry(zip *handle, const std::string &fileName, std::string &buffer, uint64_t sizeLimit) const
+{
+    uint64_t size = 0;
+    auto *zipFile = openEntry(handle, fileName, size);
+    if (!zipFile)
+        return false;
+    if (size > sizeLimit) {
+        zip_fclose(zipFile);
+        return false;
+    }
+
+    buffer.resize(size);
+    bool ok = zip_fread(zipFile, &buffer[0], size) != -1;
+    zip_fclose(zipFile);
+
+    if (!ok)
+        buffer.clear();
+    return ok;
+}
+
+zip_file *Archive::openEntry(zip *handle, const std::string &fileName, uint64_t &size) const
+{
+    int64_t index = locate(fileName);
+    if (index == -1)
         return nullptr;
 
     zip_stat_t statBuffer;
-    if (zip_stat(archive, fileName.c_str(), ZIP_FL_NOCASE, &statBuffer) != 0) {
-        zip_close(archive);
+    if (zip_stat_index(handle, index, 0, &statBuffer) != 0)
         return nullptr;
+
+    // Bring the compressed data in before inflating it
+    if (m_isMapped && m_mapSize > PREFETCH_WHOLE_LIMIT) {
+        if (const char *data = entryData(handle, statBuffer.index, statBuffer.comp_size)) {
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const size_t begin = static_cast<size_t>(data - m_map) / pageSize * pageSize;
+            madvise(const_cast<char *>(m_map) + begin,
+                    static_cast<size_t>(data - m_map) + statBuffer.comp_size - begin, MADV_WILLNEED);
+        }
     }
 
-    auto *zipFile = zip_fopen(archive, fileName.c_str(), ZIP_FL_NOCASE);
-    if (!zipFile) {
-        zip_close(archive);
-        return nullptr;
+    size = statBuffer.size;
+    return zip_fopen_index(handle, statBuffer.index, 0);
+}
+
+int64_t Archive::locate(std::string_view fileName) const
+{
+    auto it = m_entryIndex.find(foldCase(fileName));
+    return it != m_entryIndex.end() ? static_cast<int64_t>(it->second) : -1;
+}
+
+bool Archive::openMapped(const std::string &zipName)
+{
+    int fd = open(zipName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return false;
+
+    struct stat statBuffer;
+    if (fstat(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode) || statBuffer.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(statBuffer.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    // Small packages are read almost completely; in big ones only the central
+    // directory is needed up front, entries are prefetched when they are read
+    if (size <= PREFETCH_WHOLE_LIMIT) {
+        madvise(map, size, MADV_WILLNEED);
+    }
+    else {
+        madvise(map, size, MADV_RANDOM);
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t tail = (size - std::min(size, static_cast<size_t>(1024 * 1024))) / pageSize * pageSize;
+        madvise(static_cast<char *>(map) + tail, size - tail, MADV_WILLNEED);
+    }
+
+    if (!openBuffer(static_cast<const char *>(map), size)) {
+        munmap(map, size);
+        return false;
+    }
+
+    m_isMapped = true;
+    return true;
+}
+
+bool Archive::openBuffer(const char *data, size_t size)
+{
+    zip_error_t error;
+    zip_error_init(&error);
+    zip_source_t *source = zip_source_buffer_create(data, size, 0, &error);
+    if (source) {
+        m_archive = zip_open_from_source(source, ZIP_CHECKCONS | ZIP_RDONLY, &error);
+        if (!m_archive)
+            zip_source_free(source);
+    }
+    zip_error_fini(&error);
+
+    if (!m_archive)
+        return false;
+
+    m_map = data;
+    m_mapSize = size;
+    readLocalHeaderOffsets();
+    return true;
+}
+
+void Archive::readEntryIndex()
+{
+    if (!m_archive)
+        return;
+
+    zip_int64_t count = zip_get_num_entries(m_archive, 0);
+    m_entryIndex.reserve(count > 0 ? static_cast<size_t>(count) : 0);
+    for (zip_int64_t i = 0; i < count; ++i) {
+        const char *name = zip_get_name(m_archive, i, 0);
+        // First entry wins on case-only duplicates, as with ZIP_FL_NOCASE
+        if (name)
+            m_entryIndex.emplace(foldCase(name), i);
+    }
+}
+
+void Archive::readLocalHeaderOffsets()
+{
+    if (m_mapSize < END_OF_CD_SIZE)
+        return;
+
+    // End of central directory record is followed by a comment of up to 64 KiB
+    const size_t searchEnd = m_mapSize - std::min(m_mapSize, END_OF_CD_SIZE + 0xFFFF);
+    size_t eocd = m_mapSize - END_OF_CD_SIZE;
+    while (readLe<uint32_t>(m_map + eocd) != END_OF_CD_SIGNATURE) {
+        if (eocd == searchEnd)
+            return;
+        --eocd;
     }
 
-    char *content = static_cast<char *>(malloc(statBuffer.size));
-    memset(content, 0, statBuffer.size);
-    if (zip_fread(zipFile, content, statBuffer.size) == -1) {
-        zip_close(archive);
-        free(content);
+    const uint16_t count = readLe<uint16_t>(m_map + eocd + 10);
+    const uint32_t cdOffset = readLe<uint32_t>(m_map + eocd + 16);
+    // ZIP64 packages keep libzip reading, they only lose in-place views
+    if (count == 0xFFFF || cdOffset == 0xFFFFFFFF)
+        return;
+
+    std::vector<uint64_t> offsets;
+    offsets.reserve(count);
+    size_t pos = cdOffset;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (pos + CENTRAL_HEADER_SIZE > eocd ||
+            readLe<uint32_t>(m_map + pos) != CENTRAL_HEADER_SIGNATURE)
+            return;
+
+        offsets.push_back(readLe<uint32_t>(m_map + pos + 42));
+        pos += CENTRAL_HEADER_SIZE + readLe<uint16_t>(m_map + pos + 28) +
+               readLe<uint16_t>(m_map + pos + 30) + readLe<uint16_t>(m_map + pos + 32);
+    }
+    m_localHeaderOffsets = std::move(offsets);
+}
+
+const char *Archive::entryData(zip *handle, uint64_t index, uint64_t compSize) const
+{
+    if (index >= m_localHeaderOffsets.size())
+        return nullptr;
+
+    const uint64_t offset = m_localHeaderOffsets[index];
+    if (offset + LOCAL_HEADER_SIZE > m_mapSize)
+        return nullptr;
+
+    const char *header = m_map + offset;
+    if (readLe<uint32_t>(header) != LOCAL_HEADER_SIGNATURE)
         return nullptr;
+
+    // Make sure the header belongs to the entry libzip knows under this index.
+    // Workers have their own handle, libzip handles can't be shared between threads
+    const uint16_t nameLength = readLe<uint16_t>(header + 26);
+    const uint16_t extraLength = readLe<uint16_t>(header + 28);
+    const char *name = zip_get_name(handle, index, ZIP_FL_ENC_RAW);
+    if (!name || strlen(name) != nameLength || memcmp(name, header + LOCAL_HEADER_SIZE, nameLength) != 0)
+        return nullptr;
+
+    const uint64_t dataOffset = offset + LOCAL_HEADER_SIZE + nameLength + extraLength;
+    if (dataOffset + compSize > m_mapSize)
+        return nullptr;
+    return m_map + dataOffset;
+}
+
+
+// PartStream
+PartStream::PartStream(const Archive *archive, const std::string &fileName)
+{
+    if (!archive)
+        return;
+    if (archive->view(fileName, m_view)) {
+        m_isView = true;
+        return;
     }
 
-    size = statBuffer.size;
-    zip_fclose(zipFile);
-    zip_close(archive);
+    uint64_t size = 0;
+    m_file = archive->openEntry(archive->m_archive, fileName, size);
+}
+
+PartStream::~PartStream()
+{
+    if (m_file)
+        zip_fclose(m_file);
+}
+
+bool PartStream::view(std::string_view &data) const
+{
+    if (!m_isView)
+        return false;
+
+    data = m_view;
+    return true;
+}
+
+size_t PartStream::read(char *buffer, size_t size)
+{
+    if (m_isView) {
+        size_t count = std::min(size, m_view.size() - m_offset);
+        memcpy(buffer, m_view.data() + m_offset, count);
+        m_offset += count;
+        return count;
+    }
+    if (!m_file || m_failed)
+        return 0;
+
+    zip_int64_t count = zip_fread(m_file, buffer, size);
+    if (count < 0) {
+        m_failed = true;
+        return 0;
+    }
+    return static_cast<size_t>(count);
+}
+
+
+// Ooxml
+Ooxml::Ooxml(std::shared_ptr<const Archive> archive)
+    : m_archive(std::move(archive)) {}
+
+void Ooxml::openArchive(const std::string &zipName, std::string_view content)
+{
+    if (content.empty())
+        m_archive = std::make_shared<const Archive>(zipName);
+    else
+        m_archive = std::make_shared<const Archive>(zipName, content);
+}
+
+bool Ooxml::extractFile(const std::string &fileName, pugi::xml_document &tree) const
+{
+    return m_archive && m_archive->extractFile(fileName, tree);
+}
+
+bool Ooxml::extractFile(const std::string &fileName, std::string &buffer) const
+{
+    return m_archive && m_archive->extractFile(fileName, buffer);
+}
+
+bool Ooxml::extractFile(const std::string &fileName, std::string_view &data, std::string &storage) const
+{
+    if (!m_archive)
+        return false;
+    if (m_archive->view(fileName, data))
+        return true;
+    if (!m_archive->extractFile(fileName, storage))
+        return false;
+
+    data = storage;
+    return true;
+}
+
+bool Ooxml::exists(const std::string &fileName) const
+{
+    return m_archive && m_archive->exists(fileName);
+}
+
+std::vector<std::string> Ooxml::entries(std::string_view prefix) const
+{
+    return m_archive ? m_archive->entries(prefix) : std::vector<std::string>();
+}
+
+// Markup compatibility
+bool isUnderstoodChoice(std::string_view requirement)
+{
+    bool hasNamespace = false;
+    size_t begin = 0;
+    while (begin < requirement.size()) {
+        size_t end = requirement.find(' ', begin);
+        if (end == std::string_view::npos)
+            end = requirement.size();
+        if (end > begin) {
+            if (!tools::findInTable(UNDERSTOOD_NAMESPACES, requirement.substr(begin, end - begin)))
+                return false;
+            hasNamespace = true;
+        }
+        begin = end + 1;
+    }
+    return hasNamespace;
+}
 
-    return content;
+pugi::xml_node selectAlternateContent(const pugi::xml_node &node)
+{
+    for (const auto &choice : node.children("mc:Choice")) {
+        if (isUnderstoodChoice(choice.attribute("Requires").value()))
+            return choice;
+    }
+    return node.child("mc:Fallback");
+}
+
+// Relationships
+std::string relationshipsPart(std::string_view partName)
+{
+    const size_t folder = partName.rfind('/') + 1;
+    std::string name(partName.substr(0, folder));
+    name += "_rels/";
+    name += partName.substr(folder);
+    name += ".rels";
+    return name;
+}
+
+std::string resolveTarget(std::string_view sourcePart, std::string_view target)
+{
+    std::string name;
+    if (!target.empty() && target.front() == '/')
+        target.remove_prefix(1);
+    else
+        name = sourcePart.substr(0, sourcePart.rfind('/') + 1);
+
+    while (!target.empty()) {
+        const size_t end = std::min(target.find('/'), target.size());
+        const std::string_view segment = target.substr(0, end);
+        target.remove_prefix(std::min(end + 1, target.size()));
+        if (segment == "..") {
+            // `name` is empty or ends with `/`
+            if (!name.empty())
+                name.pop_back();
+            const size_t parent = name.rfind('/');
+            name.erase(parent == std::string::npos ? 0 : parent + 1);
+        }
+        else if (!segment.empty() && segment != ".") {
+            name += segment;
+            if (!target.empty())
+                name += '/';
+        }
+    }
+    return name;
 }
 
 }   // End namespace
@@ -3,14 +3,22 @@
  * @package ooxml
  * @file    ooxml.hpp
  * @author  dmryutov (dmryutov@gmail.com)
- * @version 1.1
+ * @version 1.2
  * @date    01.01.2017 -- 18.10.2017
  */
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <pugixml.hpp>
 
+struct zip;
+struct zip_file;
+
 /**
  * @namespace ooxml
  * @brief
@@ -18,73 +26,494 @@
  */
 namespace ooxml {
 
+class PartStream;
+class PartPrefetcher;
+class PartPool;
+
+/**
+ * @class Archive
+ * @brief
+ *     Opened zip package, shared by all part reads of one conversion
+ * @details
+ *     The central directory is read and validated once in constructor, and
+ *     entry names are indexed by their ASCII case-folded form, so part lookup
+ *     doesn't scan the whole directory like `ZIP_FL_NOCASE` does.
+ *     The package is memory mapped and libzip reads from the mapping; stored
+ *     (uncompressed) entries can be viewed in place without copying.
+ *     Not thread safe: every conversion uses its own archive. Executor helpers
+ *     running for PartPrefetcher and PartPool read through their own libzip
+ *     handles.
+ */
+class Archive
+{
+public:
+    /**
+	 * @param[in] zipName
+	 *     Archive path. If archive can't be opened, all reads return nothing
+	 * @since 1.2
+	 */
+    explicit Archive(const std::string &zipName);
+
+    /**
+	 * @brief
+	 *     Open package held in memory (e.g. embedded document)
+	 * @param[in] zipName
+	 *     Package name, for messages only
+	 * @param[in] content
+	 *     Package content, must outlive the archive
+	 * @since 1.2
+	 */
+    Archive(const std::string &zipName, std::string_view content);
+
+    /** Destructor */
+    ~Archive();
+
+    Archive(const Archive &) = delete;
+    Archive &operator=(const Archive &) = delete;
+
+    /**
+	 * @brief
+	 *     Check if archive was opened successfully
+	 * @since 1.2
+	 */
+    bool isOpen() const { return m_archive != nullptr; }
+
+    /**
+	 * @brief
+	 *     Check if archive contains file (case insensitive)
+	 * @param[in] fileName
+	 *     File name
+	 * @since 1.2
+	 */
+    bool exists(const std::string &fileName) const;
+
+    /**
+	 * @brief
+	 *     Extract file and put its content into XML-tree
+	 * @param[in] fileName
+	 *     Extracting file name (case insensitive)
+	 * @param[out] tree
+	 *     XML-tree, where you need to put the data from extracted file
+	 * @return
+	 *     True if file was found and read
+	 * @since 1.2
+	 */
+    bool extractFile(const std::string &fileName, pugi::xml_document &tree) const;
+
+    /**
+	 * @brief
+	 *     Extract file and put its content into string buffer
+	 * @param[in] fileName
+	 *     Extracting file name (case insensitive)
+	 * @param[out] buffer
+	 *     String buffer, replaced with the file content
+	 * @param[in] sizeLimit
+	 *     Files with bigger uncompressed size aren't read
+	 * @return
+	 *     True if file was found and read
+	 * @since 1.2
+	 */
+    bool extractFile(const std::string &fileName, std::string &buffer, uint64_t sizeLimit = UINT64_MAX) const;
+
+    /**
+	 * @brief
+	 *     Get file content without copying it
+	 * @details
+	 *     Only possible for stored (uncompressed, unencrypted) entries of a
+	 *     mapped package. The view is valid while the archive exists.
+	 * @param[in] fileName
+	 *     File name (case insensitive)
+	 * @param[out] data
+	 *     File content inside the mapped package
+	 * @return
+	 *     False if file doesn't exist or must be inflated
+	 * @since 1.2
+	 */
+    bool view(const std::string &fileName, std::string_view &data) const;
+
+    /**
+	 * @brief
+	 *     List entries whose name starts with prefix (case insensitive)
+	 * @param[in] prefix
+	 *     Name prefix, e.g. `ppt/slides/`
+	 * @return
+	 *     Entry names as stored in archive, sorted
+	 * @since 1.2
+	 */
+    std::vector<std::string> entries(std::string_view prefix = {}) const;
+
+private:
+    /**
+	 * @brief
+	 *     Find entry index by name (case insensitive)
+	 * @param[in] fileName
+	 *     File name
+	 * @return
+	 *     Entry index or -1 if not found
+	 * @since 1.2
+	 */
+    int64_t locate(std::string_view fileName) const;
+
+    /**
+	 * @brief
+	 *     Open additional libzip handle on the same package
+	 * @details
+	 *     Used by other threads; only the read-only entry index of this
+	 *     object is shared. Close with `zip_discard()`.
+	 * @return
+	 *     Handle or nullptr
+	 * @since 1.2
+	 */
+    zip *openReader() const;
+
+    /**
+	 * @brief
+	 *     Inflate entry into string buffer
+	 * @param[in] handle
+	 *     libzip handle (`m_archive` or one from `openReader()`)
+	 * @param[in] fileName
+	 *     File name (case insensitive)
+	 * @param[out] buffer
+	 *     Entry content
+	 * @param[in] sizeLimit
+	 *     Entries with bigger uncompressed size aren't read
+	 * @return
+	 *     True if file was found and read
+	 * @since 1.2
+	 */
+    bool readEntry(zip *handle, const std::string &fileName, std::string &buffer,
+                   uint64_t sizeLimit = UINT64_MAX) const;
+
+    /**
+	 * @brief
+	 *     Open entry for inflating, prefetching its compressed data
+	 * @param[in] handle
+	 *     libzip handle (`m_archive` or one from `openReader()`)
+	 * @param[in] fileName
+	 *     File name (case insensitive)
+	 * @param[out] size
+	 *     Uncompressed entry size
+	 * @return
+	 *     Entry handler (close with `zip_fclose()`) or nullptr
+	 * @since 1.2
+	 */
+    zip_file *openEntry(zip *handle, const std::string &fileName, uint64_t &size) const;
+
+    /**
+	 * @brief
+	 *     Map package into memory and open archive from the mapping
+	 * @param[in] zipName
+	 *     Archive path
+	 * @return
+	 *     False if file can't be mapped
+	 * @since 1.2
+	 */
+    bool openMapped(const std::string &zipName);
+
+    /**
+	 * @brief
+	 *     Open archive from package in memory
+	 * @param[in] data
+	 *     Package content (mapping or caller buffer)
+	 * @param[in] size
+	 *     Package size
+	 * @return
+	 *     False if package is broken
+	 * @since 1.2
+	 */
+    bool openBuffer(const char *data, size_t size);
+
+    /**
+	 * @brief
+	 *     Index entry names of opened archive
+	 * @since 1.2
+	 */
+    void readEntryIndex();
+
+    /**
+	 * @brief
+	 *     Read local header offsets from the central directory of the mapping
+	 * @since 1.2
+	 */
+    void readLocalHeaderOffsets();
+
+    /**
+	 * @brief
+	 *     Get raw entry data inside the mapping
+	 * @param[in] handle
+	 *     Archive handle of the calling thread, used to check the local header
+	 * @param[in] index
+	 *     Entry index
+	 * @param[in] compSize
+	 *     Compressed entry size
+	 * @return
+	 *     Entry data, or nullptr if entry can't be located
+	 * @since 1.2
+	 */
+    const char *entryData(zip *handle, uint64_t index, uint64_t compSize) const;
+
+    friend class PartStream;
+    friend class PartPrefetcher;
+    friend class PartPool;
+
+    /** Package path */
+    std::string m_zipName;
+    /** Archive handler */
+    zip *m_archive = nullptr;
+    /** Mapped or in-memory package (nullptr if archive was opened through stdio) */
+    const char *m_map = nullptr;
+    /** Mapped package size */
+    size_t m_mapSize = 0;
+    /** True if `m_map` is a file mapping, false for caller memory */
+    bool m_isMapped = false;
+    /** Local header offset of each entry, in central directory order */
+    std::vector<uint64_t> m_localHeaderOffsets;
+    /** Case-folded entry name => entry index */
+    std::unordered_map<std::string, uint64_t> m_entryIndex;
+};
+
+
+/**
+ * @class PartStream
+ * @brief
+ *     Sequential reader of one archive entry
+ * @details
+ *     Compressed entries are inflated chunk by chunk into the caller's buffer,
+ *     so a part of any size can be processed in bounded memory. Stored entries
+ *     of a mapped package are exposed as a view instead.
+ */
+class PartStream
+{
+public:
+    /**
+	 * @param[in] archive
+	 *     Opened archive (may be nullptr)
+	 * @param[in] fileName
+	 *     Entry name (case insensitive)
+	 * @since 1.2
+	 */
+    PartStream(const Archive *archive, const std::string &fileName);
+
+    /** Destructor */
+    ~PartStream();
+
+    PartStream(const PartStream &) = delete;
+    PartStream &operator=(const PartStream &) = delete;
+
+    /**
+	 * @brief
+	 *     Check if entry was found and opened
+	 * @since 1.2
+	 */
+    bool isOpen() const { return m_file != nullptr || m_isView; }
+
+    /**
+	 * @brief
+	 *     Get whole content if entry is available without inflating
+	 * @param[out] data
+	 *     Entry content inside the mapped package
+	 * @since 1.2
+	 */
+    bool view(std::string_view &data) const;
+
+    /**
+	 * @brief
+	 *     Read next chunk of inflated content
+	 * @param[out] buffer
+	 *     Destination
+	 * @param[in] size
+	 *     Destination size
+	 * @return
+	 *     Number of bytes read, 0 at the end of entry or on error
+	 * @since 1.2
+	 */
+    size_t read(char *buffer, size_t size);
+
+    /**
+	 * @brief
+	 *     Check if entry data was corrupted
+	 * @since 1.2
+	 */
+    bool failed() const { return m_failed; }
+
+private:
+    /** Entry handler of compressed entry */
+    zip_file *m_file = nullptr;
+    /** Content of stored entry */
+    std::string_view m_view;
+    /** True if entry is read from m_view */
+    bool m_isView = false;
+    /** Read position in m_view */
+    size_t m_offset = 0;
+    /** Read error flag */
+    bool m_failed = false;
+};
+
+
 /**
  * @class Ooxml
  * @brief
  *     Wrapper for Office Open XML (OOXML)
+ * @details
+ *     Owns archive session of the parser: open it once with `openArchive()`,
+ *     then read any number of parts. Helper objects of the same conversion
+ *     share the session by constructing with `archive()`.
  */
 class Ooxml
 {
 public:
     Ooxml() = default;
 
+    /**
+	 * @param[in] archive
+	 *     Already opened archive session to share
+	 * @since 1.2
+	 */
+    explicit Ooxml(std::shared_ptr<const Archive> archive);
+
     /**
 	 * @brief
-	 *     Extract file from archive and put its content into XML-tree
+	 *     Open archive session, reused by all following reads
 	 * @param[in] zipName
 	 *     Archive path
+	 * @param[in] content
+	 *     Package content if it's already in memory (must outlive the session),
+	 *     empty to read `zipName`
+	 * @since 1.2
+	 */
+    void openArchive(const std::string &zipName, std::string_view content = {});
+
+    /**
+	 * @brief
+	 *     Get current archive session
+	 * @since 1.2
+	 */
+    const std::shared_ptr<const Archive> &archive() const { return m_archive; }
+
+    /**
+	 * @brief
+	 *     Extract file from archive and put its content into XML-tree
 	 * @param[in] fileName
 	 *     Extracting file name
 	 * @param[out] tree
 	 *     XML-tree, where you need to put the data from extracted file
-	 * @throw std::invalid_argument
-	 *     Invalid zip file
-	 * @throw std::logic_error
-	 *     File extracting error
+	 * @return
+	 *     True if file was found and read
 	 * @since 1.0
 	 */
-    static void extractFile(const std::string &zipName, const std::string &fileName, pugi::xml_document &tree);
+    bool extractFile(const std::string &fileName, pugi::xml_document &tree) const;
 
     /**
 	 * @brief
 	 *     Extract file from archive and put its content into string buffer
-	 * @param[in] zipName
-	 *     Archive path
 	 * @param[in] fileName
 	 *     Extracting file name
 	 * @param[out] buffer
 	 *     String buffer, where you need to put the data from extracted file
-	 * @throw std::invalid_argument
-	 *     Invalid zip file
-	 * @throw std::logic_error
-	 *     File extracting error
+	 * @return
+	 *     True if file was found and read
 	 * @since 1.1
 	 */
-    static void extractFile(const std::string &zipName, const std::string &fileName, std::string &buffer);
-
-    static bool exists(const std::string &zipName, const std::string &fileName);
+    bool extractFile(const std::string &fileName, std::string &buffer) const;
 
-private:
     /**
 	 * @brief
-	 *     Get zipped file content
-	 * @param[in] zipName
-	 *     Archive path
+	 *     Get file content, without copying it if possible
+	 * @details
+	 *     Stored entries are viewed in the mapped package, compressed ones are
+	 *     inflated into `storage` and viewed there.
 	 * @param[in] fileName
 	 *     Extracting file name
-	 * @param[in] zipArchive
-	 *     Archive handler
-	 * @param[out] size
-	 *     Extracted file size
-	 * @return
+	 * @param[out] data
 	 *     File content
-	 * @throw std::invalid_argument
-	 *     Invalid zip file
-	 * @throw std::logic_error
-	 *     File extracting error
+	 * @param[out] storage
+	 *     Buffer for inflated content
+	 * @return
+	 *     True if file was found and read
+	 * @since 1.2
+	 */
+    bool extractFile(const std::string &fileName, std::string_view &data, std::string &storage) const;
+
+    /**
+	 * @brief
+	 *     Check if archive contains file
+	 * @param[in] fileName
+	 *     File name
 	 * @since 1.1
 	 */
-    static void *getFileContent(const std::string &zipName, const std::string &fileName, size_t &size);
+    bool exists(const std::string &fileName) const;
+
+    /**
+	 * @brief
+	 *     List archive entries whose name starts with prefix
+	 * @param[in] prefix
+	 *     Name prefix (case insensitive)
+	 * @since 1.2
+	 */
+    std::vector<std::string> entries(std::string_view prefix = {}) const;
+
+private:
+    /** Archive session (empty until `openArchive()`) */
+    std::shared_ptr<const Archive> m_archive;
 };
 
+/// @name Markup compatibility
+/// @{
+/**
+ * @brief
+ *     Check if `mc:Choice` can be read instead of its fallback
+ * @details
+ *     Office writes shapes, text boxes, equations and some symbols twice: as
+ *     `mc:Choice` with a newer namespace and as `mc:Fallback` for older readers.
+ *     Namespaces are recognized by their usual prefixes.
+ * @param[in] requirement
+ *     `Requires` attribute (space separated namespace prefixes)
+ * @return
+ *     True if all required namespaces are understood
+ * @since 1.2
+ */
+bool isUnderstoodChoice(std::string_view requirement);
+
+/**
+ * @brief
+ *     Select branch of `mc:AlternateContent` to read
+ * @param[in] node
+ *     `mc:AlternateContent` node
+ * @return
+ *     First understood `mc:Choice`, otherwise `mc:Fallback` (empty if missing)
+ * @since 1.2
+ */
+pugi::xml_node selectAlternateContent(const pugi::xml_node &node);
+/// @}
+
+/// @name Relationships
+/// @{
+/**
+ * @brief
+ *     Get name of relationships part of package part
+ * @param[in] partName
+ *     Part name, e.g. `ppt/slides/slide1.xml`
+ * @return
+ *     Relationships part name, e.g. `ppt/slides/_rels/slide1.xml.rels`
+ * @since 1.2
+ */
+std::string relationshipsPart(std::string_view partName);
+
+/**
+ * @brief
+ *     Resolve relationship target to part name
+ * @details
+ *     Targets are relative to the folder of the source part (`.` and `..`
+ *     segments are allowed), or absolute if they start with `/`
+ * @param[in] sourcePart
+ *     Name of part the relationships belong to, e.g. `ppt/presentation.xml`
+ * @param[in] target
+ *     `Target` attribute, e.g. `slides/slide1.xml`
+ * @return
+ *     Part name, e.g. `ppt/slides/slide1.xml`
+ * @since 1.2
+ */
+std::string resolveTarget(std::string_view sourcePart, std::string_view target);
+/// @}
+
 }   // End namespace
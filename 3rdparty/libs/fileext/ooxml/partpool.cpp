@@ -0,0 +1,63 @@
+/**
+ * @brief   Parallel processing of independent archive parts
+ * @package ooxml
+ * @file    partpool.cpp
+ * @date    19.10.2026
+ */
+#include <atomic>
+#include <new>
+#include <zip.h>
+
+#include "partpool.hpp"
+#include "fileext/executor.hpp"
+
+namespace ooxml {
+
+// Reader public:
+bool PartPool::Reader::read(const std::string &fileName, std::string &content) const
+{
+    try {
+        return m_handle ? m_archive.readEntry(m_handle, fileName, content)
+                        : m_archive.extractFile(fileName, content);
+    }
+    catch (const std::bad_alloc &) {
+        content = std::string();
+        return false;
+    }
+}
+
+
+// PartPool public:
+PartPool::PartPool(std::shared_ptr<const Archive> archive)
+    : m_archive(std::move(archive)) {}
+
+void PartPool::run(const std::vector<std::string> &parts, const Handler &handler) const
+{
+    if (!m_archive || !m_archive->isOpen() || parts.empty())
+        return;
+
+    std::atomic<size_t> next { 0 };
+    std::atomic<bool> stop { false };
+    // `reader` is nullptr for the calling thread
+    auto work = [this, &parts, &handler, &next, &stop](zip *reader) {
+        const Reader partReader(*m_archive, reader);
+        std::string content;
+        for (size_t i = next++; i < parts.size() && !stop; i = next++) {
+            if (!partReader.read(parts[i], content))
+                content.clear();
+            if (!handler(i, content, partReader))
+                stop = true;
+        }
+    };
+
+    // Helpers come from the executor shared with every other conversion
+    fileext::Executor::shared().run(parts.size() - 1, [this, &work] {
+        zip *reader = m_archive->openReader();
+        if (reader) {
+            work(reader);
+            zip_discard(reader);
+        }
+    }, [&work] { work(nullptr); });
+}
+
+}   // End namespace
@@ -0,0 +1,106 @@
+/**
+ * @brief   Parallel processing of independent archive parts
+ * @package ooxml
+ * @file    partpool.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ooxml.hpp"
+
+namespace ooxml {
+
+/**
+ * @class PartPool
+ * @brief
+ *     Inflates and processes parts on a pool of worker threads
+ * @details
+ *     Unlike PartPrefetcher, which only inflates ahead of a single consumer,
+ *     the handler itself runs on the workers too. Meant for parts that don't
+ *     depend on each other (slides): every part gets its index, so results
+ *     can be kept per part and merged in order afterwards. Parts the handler
+ *     finds on its own (e.g. through relationships) are read with the
+ *     Reader of its thread.
+ *
+ *     Parts are taken in list order. The calling thread works as well, through
+ *     the main libzip handle; idle helpers of `fileext::Executor::shared()`
+ *     join in, each with a libzip handle of its own. If none is idle (or on
+ *     single core systems) everything runs on the caller.
+ */
+class PartPool
+{
+public:
+    /**
+     * @class Reader
+     * @brief
+     *     Reads further parts on the libzip handle of a pool thread
+     */
+    class Reader
+    {
+    public:
+        /**
+         * @brief
+         *     Extract part into string buffer
+         * @param[in] fileName
+         *     Part name (case insensitive)
+         * @param[out] content
+         *     Part content
+         * @return
+         *     True if part was found and read
+         * @since 1.2
+         */
+        bool read(const std::string &fileName, std::string &content) const;
+
+    private:
+        friend class PartPool;
+
+        Reader(const Archive &archive, zip *handle)
+            : m_archive(archive), m_handle(handle) {}
+
+        /** Archive session */
+        const Archive &m_archive;
+        /** Handle of the thread, nullptr for the main handle */
+        zip *m_handle;
+    };
+
+    /**
+     * @brief
+     *     Part handler, called concurrently from several threads
+     * @details
+     *     Receives part index in the list, part content (empty for missing
+     *     part) and reader of the calling thread. Returning false stops taking
+     *     further parts, the ones already being processed are finished.
+     */
+    using Handler = std::function<bool(size_t index, std::string_view content, const Reader &reader)>;
+
+    /**
+     * @param[in] archive
+     *     Opened archive (may be nullptr)
+     * @since 1.2
+     */
+    explicit PartPool(std::shared_ptr<const Archive> archive);
+
+    /**
+     * @brief
+     *     Process all parts, returns when every taken part is done
+     * @param[in] parts
+     *     Part names
+     * @param[in] handler
+     *     Part handler
+     * @since 1.2
+     */
+    void run(const std::vector<std::string> &parts, const Handler &handler) const;
+
+private:
+    /** Archive session */
+    std::shared_ptr<const Archive> m_archive;
+};
+
+}   // End namespace
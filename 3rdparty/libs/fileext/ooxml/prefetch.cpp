@@ -0,0 +1,88 @@
+/**
+ * @brief   Parallel inflate of archive parts ahead of the parser
+ * @package ooxml
+ * @file    prefetch.cpp
+ * @date    19.10.2026
+ */
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <zip.h>
+
+#include "prefetch.hpp"
+#include "fileext/executor.hpp"
+
+namespace ooxml {
+
+/** Number of parts inflated at once, bounds the memory held ahead of the parser */
+constexpr size_t PREFETCH_WINDOW = 4;
+/** Bigger parts are streamed by the parser instead */
+constexpr uint64_t PREFETCH_PART_LIMIT = 32 * 1024 * 1024;
+
+PartPrefetcher::PartPrefetcher(std::shared_ptr<const Archive> archive, std::vector<std::string> parts)
+    : m_archive(std::move(archive))
+{
+    m_parts.resize(parts.size());
+    for (size_t i = 0; i < parts.size(); ++i)
+        m_parts[i].name = std::move(parts[i]);
+}
+
+bool PartPrefetcher::take(const std::string &fileName, std::string &content)
+{
+    auto part = std::find_if(m_parts.begin(), m_parts.end(), [&fileName](const Part &item) {
+        return item.state != State::Taken && item.name == fileName;
+    });
+    if (part == m_parts.end())
+        return false;
+
+    if (part->state == State::Queued)
+        fetch(static_cast<size_t>(part - m_parts.begin()));
+    const bool ready = part->state == State::Ready;
+    if (ready)
+        content = std::move(part->content);
+    part->content = std::string();
+    part->state = State::Taken;
+    return ready;
+}
+
+// private:
+void PartPrefetcher::fetch(size_t first)
+{
+    // Without helpers inflating ahead only costs memory, the caller streams
+    if (!m_archive || !m_archive->isOpen() || m_parts.size() < 2 || fileext::Executor::shared().size() == 0)
+        return;
+
+    std::vector<Part *> window;
+    for (size_t i = first; i < m_parts.size() && window.size() < PREFETCH_WINDOW; ++i) {
+        if (m_parts[i].state == State::Queued)
+            window.push_back(&m_parts[i]);
+    }
+
+    std::atomic<size_t> next { 0 };
+    // `reader` is nullptr for the calling thread
+    auto work = [this, &window, &next](zip *reader) {
+        for (size_t i = next++; i < window.size(); i = next++) {
+            Part &part = *window[i];
+            bool ok = false;
+            try {
+                ok = reader ? m_archive->readEntry(reader, part.name, part.content, PREFETCH_PART_LIMIT)
+                            : m_archive->extractFile(part.name, part.content, PREFETCH_PART_LIMIT);
+            }
+            catch (const std::bad_alloc &) {
+                part.content = std::string();
+            }
+            part.state = ok ? State::Ready : State::Failed;
+        }
+    };
+
+    // Each part is written by one thread only, run() returns after all of them
+    fileext::Executor::shared().run(window.size() - 1, [this, &work] {
+        zip *reader = m_archive->openReader();
+        if (reader) {
+            work(reader);
+            zip_discard(reader);
+        }
+    }, [&work] { work(nullptr); });
+}
+
+}   // End namespace
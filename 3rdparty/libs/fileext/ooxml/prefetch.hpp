@@ -0,0 +1,90 @@
+/**
+ * @brief   Parallel inflate of archive parts ahead of the parser
+ * @package ooxml
+ * @file    prefetch.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ooxml.hpp"
+
+namespace ooxml {
+
+/**
+ * @class PartPrefetcher
+ * @brief
+ *     Inflates the next parts a parser will need in parallel
+ * @details
+ *     Slides, worksheets and similar parts are independent deflate streams.
+ *     Given the ordered part list of a document (from rels, `workbook.xml`,
+ *     `presentation.xml`), taking a part that isn't inflated yet inflates it
+ *     together with the next `PREFETCH_WINDOW - 1` listed parts: the calling
+ *     thread works through the main libzip handle, idle helpers of
+ *     `fileext::Executor::shared()` join in with libzip handles of their own.
+ *
+ *     Parts bigger than `PREFETCH_PART_LIMIT` are left to the caller, so it
+ *     can stream them in bounded memory. Without helper threads (single core
+ *     systems) nothing is prefetched.
+ */
+class PartPrefetcher
+{
+public:
+    /**
+     * @param[in] archive
+     *     Opened archive (may be nullptr)
+     * @param[in] parts
+     *     Part names in the order they will be taken
+     * @since 1.2
+     */
+    PartPrefetcher(std::shared_ptr<const Archive> archive, std::vector<std::string> parts);
+
+    PartPrefetcher(const PartPrefetcher &) = delete;
+    PartPrefetcher &operator=(const PartPrefetcher &) = delete;
+
+    /**
+     * @brief
+     *     Take inflated part, inflating the next window first if needed
+     * @param[in] fileName
+     *     Part name, as given in the list
+     * @param[out] content
+     *     Part content
+     * @return
+     *     False if part wasn't prefetched (not in list, too big, missing or
+     *     no helpers): caller must read it from the archive itself
+     * @since 1.2
+     */
+    bool take(const std::string &fileName, std::string &content);
+
+private:
+    /** Part states */
+    enum class State { Queued, Ready, Failed, Taken };
+
+    /** One listed part */
+    struct Part
+    {
+        std::string name;
+        State state = State::Queued;
+        std::string content;
+    };
+
+    /**
+     * @brief
+     *     Inflate queued parts of the window starting at `first`
+     * @param[in] first
+     *     Index of the part taken now
+     * @since 1.2
+     */
+    void fetch(size_t first);
+
+    /** Archive session */
+    std::shared_ptr<const Archive> m_archive;
+    /** Listed parts */
+    std::vector<Part> m_parts;
+};
+
+}   // End namespace
@@ -0,0 +1,264 @@
+/**
+ * @brief   Fast text-run extractor for XML parts
+ * @package ooxml
+ * @file    textscan.cpp
+ * @date    19.10.2026
+ */
+#include <algorithm>
+
+#include "ooxml.hpp"
+#include "xmlreader.hpp"
+
+#include "textscan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXTSCAN_X86
+#endif
+
+namespace ooxml {
+
+/** Find first `<`, `&` or `\r`, one byte at a time */
+static const char *findSpecialScalar(const char *pos, const char *end)
+{
+    for (; pos < end; ++pos) {
+        if (*pos == '<' || *pos == '&' || *pos == '\r')
+            return pos;
+    }
+    return end;
+}
+
+#ifdef TEXTSCAN_X86
+/** Find first `<`, `&` or `\r`, 16 bytes at a time */
+__attribute__((target("sse2")))
+static const char *findSpecialSse2(const char *pos, const char *end)
+{
+    const __m128i lt  = _mm_set1_epi8('<');
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i cr  = _mm_set1_epi8('\r');
+    for (; end - pos >= 16; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, lt),
+                                                  _mm_cmpeq_epi8(chunk, amp)),
+                                     _mm_cmpeq_epi8(chunk, cr));
+        int mask = _mm_movemask_epi8(found);
+        if (mask)
+            return pos + __builtin_ctz(mask);
+    }
+    return findSpecialScalar(pos, end);
+}
+
+/** Find first `<`, `&` or `\r`, 32 bytes at a time */
+__attribute__((target("avx2")))
+static const char *findSpecialAvx2(const char *pos, const char *end)
+{
+    const __m256i lt  = _mm256_set1_epi8('<');
+    const __m256i amp = _mm256_set1_epi8('&');
+    const __m256i cr  = _mm256_set1_epi8('\r');
+    for (; end - pos >= 32; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        __m256i found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, lt),
+                                                        _mm256_cmpeq_epi8(chunk, amp)),
+                                        _mm256_cmpeq_epi8(chunk, cr));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(found));
+        if (mask)
+            return pos + __builtin_ctz(mask);
+    }
+    return findSpecialScalar(pos, end);
+}
+
+using FindSpecial = const char *(*)(const char *, const char *);
+
+/** Choose the widest implementation supported by the CPU */
+static FindSpecial resolveFindSpecial()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return findSpecialAvx2;
+    if (__builtin_cpu_supports("sse2"))
+        return findSpecialSse2;
+    return findSpecialScalar;
+}
+#endif
+
+/** Find pattern in range, nullptr if it's missing */
+static const char *findSequence(const char *pos, const char *end, std::string_view pattern)
+{
+    std::string_view window(pos, end - pos);
+    size_t found = window.find(pattern);
+    return found == std::string_view::npos ? nullptr : pos + found;
+}
+
+// public:
+const char *TextScanner::findSpecial(const char *begin, const char *end)
+{
+#ifdef TEXTSCAN_X86
+    static const FindSpecial find = resolveFindSpecial();
+    return find(begin, end);
+#else
+    return findSpecialScalar(begin, end);
+#endif
+}
+
+// private:
+void TextScanner::readMarkup(const char *&pos, const char *end, Markup &markup, std::string &text, bool inText) const
+{
+    const char *p = pos + 1;
+    if (p == end) {
+        pos = nullptr;
+        return;
+    }
+
+    // Processing instructions, comments, CDATA and DOCTYPE
+    if (*p == '?') {
+        const char *close = findSequence(p, end, "?>");
+        pos = close ? close + 2 : nullptr;
+        return;
+    }
+    if (*p == '!') {
+        std::string_view head(p, std::min<size_t>(8, end - p));
+        const char *close;
+        if (head.compare(0, 3, "!--") == 0) {
+            close = findSequence(p + 3, end, "-->");
+            pos = close ? close + 3 : nullptr;
+        }
+        else if (head == "![CDATA[") {
+            close = findSequence(p + 8, end, "]]>");
+            if (close && inText)
+                text.append(p + 8, close);
+            pos = close ? close + 3 : nullptr;
+        }
+        else {
+            close = static_cast<const char *>(memchr(p, '>', end - p));
+            pos = close ? close + 1 : nullptr;
+        }
+        return;
+    }
+
+    markup.isEnd = *p == '/';
+    if (markup.isEnd)
+        ++p;
+    const char *nameStart = p;
+    while (p < end && *p != '>' && *p != '/' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+        ++p;
+    markup.name = std::string_view(nameStart, p - nameStart);
+    const char *attributes = p;
+
+    // Tag end, `>` may appear inside quoted attribute values
+    const char *close;
+    while (true) {
+        close = static_cast<const char *>(memchr(p, '>', end - p));
+        if (!close) {
+            pos = nullptr;
+            return;
+        }
+        const char *quote = std::find_if(p, close, [](char c) { return c == '"' || c == '\''; });
+        if (quote == close)
+            break;
+        const char *closeQuote = static_cast<const char *>(memchr(quote + 1, *quote, end - quote - 1));
+        if (!closeQuote) {
+            pos = nullptr;
+            return;
+        }
+        p = closeQuote + 1;
+    }
+    markup.isEmpty = !markup.isEnd && close[-1] == '/';
+    markup.attributes = std::string_view(attributes, close - attributes);
+    pos = close + 1;
+
+    const std::string_view name = markup.name;
+    if (name == m_textTag)
+        markup.tag = Tag::Text;
+    else if (name == m_blockTag)
+        markup.tag = Tag::Block;
+    else if (!m_skipTag.empty() && name == m_skipTag)
+        markup.tag = Tag::Skip;
+    else if (name == "mc:AlternateContent")
+        markup.tag = Tag::AlternateContent;
+    else if (name == "mc:Choice")
+        markup.tag = Tag::Choice;
+    else if (name == "mc:Fallback")
+        markup.tag = Tag::Fallback;
+}
+
+bool TextScanner::skipSubtree(const char *&pos, const char *end, std::string_view name) const
+{
+    std::string unused;
+    int depth = 1;
+    while (true) {
+        pos = static_cast<const char *>(memchr(pos, '<', end - pos));
+        if (!pos)
+            return false;
+
+        Markup markup;
+        readMarkup(pos, end, markup, unused, false);
+        if (!pos)
+            return false;
+        if (markup.name != name)
+            continue;
+        if (markup.isEnd && --depth == 0)
+            return true;
+        if (!markup.isEnd && !markup.isEmpty)
+            ++depth;
+    }
+}
+
+bool TextScanner::understandsChoice(std::string_view attributes)
+{
+    // `Requires` as a whole attribute name, followed by `=` and a quoted value
+    constexpr std::string_view name = "Requires";
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    for (size_t found = attributes.find(name); found != std::string_view::npos;
+         found = attributes.find(name, found + 1)) {
+        if (found == 0 || !isSpace(attributes[found - 1]))
+            continue;
+        size_t p = found + name.size();
+        while (p < attributes.size() && isSpace(attributes[p]))
+            ++p;
+        if (p == attributes.size() || attributes[p] != '=')
+            continue;
+        ++p;
+        while (p < attributes.size() && isSpace(attributes[p]))
+            ++p;
+        if (p == attributes.size() || (attributes[p] != '"' && attributes[p] != '\''))
+            continue;
+        const size_t close = attributes.find(attributes[p], p + 1);
+        if (close == std::string_view::npos)
+            return false;
+        return ooxml::isUnderstoodChoice(attributes.substr(p + 1, close - p - 1));
+    }
+    return false;
+}
+
+const char *TextScanner::appendText(std::string &text, const char *pos, const char *end)
+{
+    while (pos < end) {
+        const char *special = findSpecial(pos, end);
+        text.append(pos, special);
+        if (special == end || *special == '<')
+            return special;
+
+        if (*special == '\r') {
+            // CR LF and single CR become LF
+            text += '\n';
+            pos = special + 1;
+            if (pos < end && *pos == '\n')
+                ++pos;
+            continue;
+        }
+
+        // Entity reference, decoded with the reader rules
+        const char *semicolon = static_cast<const char *>(
+            memchr(special, ';', std::min<size_t>(end - special, 12)));
+        if (!semicolon) {
+            text += '&';
+            pos = special + 1;
+            continue;
+        }
+        XmlReader::appendDecoded(text, std::string_view(special, semicolon + 1 - special));
+        pos = semicolon + 1;
+    }
+    return end;
+}
+
+}   // End namespace
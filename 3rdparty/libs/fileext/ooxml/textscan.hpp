@@ -0,0 +1,226 @@
+/**
+ * @brief   Fast text-run extractor for XML parts
+ * @package ooxml
+ * @file    textscan.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ooxml {
+
+/**
+ * @class TextScanner
+ * @brief
+ *     Extracts character data of one text tag without parsing the XML
+ * @details
+ *     Plain-text extraction only needs `w:t`/`a:t`/`t` contents and block
+ *     (paragraph, string item) boundaries. The scanner searches the raw part
+ *     for markup with SIMD (AVX2 or SSE2, chosen at runtime) and decodes text
+ *     of matching elements inline; all other markup is skipped by name only.
+ *     It is a fast mode: nesting isn't checked, so text tags are taken
+ *     wherever they occur outside of the skipped element.
+ *
+ *     Of every `mc:AlternateContent` one branch is read, chosen like
+ *     ooxml::selectAlternateContent() does: the first `mc:Choice` whose
+ *     `Requires` namespaces are understood, else `mc:Fallback`.
+ */
+class TextScanner
+{
+public:
+    /** Scan events */
+    enum class Event {
+        BlockStart,  ///< Start tag of block element
+        BlockEnd,    ///< End tag of block element (also after `<block/>`)
+        TextEnd      ///< Text element ended, its text was appended
+    };
+
+    /**
+     * @param[in] textTag
+     *     Element with text, e.g. `w:t`
+     * @param[in] blockTag
+     *     Block element, e.g. `w:p`
+     * @param[in] skipTag
+     *     Element whose whole subtree is ignored (may be empty)
+     * @since 1.2
+     */
+    TextScanner(std::string_view textTag, std::string_view blockTag, std::string_view skipTag = {})
+        : m_textTag(textTag), m_blockTag(blockTag), m_skipTag(skipTag) {}
+
+    /**
+     * @brief
+     *     Scan part
+     * @param[in] xml
+     *     Raw part content
+     * @param[out] text
+     *     Decoded text of text elements is appended here
+     * @param[in] onEvent
+     *     Called as `bool onEvent(Event)`, returning false stops the scan
+     * @return
+     *     False if part ended inside markup
+     * @since 1.2
+     */
+    template <class Callback>
+    bool scan(std::string_view xml, std::string &text, Callback &&onEvent) const;
+
+    /**
+     * @brief
+     *     Find first `<`, `&` or `\r` in range
+     * @return
+     *     Pointer to the character or `end`
+     * @since 1.2
+     */
+    static const char *findSpecial(const char *begin, const char *end);
+
+private:
+    /** Tag kinds */
+    enum class Tag { Other, Text, Block, Skip, AlternateContent, Choice, Fallback };
+
+    /** One piece of markup */
+    struct Markup {
+        Tag tag = Tag::Other;         ///< Other for comments, PIs, CDATA and unknown tags
+        std::string_view name;        ///< Element name
+        std::string_view attributes;  ///< Raw attributes of start tag
+        bool isEnd = false;           ///< End tag
+        bool isEmpty = false;         ///< `<name/>`
+    };
+
+    /**
+     * @brief
+     *     Read one piece of markup starting at `<`
+     * @param[in,out] pos
+     *     Position of `<`, moved past markup
+     * @param[in] end
+     *     End of data
+     * @param[out] markup
+     *     Kind and name of the markup
+     * @param[out] text
+     *     CDATA content is appended here if `inText`
+     * @param[in] inText
+     *     True inside text element
+     * @since 1.2
+     */
+    void readMarkup(const char *&pos, const char *end, Markup &markup, std::string &text, bool inText) const;
+
+    /**
+     * @brief
+     *     Skip subtree of element
+     * @param[in,out] pos
+     *     Position after its start tag, moved past its end tag
+     * @param[in] name
+     *     Element name
+     * @return
+     *     False if part ended
+     * @since 1.2
+     */
+    bool skipSubtree(const char *&pos, const char *end, std::string_view name) const;
+
+    /**
+     * @brief
+     *     Check `Requires` attribute of `mc:Choice`
+     * @param[in] attributes
+     *     Raw attributes of its start tag
+     * @since 1.2
+     */
+    static bool understandsChoice(std::string_view attributes);
+
+    /**
+     * @brief
+     *     Decode character data up to next `<`
+     * @return
+     *     Position of `<` or `end`
+     * @since 1.2
+     */
+    static const char *appendText(std::string &text, const char *pos, const char *end);
+
+    /** Text element name */
+    std::string_view m_textTag;
+    /** Block element name */
+    std::string_view m_blockTag;
+    /** Skipped element name */
+    std::string_view m_skipTag;
+};
+
+
+template <class Callback>
+bool TextScanner::scan(std::string_view xml, std::string &text, Callback &&onEvent) const
+{
+    const char *pos = xml.data();
+    const char *const end = pos + xml.size();
+    bool inText = false;
+    // One entry per open `mc:AlternateContent`: a branch of it was read
+    std::vector<bool> branchTaken;
+
+    while (pos < end) {
+        if (*pos != '<') {
+            if (inText)
+                pos = appendText(text, pos, end);
+            else
+                pos = static_cast<const char *>(memchr(pos, '<', end - pos));
+            if (!pos || pos == end)
+                break;
+        }
+
+        Markup markup;
+        readMarkup(pos, end, markup, text, inText);
+        if (!pos)
+            return false;
+
+        const bool isEnd = markup.isEnd;
+        const bool isEmpty = markup.isEmpty;
+        switch (markup.tag) {
+        case Tag::Text:
+            if (isEnd) {
+                if (inText && !onEvent(Event::TextEnd))
+                    return true;
+                inText = false;
+            }
+            else if (isEmpty) {
+                if (!onEvent(Event::TextEnd))
+                    return true;
+            }
+            else {
+                inText = true;
+            }
+            break;
+        case Tag::Block:
+            if (!isEnd && !onEvent(Event::BlockStart))
+                return true;
+            if ((isEnd || isEmpty) && !onEvent(Event::BlockEnd))
+                return true;
+            break;
+        case Tag::Skip:
+            if (!isEnd && !isEmpty && !skipSubtree(pos, end, markup.name))
+                return false;
+            break;
+        case Tag::AlternateContent:
+            if (isEnd && !branchTaken.empty())
+                branchTaken.pop_back();
+            else if (!isEnd && !isEmpty)
+                branchTaken.push_back(false);
+            break;
+        case Tag::Choice:
+        case Tag::Fallback:
+            if (isEnd || isEmpty)
+                break;
+            if (branchTaken.empty() || branchTaken.back() ||
+                (markup.tag == Tag::Choice && !understandsChoice(markup.attributes))) {
+                if (!skipSubtree(pos, end, markup.name))
+                    return false;
+            }
+            else
+                branchTaken.back() = true;
+            break;
+        case Tag::Other:
+            break;
+        }
+    }
+    return true;
+}
+
+}   // End namespace
@@ -0,0 +1,415 @@
+/**
+ * @brief   Streaming pull parser for XML parts of zip packages
+ * @package ooxml
+ * @file    xmlreader.cpp
+ * @date    19.10.2026
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "xmlreader.hpp"
+
+namespace ooxml {
+
+/** Size of one inflated chunk */
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+/** Check if character is XML whitespace */
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/** Append code point as UTF-8 */
+static void appendUtf8(std::string &out, unsigned long code)
+{
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    }
+    else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x110000) {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+/**
+ * Decode entity reference starting after `&`.
+ * Returns length of reference body including `;`, or 0 if it isn't valid.
+ */
+static size_t decodeEntity(std::string &out, std::string_view raw)
+{
+    size_t end = raw.find(';');
+    if (end == std::string_view::npos || end == 0 || end > 10)
+        return 0;
+
+    std::string_view name = raw.substr(0, end);
+    if (name[0] == '#') {
+        unsigned long code = 0;
+        bool hex = name.size() > 1 && (name[1] == 'x' || name[1] == 'X');
+        size_t i = hex ? 2 : 1;
+        if (i == name.size())
+            return 0;
+        for (; i < name.size(); ++i) {
+            char c = name[i];
+            int digit;
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (hex && c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (hex && c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+            else
+                return 0;
+            code = code * (hex ? 16 : 10) + digit;
+        }
+        appendUtf8(out, code);
+    }
+    else if (name == "lt")
+        out += '<';
+    else if (name == "gt")
+        out += '>';
+    else if (name == "amp")
+        out += '&';
+    else if (name == "quot")
+        out += '"';
+    else if (name == "apos")
+        out += '\'';
+    else
+        return 0;
+
+    return end + 1;
+}
+
+// public:
+XmlReader::XmlReader(const Archive *archive, const std::string &fileName)
+    : m_stream(archive, fileName)
+{
+    m_isView = m_stream.view(m_view);
+    m_eof = m_isView || !m_stream.isOpen();
+}
+
+XmlReader::XmlReader(std::string_view xml)
+    : m_stream(nullptr, std::string())
+    , m_view(xml)
+    , m_isView(true)
+    , m_eof(true)
+{
+}
+
+XmlReader::Token XmlReader::next()
+{
+    if (m_pendingPop) {
+        --m_depth;
+        m_pendingPop = false;
+    }
+    // Empty element: report its end without reading anything
+    if (m_pendingEnd) {
+        m_pendingEnd = false;
+        m_pendingPop = true;
+        return Token::EndElement;
+    }
+
+    while (true) {
+        m_tokenStart = m_pos;
+        if (m_pos == size() && !fill())
+            return Token::End;
+
+        if (data()[m_pos] != '<')
+            return readText();
+
+        // Need a few characters to distinguish markup kinds
+        while (size() - m_pos < 9 && fill()) {}
+        std::string_view head(data() + m_pos, std::min<size_t>(9, size() - m_pos));
+
+        if (head.compare(0, 2, "<?") == 0) {
+            size_t end = seek("?>", 2);
+            if (end == std::string::npos)
+                break;
+            m_pos += end + 2;
+            continue;
+        }
+        if (head.compare(0, 4, "<!--") == 0) {
+            size_t end = seek("-->", 4);
+            if (end == std::string::npos)
+                break;
+            m_pos += end + 3;
+            continue;
+        }
+        if (head.compare(0, 9, "<![CDATA[") == 0) {
+            size_t end = seek("]]>", 9);
+            if (end == std::string::npos)
+                break;
+            m_text.clear();
+            if (!m_raw)
+                m_text.assign(data() + m_pos + 9, end - 9);
+            m_pos += end + 3;
+            return Token::Text;
+        }
+        if (head.compare(0, 2, "<!") == 0) {
+            size_t end = seekTagEnd();
+            if (end == std::string::npos)
+                break;
+            m_pos += end + 1;
+            continue;
+        }
+
+        size_t end = seekTagEnd();
+        if (end == std::string::npos)
+            break;
+
+        std::string_view tag(data() + m_pos + 1, end - 1);
+        m_pos += end + 1;
+        if (!tag.empty() && tag[0] == '/') {
+            tag.remove_prefix(1);
+            while (!tag.empty() && isSpace(tag.back()))
+                tag.remove_suffix(1);
+            m_name = tag;
+            m_pendingPop = true;
+            return Token::EndElement;
+        }
+
+        ++m_depth;
+        if (!tag.empty() && tag.back() == '/') {
+            tag.remove_suffix(1);
+            m_pendingEnd = true;
+        }
+        parseStartTag(tag);
+        return Token::StartElement;
+    }
+
+    // Part ended inside markup
+    m_failed = true;
+    m_pos = size();
+    return Token::End;
+}
+
+std::string_view XmlReader::rawAttribute(std::string_view name) const
+{
+    for (const auto &attribute : m_attributes) {
+        if (attribute.first == name)
+            return attribute.second;
+    }
+    return {};
+}
+
+std::string XmlReader::attribute(std::string_view name) const
+{
+    std::string value;
+    appendDecoded(value, rawAttribute(name));
+    return value;
+}
+
+void XmlReader::skipElement()
+{
+    if (m_pendingEnd) {
+        next();
+        return;
+    }
+
+    const int depth = m_depth;
+    m_raw = true;
+    for (Token token = next(); token != Token::End; token = next()) {
+        if (token == Token::EndElement && m_depth == depth)
+            break;
+    }
+    m_raw = false;
+}
+
+bool XmlReader::readElement(std::string &xml)
+{
+    if (m_pendingEnd) {
+        xml.assign(data() + m_tokenStart, m_pos - m_tokenStart);
+        next();
+        return true;
+    }
+
+    const int depth = m_depth;
+    bool closed = false;
+    m_pin = m_tokenStart;
+    m_raw = true;
+    for (Token token = next(); token != Token::End; token = next()) {
+        if (token == Token::EndElement && m_depth == depth) {
+            closed = true;
+            break;
+        }
+    }
+    m_raw = false;
+
+    if (closed)
+        xml.assign(data() + m_pin, m_pos - m_pin);
+    m_pin = std::string::npos;
+    return closed;
+}
+
+void XmlReader::appendDecoded(std::string &out, std::string_view raw)
+{
+    while (!raw.empty()) {
+        // Copy plain runs in one go
+        size_t special = 0;
+        while (special < raw.size() && raw[special] != '&' && raw[special] != '\r')
+            ++special;
+        out.append(raw.data(), special);
+        if (special == raw.size())
+            break;
+
+        if (raw[special] == '\r') {
+            // CR LF and single CR become LF
+            out += '\n';
+            raw.remove_prefix(special + 1);
+            if (!raw.empty() && raw[0] == '\n')
+                raw.remove_prefix(1);
+            continue;
+        }
+
+        size_t length = decodeEntity(out, raw.substr(special + 1));
+        if (!length)
+            out += '&';
+        raw.remove_prefix(special + 1 + length);
+    }
+}
+
+// private:
+bool XmlReader::fill()
+{
+    if (m_eof)
+        return false;
+
+    // Keep current token (or captured element), drop everything before it
+    size_t keep = std::min(m_tokenStart, m_pin);
+    if (keep > 0) {
+        m_buffer.erase(0, keep);
+        m_pos -= keep;
+        m_tokenStart -= keep;
+        if (m_pin != std::string::npos)
+            m_pin -= keep;
+    }
+
+    size_t oldSize = m_buffer.size();
+    m_buffer.resize(oldSize + CHUNK_SIZE);
+    size_t count = m_stream.read(&m_buffer[oldSize], CHUNK_SIZE);
+    m_buffer.resize(oldSize + count);
+    if (count == 0)
+        m_eof = true;
+    return count > 0;
+}
+
+size_t XmlReader::seek(std::string_view pattern, size_t from)
+{
+    while (true) {
+        std::string_view window(data() + m_pos, size() - m_pos);
+        size_t found = window.find(pattern, from);
+        if (found != std::string_view::npos)
+            return found;
+        // Pattern may start in the tail of current window
+        if (window.size() >= pattern.size())
+            from = std::max(from, window.size() - pattern.size() + 1);
+        if (!fill())
+            return std::string::npos;
+    }
+}
+
+size_t XmlReader::seekTagEnd()
+{
+    size_t offset = 1;
+    char quote = 0;
+    while (true) {
+        const char *begin = data() + m_pos;
+        const size_t available = size() - m_pos;
+        for (; offset < available; ++offset) {
+            char c = begin[offset];
+            if (quote) {
+                if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '"' || c == '\'') {
+                quote = c;
+            }
+            else if (c == '>') {
+                return offset;
+            }
+        }
+        if (!fill())
+            return std::string::npos;
+    }
+}
+
+XmlReader::Token XmlReader::readText()
+{
+    while (true) {
+        const char *begin = data() + m_pos;
+        const size_t available = size() - m_pos;
+        const char *lt = static_cast<const char *>(memchr(begin, '<', available));
+
+        size_t length = lt ? static_cast<size_t>(lt - begin) : available;
+        if (!lt && !m_eof) {
+            // Keep the window bounded: emit long text in pieces, but never
+            // split an entity or CR LF pair
+            if (available < CHUNK_SIZE) {
+                fill();
+                continue;
+            }
+            std::string_view window(begin, available);
+            size_t amp = window.rfind('&');
+            if (amp != std::string_view::npos && window.find(';', amp) == std::string_view::npos)
+                length = amp;
+            if (length > 0 && begin[length - 1] == '\r')
+                --length;
+            if (length == 0) {
+                fill();
+                continue;
+            }
+        }
+
+        m_text.clear();
+        if (!m_raw)
+            appendDecoded(m_text, std::string_view(begin, length));
+        m_pos += length;
+        return Token::Text;
+    }
+}
+
+void XmlReader::parseStartTag(std::string_view tag)
+{
+    size_t i = 0;
+    while (i < tag.size() && !isSpace(tag[i]))
+        ++i;
+    m_name = tag.substr(0, i);
+
+    m_attributes.clear();
+    if (m_raw)
+        return;
+
+    while (i < tag.size()) {
+        while (i < tag.size() && isSpace(tag[i]))
+            ++i;
+        size_t nameStart = i;
+        while (i < tag.size() && tag[i] != '=' && !isSpace(tag[i]))
+            ++i;
+        std::string_view name = tag.substr(nameStart, i - nameStart);
+        while (i < tag.size() && (isSpace(tag[i]) || tag[i] == '='))
+            ++i;
+        if (i >= tag.size() || (tag[i] != '"' && tag[i] != '\''))
+            break;
+
+        char quote = tag[i++];
+        size_t valueStart = i;
+        while (i < tag.size() && tag[i] != quote)
+            ++i;
+        if (!name.empty())
+            m_attributes.emplace_back(name, tag.substr(valueStart, i - valueStart));
+        ++i;
+    }
+}
+
+}   // End namespace
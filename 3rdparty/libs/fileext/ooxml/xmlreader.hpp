@@ -0,0 +1,250 @@
+/**
+ * @brief   Streaming pull parser for XML parts of zip packages
+ * @package ooxml
+ * @file    xmlreader.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ooxml.hpp"
+
+namespace ooxml {
+
+/**
+ * @class XmlReader
+ * @brief
+ *     Pull tokenizer working directly on a (possibly inflating) part stream
+ * @details
+ *     Only a window of the part is kept in memory: the current token plus one
+ *     read chunk, or a single element subtree while it's captured by
+ *     `readElement()`. Large parts (sheets, document bodies, slides) can
+ *     therefore be walked without building a DOM for the whole part.
+ *
+ *     Element and attribute names are reported as written (with prefix).
+ *     Processing instructions, comments and DOCTYPE are skipped, CDATA is
+ *     reported as text. Views returned by `name()` and `rawAttribute()` are
+ *     valid until the next call to `next()`.
+ */
+class XmlReader
+{
+public:
+    /** Token types */
+    enum class Token {
+        StartElement,  ///< `<name ...>` or `<name .../>`
+        EndElement,    ///< `</name>`, also reported after empty element
+        Text,          ///< Decoded character data (may come in several pieces)
+        End            ///< End of part or malformed data, see `failed()`
+    };
+
+    /**
+	 * @param[in] archive
+	 *     Opened archive (may be nullptr)
+	 * @param[in] fileName
+	 *     Part name (case insensitive)
+	 * @since 1.2
+	 */
+    XmlReader(const Archive *archive, const std::string &fileName);
+
+    /**
+	 * @param[in] xml
+	 *     Part content already in memory, must outlive the reader
+	 * @since 1.2
+	 */
+    explicit XmlReader(std::string_view xml);
+
+    XmlReader(const XmlReader &) = delete;
+    XmlReader &operator=(const XmlReader &) = delete;
+
+    /**
+	 * @brief
+	 *     Check if part was found
+	 * @since 1.2
+	 */
+    bool isOpen() const { return m_isView || m_stream.isOpen(); }
+
+    /**
+	 * @brief
+	 *     Check if reading stopped on corrupted or malformed data
+	 * @since 1.2
+	 */
+    bool failed() const { return m_failed || m_stream.failed(); }
+
+    /**
+	 * @brief
+	 *     Read next token
+	 * @since 1.2
+	 */
+    Token next();
+
+    /**
+	 * @brief
+	 *     Current element name (StartElement/EndElement)
+	 * @since 1.2
+	 */
+    std::string_view name() const { return m_name; }
+
+    /**
+	 * @brief
+	 *     Current element depth, 1 for root element
+	 * @since 1.2
+	 */
+    int depth() const { return m_depth; }
+
+    /**
+	 * @brief
+	 *     Check if current StartElement is written as `<name/>`
+	 * @since 1.2
+	 */
+    bool isEmptyElement() const { return m_pendingEnd; }
+
+    /**
+	 * @brief
+	 *     Decoded text of current Text token
+	 * @since 1.2
+	 */
+    const std::string &text() const { return m_text; }
+
+    /**
+	 * @brief
+	 *     Undecoded attribute value of current StartElement
+	 * @param[in] name
+	 *     Attribute name
+	 * @return
+	 *     Raw value, empty if attribute is missing
+	 * @since 1.2
+	 */
+    std::string_view rawAttribute(std::string_view name) const;
+
+    /**
+	 * @brief
+	 *     Decoded attribute value of current StartElement
+	 * @param[in] name
+	 *     Attribute name
+	 * @since 1.2
+	 */
+    std::string attribute(std::string_view name) const;
+
+    /**
+	 * @brief
+	 *     Skip subtree of current StartElement, next token follows its end tag
+	 * @since 1.2
+	 */
+    void skipElement();
+
+    /**
+	 * @brief
+	 *     Capture markup of current StartElement including its subtree
+	 * @details
+	 *     Used to build a small DOM for one record (row, paragraph, ...)
+	 *     of a huge part. Next token follows the element end tag.
+	 * @param[out] xml
+	 *     Element markup
+	 * @return
+	 *     False if part ended before the element was closed
+	 * @since 1.2
+	 */
+    bool readElement(std::string &xml);
+
+    /**
+	 * @brief
+	 *     Append decoded character data (entities, CR LF) to string
+	 * @param[out] out
+	 *     Destination
+	 * @param[in] raw
+	 *     Raw character data
+	 * @since 1.2
+	 */
+    static void appendDecoded(std::string &out, std::string_view raw);
+
+private:
+    /**
+	 * @brief
+	 *     Read next chunk, dropping consumed data
+	 * @return
+	 *     False if there is no more data
+	 * @since 1.2
+	 */
+    bool fill();
+
+    /**
+	 * @brief
+	 *     Find pattern at or after position relative to current token
+	 * @return
+	 *     Offset relative to current token or npos if part ended
+	 * @since 1.2
+	 */
+    size_t seek(std::string_view pattern, size_t from);
+
+    /**
+	 * @brief
+	 *     Find closing `>` of a tag, skipping quoted attribute values
+	 * @return
+	 *     Offset relative to current token or npos if part ended
+	 * @since 1.2
+	 */
+    size_t seekTagEnd();
+
+    /**
+	 * @brief
+	 *     Read character data token
+	 * @since 1.2
+	 */
+    Token readText();
+
+    /**
+	 * @brief
+	 *     Parse tag name and attributes of start tag
+	 * @param[in] tag
+	 *     Tag content between `<` and `>`
+	 * @since 1.2
+	 */
+    void parseStartTag(std::string_view tag);
+
+    /** Current data */
+    const char *data() const { return m_isView ? m_view.data() : m_buffer.data(); }
+    /** Current data size */
+    size_t size() const { return m_isView ? m_view.size() : m_buffer.size(); }
+
+    /** Part stream */
+    PartStream m_stream;
+    /** Whole part if it's stored in mapped package */
+    std::string_view m_view;
+    /** True if reading from m_view */
+    bool m_isView = false;
+    /** Window of inflated data */
+    std::string m_buffer;
+    /** True if stream is exhausted */
+    bool m_eof = false;
+    /** Malformed data flag */
+    bool m_failed = false;
+
+    /** Read position */
+    size_t m_pos = 0;
+    /** Start of current token */
+    size_t m_tokenStart = 0;
+    /** Start of captured element or npos */
+    size_t m_pin = std::string::npos;
+    /** Don't decode text while skipping or capturing */
+    bool m_raw = false;
+
+    /** Current element name */
+    std::string_view m_name;
+    /** Current element attributes (raw) */
+    std::vector<std::pair<std::string_view, std::string_view>> m_attributes;
+    /** Current text */
+    std::string m_text;
+    /** Current depth */
+    int m_depth = 0;
+    /** End tag of empty element must be reported */
+    bool m_pendingEnd = false;
+    /** Depth must be decreased before next token */
+    bool m_pendingPop = false;
+};
+
+}   // End namespace
@@ -0,0 +1,206 @@
+/**
+ * @brief   Compile-time perfect hash of XML element names
+ * @package ooxml
+ * @file    xmltag.hpp
+ * @version 1.2
+ * @date    19.10.2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include "tools.hpp"
+
+namespace ooxml {
+
+/**
+ * @brief
+ *     Element names the parsers dispatch on
+ * @details
+ *     Names are qualified as written in the part (prefix + local name).
+ *     SpreadsheetML parts use the default namespace, so their tags have
+ *     no prefix.
+ */
+enum class XmlTag : unsigned char {
+    Unknown,
+    // WordprocessingML
+    WBody, WP, WR, WT, WTbl, WTr, WTc, WTcPr, WSectPr, WHyperlink, WIns, WSmartTag,
+    WDrawing, WPict, WTxbxContent,
+    WStyle, WName, WRPr, WAbstractNum, WAbstractNumId, WNum, WLvl, WNumFmt,
+    // Markup compatibility
+    McAlternateContent, McChoice, McFallback,
+    // DrawingML
+    AP, AT,
+    // SpreadsheetML
+    Si, Is, R, T, V, F, Row, Col, MergeCell, TablePart, Dimension,
+    Name, Sz, Color, VertAlign, Family, B, I, U, Strike,
+    Left, Right, Top, Bottom, Diagonal, FgColor, BgColor, CellStyleXfs, CellXfs,
+    // OpenDocument
+    TableTable, TableTableRow, TableTableCell, TextP, TextA
+};
+
+/** Known element names */
+constexpr tools::TableEntry<std::string_view, XmlTag> XML_TAGS[] {
+    {"w:body",              XmlTag::WBody},
+    {"w:p",                 XmlTag::WP},
+    {"w:r",                 XmlTag::WR},
+    {"w:t",                 XmlTag::WT},
+    {"w:tbl",               XmlTag::WTbl},
+    {"w:tr",                XmlTag::WTr},
+    {"w:tc",                XmlTag::WTc},
+    {"w:tcPr",              XmlTag::WTcPr},
+    {"w:sectPr",            XmlTag::WSectPr},
+    {"w:hyperlink",         XmlTag::WHyperlink},
+    {"w:ins",               XmlTag::WIns},
+    {"w:smartTag",          XmlTag::WSmartTag},
+    {"w:drawing",           XmlTag::WDrawing},
+    {"w:pict",              XmlTag::WPict},
+    {"w:txbxContent",       XmlTag::WTxbxContent},
+    {"w:style",             XmlTag::WStyle},
+    {"w:name",              XmlTag::WName},
+    {"w:rPr",               XmlTag::WRPr},
+    {"w:abstractNum",       XmlTag::WAbstractNum},
+    {"w:abstractNumId",     XmlTag::WAbstractNumId},
+    {"w:num",               XmlTag::WNum},
+    {"w:lvl",               XmlTag::WLvl},
+    {"w:numFmt",            XmlTag::WNumFmt},
+    {"mc:AlternateContent", XmlTag::McAlternateContent},
+    {"mc:Choice",           XmlTag::McChoice},
+    {"mc:Fallback",         XmlTag::McFallback},
+    {"a:p",                 XmlTag::AP},
+    {"a:t",                 XmlTag::AT},
+    {"si",                  XmlTag::Si},
+    {"is",                  XmlTag::Is},
+    {"r",                   XmlTag::R},
+    {"t",                   XmlTag::T},
+    {"v",                   XmlTag::V},
+    {"f",                   XmlTag::F},
+    {"row",                 XmlTag::Row},
+    {"col",                 XmlTag::Col},
+    {"mergeCell",           XmlTag::MergeCell},
+    {"tablePart",           XmlTag::TablePart},
+    {"dimension",           XmlTag::Dimension},
+    {"name",                XmlTag::Name},
+    {"sz",                  XmlTag::Sz},
+    {"color",               XmlTag::Color},
+    {"vertAlign",           XmlTag::VertAlign},
+    {"family",              XmlTag::Family},
+    {"b",                   XmlTag::B},
+    {"i",                   XmlTag::I},
+    {"u",                   XmlTag::U},
+    {"strike",              XmlTag::Strike},
+    {"left",                XmlTag::Left},
+    {"right",               XmlTag::Right},
+    {"top",                 XmlTag::Top},
+    {"bottom",              XmlTag::Bottom},
+    {"diagonal",            XmlTag::Diagonal},
+    {"fgColor",             XmlTag::FgColor},
+    {"bgColor",             XmlTag::BgColor},
+    {"cellStyleXfs",        XmlTag::CellStyleXfs},
+    {"cellXfs",             XmlTag::CellXfs},
+    {"table:table",         XmlTag::TableTable},
+    {"table:table-row",     XmlTag::TableTableRow},
+    {"table:table-cell",    XmlTag::TableTableCell},
+    {"text:p",              XmlTag::TextP},
+    {"text:a",              XmlTag::TextA}
+};
+
+/** Hash table size (power of two) */
+constexpr size_t XML_TAG_SLOTS = 1024;
+
+/**
+ * @brief
+ *     Seeded FNV-1a hash of element name
+ * @since 1.2
+ */
+constexpr uint32_t xmlTagHash(std::string_view name, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * @brief
+ *     Find seed for which every known name gets its own slot
+ * @return
+ *     Seed or UINT32_MAX if there is none
+ * @since 1.2
+ */
+constexpr uint32_t findXmlTagSeed() {
+    for (uint32_t seed = 0; seed < 4096; ++seed) {
+        bool used[XML_TAG_SLOTS] = {};
+        bool isPerfect = true;
+        for (const auto& entry : XML_TAGS) {
+            const size_t slot = xmlTagHash(entry.key, seed) & (XML_TAG_SLOTS - 1);
+            if (used[slot]) {
+                isPerfect = false;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (isPerfect)
+            return seed;
+    }
+    return UINT32_MAX;
+}
+
+/** Seed of perfect hash */
+constexpr uint32_t XML_TAG_SEED = findXmlTagSeed();
+static_assert(XML_TAG_SEED != UINT32_MAX, "No perfect hash seed for XML_TAGS");
+
+/** Slot table: index in XML_TAGS + 1, 0 for empty slot */
+struct XmlTagSlots {
+    unsigned char index[XML_TAG_SLOTS];
+};
+
+/**
+ * @brief
+ *     Build slot table
+ * @since 1.2
+ */
+constexpr XmlTagSlots makeXmlTagSlots() {
+    XmlTagSlots slots {};
+    for (size_t i = 0; i < std::size(XML_TAGS); ++i)
+        slots.index[xmlTagHash(XML_TAGS[i].key, XML_TAG_SEED) & (XML_TAG_SLOTS - 1)] =
+            static_cast<unsigned char>(i + 1);
+    return slots;
+}
+
+/** Slot table of perfect hash */
+constexpr XmlTagSlots XML_TAG_SLOT_TABLE = makeXmlTagSlots();
+
+/**
+ * @brief
+ *     Get tag of element name
+ * @details
+ *     One hash and one string comparison, nothing is allocated
+ * @param[in] name
+ *     Qualified element name
+ * @return
+ *     Tag, Unknown for names missing in XML_TAGS
+ * @since 1.2
+ */
+inline XmlTag tagOf(std::string_view name) {
+    const unsigned char index =
+        XML_TAG_SLOT_TABLE.index[xmlTagHash(name, XML_TAG_SEED) & (XML_TAG_SLOTS - 1)];
+    if (index && XML_TAGS[index - 1].key == name)
+        return XML_TAGS[index - 1].value;
+    return XmlTag::Unknown;
+}
+
+/**
+ * @brief
+ *     Get tag of element name (e.g. `pugi::xml_node::name()`)
+ * @since 1.2
+ */
+inline XmlTag tagOf(const char* name) {
+    return tagOf(std::string_view(name));
+}
+
+}   // End namespace
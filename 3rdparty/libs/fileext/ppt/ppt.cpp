@@ -7,7 +7,6 @@
  * @date      05.08.2017 -- 10.02.2018
  */
 #include <list>
-#include <regex>
 #include <unordered_map>
 #include <iostream>
 
@@ -36,12 +35,13 @@ enum RecordType {
     OFFICE_ART_SP_CONTAINER = 0xF004
 };
 
-const std::regex HEADER_MASK("(\xA8|\xA0)\x0F", std::regex::icase);
+#ifndef DOCPARSER_TEXT_ONLY
 /** Inline style */
-const std::string STYLE = "div{font-family: monospace;font-size: 13px}.slide{margin-bottom: 20px;"
-						  "padding-bottom: 10px;border-bottom: 1px solid #ddd}.slide-number{"
-						  "font-weight: bold;font-size: 15px;margin-bottom: 10px}.slide-title{"
-						  "font-weight: bold;font-size: 13px;margin-bottom: 10px}";
+constexpr char STYLE[] = "div{font-family: monospace;font-size: 13px}.slide{margin-bottom: 20px;"
+						 "padding-bottom: 10px;border-bottom: 1px solid #ddd}.slide-number{"
+						 "font-weight: bold;font-size: 15px;margin-bottom: 10px}.slide-title{"
+						 "font-weight: bold;font-size: 13px;margin-bottom: 10px}";
+#endif
 
 bool utf16_unichar_has_4_bytes(unsigned int ch)
 {
@@ -90,6 +90,8 @@ Ppt::Ppt(const std::string& fileName)
 	: FileExtension(fileName), Cfb(fileName) {}
 
 int  Ppt::convert(bool addStyle, bool extractImages, char mergingMode) {
+	if (!m_content.empty())
+		setData(std::string(m_content));
 	Cfb::parse();
     std::string ppdStream = getStream("PowerPoint Document");
     if (ppdStream.empty())
@@ -9,47 +9,111 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <string_view>
+
+#include "fileext/dedupe.hpp"
+#include "fileext/ooxml/textscan.hpp"
+#include "fileext/ooxml/xmlreader.hpp"
+#include "fileext/ooxml/xmltag.hpp"
 
 #include "pptx.hpp"
 
 
 namespace pptx {
 
-class TreeWalker : public pugi::xml_tree_walker {
-public:
-    virtual bool for_each(pugi::xml_node &node) override {
-        if (node.type() != pugi::node_element)
-            return true;
-
-        std::string nodeName = node.name();
-        if (nodeName == "a:t")
-            content += node.child_value();
-        else if (nodeName == "a:p")
-            content += '\n';
-
-        return true;
-    }
-
-    std::string content;
-};
-
 // public:
 Pptx::Pptx(const std::string& fileName)
     : FileExtension(fileName) {}
 
 int Pptx::convert(bool addStyle, bool extractImages, char mergingMode) {
+    openArchive(m_fileName, m_content);
+
+    const std::string presentationPart = "ppt/presentation.xml";
+    std::string presentationRels;
+    extractFile(ooxml::relationshipsPart(presentationPart), presentationRels);
     pugi::xml_document presentationDoc;
-    Ooxml::extractFile(m_fileName, "ppt/presentation.xml", presentationDoc);
-    const auto &numNode = presentationDoc.child("p:presentation").child("p:sldIdLst");
-    int pageNum = std::distance(numNode.begin(), numNode.end());
-
-    pugi::xml_document tree;
-    for (int i = 1; i <= pageNum && i < 2500; ++i) {
-        std::string xmlName = "ppt/slides/slide" + std::to_string(i) + ".xml";
-        Ooxml::extractFile(m_fileName, xmlName, tree);
-        TreeWalker walker;
-        tree.traverse(walker);
-        if (!safeAppendText(walker.content)) {
+    extractFile(presentationPart, presentationDoc);
+    const auto presentation = presentationDoc.child("p:presentation");
+
+    // Slides come first, masters and layouts follow them
+    const std::vector<std::string> slideNames = resolveIdList(presentation.child("p:sldIdLst"),
+                                                              getRelationships(presentationRels, "/slide"), m_maxSlides);
+    std::vector<std::string> templateNames;
+    if (m_parts & PartMasters) {
+        const std::vector<std::string> masters = resolveIdList(
+            presentation.child("p:sldMasterIdLst"), getRelationships(presentationRels, "/slideMaster"), 0);
+        templateNames = getTemplateNames(masters);
+    }
+
+    // Paragraphs of masters, layouts and notes are boilerplate: once one of them
+    // is in the text, its repeats are dropped. Other paragraphs are always kept
+    const bool isDeduplicated = (m_parts & ~PartSlides) != 0;
+    fileext::ParagraphDedupe paragraphs(isDeduplicated ? fileext::DEDUPE_SLOTS : 0);
+    std::string filtered;
+    auto appendText = [&](const std::string& text) {
+        if (!isDeduplicated)
+            return safeAppendText(text);
+        filtered.clear();
+        paragraphs.filter(text, filtered);
+        return safeAppendText(filtered);
+    };
+
+    // Templates are few and small, they are read first so that the
+    // boilerplate is known while slides are appended
+    std::vector<std::string> templateTexts(templateNames.size());
+    ooxml::PartPool(archive()).run(templateNames,
+        [&](size_t index, std::string_view xml, const ooxml::PartPool::Reader&) {
+            try {
+                templateTexts[index] = getSlideText(xml);
+            }
+            catch (const std::bad_alloc &) {
+                templateTexts[index] = std::string();
+            }
+            return !isPastDeadline();
+        });
+    for (const auto& text : templateTexts)
+        paragraphs.addBoilerplate(text);
+
+    // Slides are independent: each is inflated and read on a worker into its
+    // own buffers. Read slides are appended in order as soon as the slides in
+    // front of them are, so no more slides are taken once the text is full
+    std::vector<std::string> slideTexts(slideNames.size());
+    std::vector<std::string> notesTexts(slideNames.size());
+    std::vector<char> isRead(slideNames.size(), false);
+    std::mutex appendMutex;
+    size_t appended = 0;
+    bool isFull = false;
+    auto appendReadSlides = [&] {
+        for (; !isFull && appended < slideNames.size() && isRead[appended]; ++appended) {
+            paragraphs.addBoilerplate(notesTexts[appended]);
+            isFull = !appendText(slideTexts[appended]) || !appendText(notesTexts[appended]);
+            slideTexts[appended] = std::string();
+            notesTexts[appended] = std::string();
+        }
+    };
+    auto readSlide = [&](size_t index, std::string_view xml, const ooxml::PartPool::Reader& reader) {
+        try {
+            if (m_parts & PartSlides)
+                slideTexts[index] = getSlideText(xml);
+            if ((m_parts & PartNotes) && !xml.empty())
+                notesTexts[index] = getNotesText(slideNames[index], reader);
+        }
+        catch (const std::bad_alloc &) {
+            slideTexts[index] = std::string();
+            notesTexts[index] = std::string();
+        }
+
+        std::lock_guard<std::mutex> lock(appendMutex);
+        isRead[index] = true;
+        appendReadSlides();
+        return !isFull && !isPastDeadline();
+    };
+    ooxml::PartPool(archive()).run(slideNames, readSlide);
+    appendReadSlides();
+
+    for (const auto& text : templateTexts) {
+        if (isFull || !appendText(text)) {
             // Truncation occurred, stop processing
             break;
         }
@@ -58,4 +122,133 @@ int Pptx::convert(bool addStyle, bool extractImages, char mergingMode) {
     return 0;
 }
 
+// private:
+std::vector<Pptx::Relationship> Pptx::getRelationships(std::string_view relsXml, std::string_view type) {
+    std::vector<Relationship> relationships;
+    ooxml::XmlReader reader(relsXml);
+    for (auto token = reader.next(); token != ooxml::XmlReader::Token::End; token = reader.next()) {
+        if (token != ooxml::XmlReader::Token::StartElement || reader.name() != "Relationship")
+            continue;
+        const std::string_view relType = reader.rawAttribute("Type");
+        if (relType.size() < type.size() || relType.substr(relType.size() - type.size()) != type ||
+            reader.rawAttribute("TargetMode") == "External")
+            continue;
+        relationships.push_back({reader.attribute("Id"), reader.attribute("Target")});
+    }
+    return relationships;
+}
+
+std::vector<std::string> Pptx::resolveIdList(const pugi::xml_node& idList,
+                                             const std::vector<Relationship>& relationships, size_t limit) {
+    std::unordered_map<std::string_view, std::string_view> targets;
+    for (const auto& relationship : relationships)
+        targets.emplace(relationship.id, relationship.target);
+
+    std::vector<std::string> partNames;
+    for (const auto& id : idList) {
+        if (limit > 0 && partNames.size() >= limit)
+            break;
+        const auto target = targets.find(id.attribute("r:id").value());
+        if (target != targets.end())
+            partNames.push_back(ooxml::resolveTarget("ppt/presentation.xml", target->second));
+    }
+    return partNames;
+}
+
+std::vector<std::string> Pptx::getTemplateNames(const std::vector<std::string>& masters) const {
+    std::vector<std::string> partNames;
+    std::string relsXml;
+    for (const auto& master : masters) {
+        partNames.push_back(master);
+        if (!extractFile(ooxml::relationshipsPart(master), relsXml))
+            continue;
+        for (const auto& layout : getRelationships(relsXml, "/slideLayout"))
+            partNames.push_back(ooxml::resolveTarget(master, layout.target));
+    }
+    return partNames;
+}
+
+std::string Pptx::getNotesText(const std::string& slideName, const ooxml::PartPool::Reader& reader) const {
+    std::string content;
+    if (!reader.read(ooxml::relationshipsPart(slideName), content))
+        return std::string();
+    const std::vector<Relationship> notes = getRelationships(content, "/notesSlide");
+    if (notes.empty() || !reader.read(ooxml::resolveTarget(slideName, notes.front().target), content))
+        return std::string();
+    return getSlideText(content);
+}
+
+std::string Pptx::getSlideText(std::string_view xml) const {
+    std::string content;
+    if (m_fastText) {
+        // One branch of alternate content is read, as in the normal mode
+        const ooxml::TextScanner scanner("a:t", "a:p");
+        scanner.scan(xml, content, [&content](ooxml::TextScanner::Event event) {
+            if (event == ooxml::TextScanner::Event::BlockStart)
+                content += '\n';
+            return true;
+        });
+        return content;
+    }
+
+    // Only text runs and paragraph starts matter. Of every mc:AlternateContent
+    // one branch is read, the other subtree is skipped unparsed
+    bool inText = false;
+    std::vector<bool> branchTaken;
+    ooxml::XmlReader reader(xml);
+    for (auto token = reader.next(); token != ooxml::XmlReader::Token::End; token = reader.next()) {
+        switch (token) {
+        case ooxml::XmlReader::Token::StartElement: {
+            switch (ooxml::tagOf(reader.name())) {
+            case ooxml::XmlTag::AT:
+                inText = true;
+                break;
+            case ooxml::XmlTag::AP:
+                content += '\n';
+                break;
+            case ooxml::XmlTag::McAlternateContent:
+                branchTaken.push_back(false);
+                break;
+            case ooxml::XmlTag::McChoice:
+                if (branchTaken.empty() || branchTaken.back() ||
+                    !ooxml::isUnderstoodChoice(reader.rawAttribute("Requires")))
+                    reader.skipElement();
+                else
+                    branchTaken.back() = true;
+                break;
+            case ooxml::XmlTag::McFallback:
+                if (branchTaken.empty() || branchTaken.back())
+                    reader.skipElement();
+                else
+                    branchTaken.back() = true;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+        case ooxml::XmlReader::Token::EndElement:
+            switch (ooxml::tagOf(reader.name())) {
+            case ooxml::XmlTag::AT:
+                inText = false;
+                break;
+            case ooxml::XmlTag::McAlternateContent:
+                if (!branchTaken.empty())
+                    branchTaken.pop_back();
+                break;
+            default:
+                break;
+            }
+            break;
+        case ooxml::XmlReader::Token::Text:
+            if (inText)
+                content += reader.text();
+            break;
+        default:
+            break;
+        }
+    }
+    return content;
+}
+
 }  // End namespace
@@ -15,6 +15,7 @@
 
 #include "fileext/fileext.hpp"
 #include "fileext/ooxml/ooxml.hpp"
+#include "fileext/ooxml/partpool.hpp"
 
 
 /**
@@ -31,6 +32,18 @@ namespace pptx {
  */
 class Pptx: public fileext::FileExtension, public ooxml::Ooxml {
 public:
+	/** Parts to extract */
+	enum Part : unsigned {
+		/** Slides */
+		PartSlides  = 1 << 0,
+		/** Speaker notes, each after the text of its slide */
+		PartNotes   = 1 << 1,
+		/** Slide masters and their layouts, after all slides */
+		PartMasters = 1 << 2,
+		/** Everything */
+		PartAll     = (1 << 3) - 1
+	};
+
 	/**
 	 * @param[in] fileName
 	 *     File name
@@ -54,7 +67,114 @@ public:
 	 */
     int convert(bool addStyle = true, bool extractImages = false, char mergingMode = 0) override;
 
+    /**
+     * @brief
+     *     Limit number of slides read
+     * @param[in] maxSlides
+     *     First slides to read in presentation order, 0 for all
+     * @since 1.2
+     */
+    void setMaxSlides(size_t maxSlides) { m_maxSlides = maxSlides; }
+
+    /**
+     * @brief
+     *     Select parts to extract
+     * @details
+     *     Notes of a slide are found through its relationships, on the
+     *     thread reading the slide. With anything besides slides selected,
+     *     paragraphs of masters, layouts and notes (footers, notices,
+     *     placeholders) are kept only once; see fileext::ParagraphDedupe.
+     * @param[in] parts
+     *     `Part` flags, PartSlides by default
+     * @since 1.2
+     */
+    void setParts(unsigned parts) { m_parts = parts; }
+
 private:
+    /**
+     * @brief
+     *     Relationship of part
+     */
+    struct Relationship {
+        /** Relationship id */
+        std::string id;
+        /** Target as written (relative to the source part) */
+        std::string target;
+    };
+
+    /**
+     * @brief
+     *     Get internal relationships of one type
+     * @param[in] relsXml
+     *     Relationships part content
+     * @param[in] type
+     *     End of relationship type, e.g. `/slide`
+     * @return
+     *     Relationships in part order
+     * @since 1.2
+     */
+    static std::vector<Relationship> getRelationships(std::string_view relsXml, std::string_view type);
+
+    /**
+     * @brief
+     *     Resolve id list of `ppt/presentation.xml` to part names
+     * @details
+     *     The list (`p:sldIdLst`, `p:sldMasterIdLst`) gives the order, its
+     *     relationship ids are resolved through `ppt/_rels/presentation.xml.rels`.
+     *     Ids without relationship are dropped, nothing is looked up in the archive.
+     * @param[in] idList
+     *     Id list node
+     * @param[in] relationships
+     *     Presentation relationships of list type
+     * @param[in] limit
+     *     Maximum number of parts, 0 for all
+     * @return
+     *     Part names in list order
+     * @since 1.2
+     */
+    static std::vector<std::string> resolveIdList(const pugi::xml_node& idList,
+                                                  const std::vector<Relationship>& relationships, size_t limit);
+
+    /**
+     * @brief
+     *     Get slide master and layout part names
+     * @details
+     *     Every master is followed by its layouts, in order of master relationships
+     * @param[in] masters
+     *     Master part names
+     * @return
+     *     Part names
+     * @since 1.2
+     */
+    std::vector<std::string> getTemplateNames(const std::vector<std::string>& masters) const;
+
+    /**
+     * @brief
+     *     Get notes text of slide
+     * @param[in] slideName
+     *     Slide part name
+     * @param[in] reader
+     *     Reader of the pool thread
+     * @return
+     *     Notes text, empty if slide has no notes
+     * @since 1.2
+     */
+    std::string getNotesText(const std::string& slideName, const ooxml::PartPool::Reader& reader) const;
+
+    /**
+     * @brief
+     *     Get slide text
+     * @details
+     *     Slide is read with the pull reader, only `a:t` text and `a:p`
+     *     boundaries are kept
+     * @param[in] xml
+     *     Slide part content
+     * @return
+     *     Slide text, each paragraph starts with a line break
+     * @since 1.2
+     */
+    std::string getSlideText(std::string_view xml) const;
+
     /// @name General
     /// @{
     /**
@@ -470,6 +590,10 @@ private:
 	std::vector<pugi::xml_node> m_visitedNodeList;
 	/** Stores table border style */
 	std::unordered_map<std::string, std::string> m_borderMap;
+	/** Slide limit, 0 for all */
+	size_t m_maxSlides = 0;
+	/** Parts to extract */
+	unsigned m_parts = PartSlides;
 };
 
 }  // End namespace
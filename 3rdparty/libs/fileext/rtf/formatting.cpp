@@ -98,6 +98,7 @@ Formatting& Formatting::operator=(const Formatting& obj) {
 }
 
 
+#ifndef DOCPARSER_TEXT_ONLY
 // HtmlText public:
 HtmlText::HtmlText(const Formatting& format, bool addStyle)
 : m_format(format), m_addStyle(addStyle) {
@@ -157,5 +158,6 @@ void HtmlText::addStyle(pugi::xml_node& node, const std::string& styleName,
 		}
 	}
 }
+#endif  // DOCPARSER_TEXT_ONLY
 
 }  // End namespace
@@ -197,6 +197,7 @@ public:
 };
 
 
+#ifndef DOCPARSER_TEXT_ONLY
 /**
  * @class HtmlText
  * @brief
@@ -369,5 +370,6 @@ void HtmlText::add(T str) {
 	m_formatStack.emplace_back(m_format);
 	m_text += str;
 }
+#endif  // DOCPARSER_TEXT_ONLY
 
 }  // End namespace
@@ -74,8 +74,10 @@ private:
 	 */
 	std::string codeToText(std::string::iterator& it);
 
+#ifndef DOCPARSER_TEXT_ONLY
 	/** List of HTML-nodes */
 	std::vector<pugi::xml_node> m_nodeList;
+#endif
 	/** if iterator in list */
 	bool m_isUl = false;
 	/** if iterator in bullet list */
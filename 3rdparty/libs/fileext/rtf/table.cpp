@@ -16,6 +16,7 @@
 
 namespace rtf {
 
+#ifndef DOCPARSER_TEXT_ONLY
 // TableCellDef
 bool TableCellDef::rightEquals(int right) {
 	return (right == m_right);
@@ -151,5 +152,6 @@ void Table::addSubtree(const pugi::xml_node& from, pugi::xml_node& to) const {
 	for (const auto& child : parentNode)
 		to.append_copy(child);
 }
+#endif  // DOCPARSER_TEXT_ONLY
 
 }  // End namespace
@@ -19,7 +19,6 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "xlsb.h"
-#include "../ooxml/ooxml.hpp"
 
 namespace xlsb {
 
@@ -72,6 +71,8 @@ Xlsb::Xlsb(const std::string &fileName)
 
 int Xlsb::convert(bool addStyle, bool extractImages, char mergingMode)
 {
+    openArchive(m_fileName);
+
     if (!parseSharedStrings())
         return -1;
     if (!parseWorkSheets(m_text))
@@ -202,17 +203,23 @@ bool Xlsb::readRecord(Xlsb::Record &record)
     if (m_buffer.empty())
         return false;
 
+    // The part may be a view into the mapped package: a read at the very end yields 0
+    auto nextByte = [this]() -> uint32_t {
+        char byte = m_readed < m_buffer.size() ? m_buffer[m_readed] : '\0';
+        ++m_readed;
+        return byte;
+    };
+
     for (int i = 0; i < 2 && m_readed <= m_buffer.size(); ++i) {
-        uint32_t byte = m_buffer[m_readed++];
+        uint32_t byte = nextByte();
         record.m_type += ((byte & 0x7F) << (i * 7));
         if (byte < 128)
             break;
     }
 
-    int a = m_buffer.length();
     for (int i = 0; i < 4 && m_readed <= m_buffer.size(); ++i)	//read record size
     {
-        uint32_t byte = m_buffer[m_readed++];
+        uint32_t byte = nextByte();
         record.m_size += ((byte & 0x7F) << (i * 7));
         if (byte < 128)
             break;
@@ -348,7 +355,7 @@ bool Xlsb::parseRecordForWorksheets(Xlsb::Record &record, std::string &text)
 bool Xlsb::parseSharedStrings()
 {
     m_readed = 0;
-    ooxml::Ooxml::extractFile(m_fileName, "xl/sharedStrings.bin", m_buffer);
+    extractFile("xl/sharedStrings.bin", m_buffer, m_storage);
 
     while (m_readed <= m_buffer.size()) {
         Record record;
@@ -374,10 +381,8 @@ bool Xlsb::parseWorkSheets(std::string &text)
 {
     std::string sheetFileName = "xl/worksheets/sheet1.bin";
     int sheetIndex = 1;
-    while (ooxml::Ooxml::exists(m_fileName, sheetFileName)) {
+    while (extractFile(sheetFileName, m_buffer, m_storage)) {
         m_readed = 0;
-        m_buffer.clear();
-        ooxml::Ooxml::extractFile(m_fileName, sheetFileName, m_buffer);
 
         while (m_readed < m_buffer.size()) {
             Record record;
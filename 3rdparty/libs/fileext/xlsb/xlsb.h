@@ -22,13 +22,15 @@
 #define XLSB_H
 
 #include "fileext/fileext.hpp"
+#include "fileext/ooxml/ooxml.hpp"
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace xlsb {
 
-class Xlsb : public fileext::FileExtension
+class Xlsb : public fileext::FileExtension, public ooxml::Ooxml
 {
 public:
     enum RecordType
@@ -88,7 +90,9 @@ private:
     std::vector<std::string> m_sharedStrings;
     ulong m_readed = 0;
     int m_pointer = 0;
-    std::string m_buffer;
+    /** Current part: stored parts point into the mapped package, others into m_storage */
+    std::string_view m_buffer;
+    std::string m_storage;
 
     uint32_t m_currentColumn = 0;
     uint32_t m_currentRow = 0;
@@ -101,9 +101,14 @@ void createDir(const std::string& name) {
 	os_mkdir(path);
 }
 
+const std::string& tempDir() {
+	static const std::string path = getProgramPath() + "/files/temp";
+	return path;
+}
+
 std::string createTempDir() {
-	std::string mask = TEMP_DIR + "/XXXXXX";
-	createDir(TEMP_DIR);
+	std::string mask = tempDir() + "/XXXXXX";
+	createDir(tempDir());
 	return os_mkdtemp(&mask[0]);
 }
 
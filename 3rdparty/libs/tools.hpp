@@ -8,8 +8,12 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "pugixml.hpp"
@@ -98,6 +102,15 @@ namespace tools {
 	 */
 	void createDir(const std::string& name);
 
+	/**
+	 * @brief
+	 *     Get temp directory path. Resolved on first call, not at library load
+	 * @return
+	 *     Temp directory path
+	 * @since 1.4
+	 */
+	const std::string& tempDir();
+
 	/**
 	 * @brief
 	 *     Create temp directory
@@ -567,11 +580,84 @@ namespace tools {
 	char hexCharToDec(char c);
 	/// @}
 
-	/** Current executable file absolute path */
-	const std::string PROGRAM_PATH = getProgramPath();
-	/** Temp directory path */
-	const std::string TEMP_DIR = PROGRAM_PATH + "/files/temp";
 	/** Hex string char list */
 	const char HEX_DATA[] = "0123456789ABCDEF";
 
+	/// @name Lookup tables
+	/// @{
+	/**
+	 * @brief
+	 *     Entry of constant lookup table. Tables are plain arrays sorted by key,
+	 *     so they need no constructors at library load
+	 * @since 1.4
+	 */
+	template<typename Key, typename Value>
+	struct TableEntry {
+		Key key;
+		Value value;
+	};
+
+	/**
+	 * @brief
+	 *     Check if table keys are strictly ascending (use in static_assert)
+	 * @param[in] table
+	 *     Lookup table
+	 * @return
+	 *     True if table can be searched with findInTable()
+	 * @since 1.4
+	 */
+	template<typename Key, typename Value, size_t N>
+	constexpr bool isSortedTable(const TableEntry<Key, Value> (&table)[N]) {
+		for (size_t i = 1; i < N; ++i) {
+			if (!(table[i - 1].key < table[i].key))
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief
+	 *     Binary search in sorted lookup table
+	 * @param[in] table
+	 *     Lookup table
+	 * @param[in] key
+	 *     Key to find (must be convertible to table key type)
+	 * @return
+	 *     Pointer to value or nullptr if key was not found
+	 * @since 1.4
+	 */
+	template<typename Key, typename Value, size_t N, typename Lookup>
+	const Value* findInTable(const TableEntry<Key, Value> (&table)[N], const Lookup& key) {
+		const Key k(key);
+		auto it = std::lower_bound(std::begin(table), std::end(table), k,
+			[](const TableEntry<Key, Value>& entry, const Key& value) {
+				return entry.key < value;
+			});
+		if (it == std::end(table) || k < it->key)
+			return nullptr;
+		return &it->value;
+	}
+
+	/**
+	 * @brief
+	 *     Same as findInTable(), but throws like std::unordered_map::at()
+	 * @param[in] table
+	 *     Lookup table
+	 * @param[in] key
+	 *     Key to find
+	 * @return
+	 *     Value reference
+	 * @throw std::out_of_range
+	 *     If key was not found
+	 * @since 1.4
+	 */
+	template<typename Key, typename Value, size_t N, typename Lookup>
+	const Value& tableAt(const TableEntry<Key, Value> (&table)[N], const Lookup& key) {
+		const Value* value = findInTable(table, key);
+		if (!value)
+			throw std::out_of_range("Key not found in lookup table");
+		return *value;
+	}
+	/// @}
+
 }  // End namespace
@@ -172,7 +172,7 @@ std::tuple<std::string, bool> Package::ReadZipFileString(const std::string &file
         std::tie(content, ok) = m_zip->ReadFileString(fileinzip);
     }
 
-    return std::make_tuple(content, ok);
+    return std::make_tuple(std::move(content), ok);
 }
 
 // ======== Package::ReadZipFileRaw() ========
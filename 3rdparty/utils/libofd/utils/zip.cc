@@ -1,6 +1,10 @@
 #include "utils/utils.h"
 #include "utils/zip.h"
 #include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define ZIP_DISABLE_DEPRECATED
 #include <zip.h>
@@ -14,6 +18,7 @@ public:
     ~ImplCls();
 
     bool Open(const std::string &filename, bool bWrite);
+    bool OpenMapped(const std::string &filename);
     void Close();
 
     std::tuple<std::string, bool> ReadFileString(const std::string &fileinzip) const;
@@ -25,10 +30,13 @@ public:
 public:
     Zip *m_zip;
     zip *m_archive;
+    // Read-only archives are served from a mapping of the whole package
+    void *m_map;
+    size_t m_mapSize;
 };
 
 
-Zip::ImplCls::ImplCls(Zip *zip) : m_zip(zip), m_archive(nullptr) {
+Zip::ImplCls::ImplCls(Zip *zip) : m_zip(zip), m_archive(nullptr), m_map(nullptr), m_mapSize(0) {
 }
 
 Zip::ImplCls::~ImplCls(){
@@ -41,7 +49,7 @@ bool Zip::ImplCls::Open(const std::string &filename, bool bWrite){
     if ( bWrite ){
         //m_archive = zip_open(filename.c_str(), ZIP_CREATE | ZIP_EXCL, &error);
         m_archive = zip_open(filename.c_str(), ZIP_CREATE, &error);
-    } else {
+    } else if ( !OpenMapped(filename) ){
         m_archive = zip_open(filename.c_str(), 0, &error);
     }
 
@@ -57,11 +65,62 @@ bool Zip::ImplCls::Open(const std::string &filename, bool bWrite){
     return true;
 }
 
+bool Zip::ImplCls::OpenMapped(const std::string &filename){
+    int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if ( fd == -1 ){
+        return false;
+    }
+
+    struct stat st;
+    if ( fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0 ){
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if ( map == MAP_FAILED ){
+        return false;
+    }
+    // OFD pages, fonts and resources are all read while rendering the text
+    madvise(map, size, MADV_WILLNEED);
+
+    zip_error_t error;
+    zip_error_init(&error);
+    zip_source_t *source = zip_source_buffer_create(map, size, 0, &error);
+    if ( source != nullptr ){
+        m_archive = zip_open_from_source(source, ZIP_RDONLY, &error);
+        if ( m_archive == nullptr ){
+            zip_source_free(source);
+        }
+    }
+    zip_error_fini(&error);
+
+    if ( m_archive == nullptr ){
+        munmap(map, size);
+        return false;
+    }
+
+    m_map = map;
+    m_mapSize = size;
+    return true;
+}
+
 void Zip::ImplCls::Close(){
     if ( m_archive != nullptr ){
-        zip_close(m_archive);
+        if ( m_map != nullptr ){
+            zip_discard(m_archive);
+        } else {
+            zip_close(m_archive);
+        }
         m_archive = nullptr;
     }
+    if ( m_map != nullptr ){
+        munmap(m_map, m_mapSize);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
 }
 
 std::tuple<std::string, bool> Zip::ImplCls::ReadFileString(const std::string &fileinzip) const{
@@ -79,23 +138,21 @@ std::tuple<std::string, bool> Zip::ImplCls::ReadFileString(const std::string &fi
 
         zip_file *file = zip_fopen(m_archive, fileinzip.c_str(), ZIP_FL_NOCASE);
         if (file) {
-            char *content = new char[filesize + 1];
-            size_t did_read = zip_fread(file, content, filesize);
+            // Inflate directly into the returned string, no intermediate buffer
+            fileContent.resize(filesize);
+            zip_int64_t did_read = zip_fread(file, &fileContent[0], filesize);
 //            LOG(DEBUG) << "did_read:" << did_read << " filesize:" << filesize;
-            if (did_read != filesize ) {
+            if (did_read < 0 || static_cast<size_t>(did_read) != filesize ) {
 //                LOG(WARNING) << "File " << fileinzip << " readed " << did_read << " bytes, but is not equal to excepted filesize " << filesize << " bytes.";
-                delete[] content;
+                fileContent.clear();
             } else {
-                content[filesize] = '\0';
-                fileContent = std::string(content);
                 ok = true;
-                delete[] content;
             }
             zip_fclose(file);
         }
     }
 
-    return std::make_tuple(fileContent, ok);
+    return std::make_tuple(std::move(fileContent), ok);
 }
 
 std::tuple<char*, size_t, bool> Zip::ImplCls::ReadFileRaw(const std::string &fileinzip) const {
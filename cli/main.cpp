@@ -0,0 +1,666 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "docparser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/** Marker appended by DocParser::convertFile when the output was cut at maxBytes */
+const std::string TRUNCATION_MARKER = "\n[CONTENT_TRUNCATED]";
+/** Upper bound of queued paths, keeps memory flat while crawling huge trees */
+const size_t MAX_QUEUED_JOBS = 4096;
+
+struct Options
+{
+    size_t maxBytes = 0;
+    unsigned threads = 0;
+    bool jobsFromStdin = false;
+    bool withText = true;
+    bool printStats = false;
+    unsigned fastText = DocParser::FastTextNone;
+    unsigned docxParts = DocParser::DocxBody;
+    unsigned pptxParts = DocParser::PptxSlides;
+    size_t embeddedDepth = 0;
+    size_t maxNesting = DocParser::Options().maxNesting;
+    size_t maxSlides = 0;
+    std::string sidecarDir;
+    std::vector<std::string> inputs;
+    /** Filled from the flags above once they are parsed */
+    DocParser::Options conversion;
+};
+
+struct Job
+{
+    size_t index = 0;
+    std::string path;
+};
+
+/**
+ * @brief Bounded multi-producer / multi-consumer job queue
+ */
+class JobQueue
+{
+public:
+    void push(Job job)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_jobs.size() < MAX_QUEUED_JOBS; });
+        m_jobs.push_back(std::move(job));
+        m_notEmpty.notify_one();
+    }
+
+    std::optional<Job> pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return !m_jobs.empty() || m_closed; });
+        if (m_jobs.empty())
+            return std::nullopt;
+
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_notFull.notify_one();
+        return job;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::deque<Job> m_jobs;
+    bool m_closed = false;
+};
+
+struct Stats
+{
+    std::atomic<size_t> files { 0 };
+    std::atomic<size_t> failed { 0 };
+    std::atomic<size_t> inputBytes { 0 };
+    std::atomic<size_t> textBytes { 0 };
+};
+
+/**
+ * @brief Extract lowercase file extension, the same way the library selects a parser
+ */
+std::string detectFormat(const std::string &path)
+{
+    std::string name = fs::path(path).filename().string();
+    size_t dotPos = name.find_last_of('.');
+    if (dotPos == std::string::npos || dotPos == name.length() - 1)
+        return "unknown";
+
+    std::string suffix = name.substr(dotPos + 1);
+    std::transform(suffix.begin(), suffix.end(), suffix.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return suffix;
+}
+
+/**
+ * @brief Length of the valid UTF-8 sequence starting at @p pos, or 0 if it is invalid
+ */
+size_t utf8SequenceLength(const std::string &text, size_t pos)
+{
+    const auto *s = reinterpret_cast<const unsigned char *>(text.data()) + pos;
+    size_t left = text.size() - pos;
+
+    if (s[0] < 0x80)
+        return 1;
+
+    size_t len = 0;
+    unsigned char min = 0x80, max = 0xBF;
+    if (s[0] >= 0xC2 && s[0] <= 0xDF) {
+        len = 2;
+    } else if (s[0] >= 0xE0 && s[0] <= 0xEF) {
+        len = 3;
+        if (s[0] == 0xE0)
+            min = 0xA0;
+        else if (s[0] == 0xED)
+            max = 0x9F;
+    } else if (s[0] >= 0xF0 && s[0] <= 0xF4) {
+        len = 4;
+        if (s[0] == 0xF0)
+            min = 0x90;
+        else if (s[0] == 0xF4)
+            max = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (left < len || s[1] < min || s[1] > max)
+        return 0;
+    for (size_t i = 2; i < len; ++i) {
+        if (s[i] < 0x80 || s[i] > 0xBF)
+            return 0;
+    }
+    return len;
+}
+
+/**
+ * @brief Append @p text as a JSON string literal, replacing invalid UTF-8 with U+FFFD
+ */
+void appendJsonString(std::string &out, const std::string &text)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    out += '"';
+    for (size_t i = 0; i < text.size();) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x80) {
+            size_t len = utf8SequenceLength(text, i);
+            if (len == 0) {
+                out += "\xEF\xBF\xBD";
+                ++i;
+            } else {
+                out.append(text, i, len);
+                i += len;
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            if (c < 0x20) {
+                out += "\\u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 0x0F];
+            } else {
+                out += static_cast<char>(c);
+            }
+        }
+        ++i;
+    }
+    out += '"';
+}
+
+/**
+ * @brief Cut @p text to at most @p maxBytes without splitting a UTF-8 sequence
+ */
+void truncateUtf8(std::string &text, size_t maxBytes)
+{
+    if (text.size() <= maxBytes)
+        return;
+
+    size_t end = maxBytes;
+    while (end > 0 && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80)
+        --end;
+    text.resize(end);
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+std::string formatMs(double ms)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", ms);
+    return buffer;
+}
+
+class Runner
+{
+public:
+    explicit Runner(const Options &options)
+        : m_options(options) {}
+
+    void processJob(const Job &job)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::string status = "ok";
+        std::string error;
+        std::string text;
+        bool truncated = false;
+        size_t inputSize = 0;
+        double convertMs = 0;
+
+        std::error_code ec;
+        inputSize = static_cast<size_t>(fs::file_size(job.path, ec));
+        if (ec) {
+            status = "error";
+            error = ec.message();
+            inputSize = 0;
+        } else {
+            const auto convertStart = std::chrono::steady_clock::now();
+            try {
+                text = m_options.maxBytes > 0
+                        ? DocParser::convertFile(job.path, m_options.maxBytes, m_options.conversion)
+                        : DocParser::convertFile(job.path, m_options.conversion);
+            } catch (const std::exception &e) {
+                status = "error";
+                error = e.what();
+            } catch (...) {
+                status = "error";
+                error = "unknown error";
+            }
+            convertMs = elapsedMs(convertStart);
+
+            if (m_options.maxBytes > 0) {
+                if (text.size() >= TRUNCATION_MARKER.size()
+                    && text.compare(text.size() - TRUNCATION_MARKER.size(), TRUNCATION_MARKER.size(),
+                                    TRUNCATION_MARKER) == 0) {
+                    text.resize(text.size() - TRUNCATION_MARKER.size());
+                    truncated = true;
+                }
+                // Small files take the untruncated path, but their text can still outgrow the limit
+                if (text.size() > m_options.maxBytes) {
+                    truncateUtf8(text, m_options.maxBytes);
+                    truncated = true;
+                }
+            }
+
+            if (status == "ok" && text.empty())
+                status = "empty";
+        }
+
+        std::string sidecarFile;
+        if (!m_options.sidecarDir.empty() && !text.empty()) {
+            sidecarFile = (fs::path(m_options.sidecarDir) / (std::to_string(job.index) + ".txt")).string();
+            std::ofstream out(sidecarFile, std::ios::binary | std::ios::trunc);
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!out) {
+                status = "error";
+                error = "failed to write " + sidecarFile;
+                sidecarFile.clear();
+            }
+        }
+
+        m_stats.files++;
+        m_stats.inputBytes += inputSize;
+        m_stats.textBytes += text.size();
+        if (status == "error")
+            m_stats.failed++;
+
+        std::string line;
+        line.reserve(256 + (m_options.withText && sidecarFile.empty() ? text.size() + text.size() / 8 : 0));
+        line += "{\"path\":";
+        appendJsonString(line, job.path);
+        line += ",\"format\":";
+        appendJsonString(line, detectFormat(job.path));
+        line += ",\"status\":\"" + status + "\"";
+        if (!error.empty()) {
+            line += ",\"error\":";
+            appendJsonString(line, error);
+        }
+        line += ",\"truncated\":";
+        line += truncated ? "true" : "false";
+        line += ",\"input_bytes\":" + std::to_string(inputSize);
+        line += ",\"text_bytes\":" + std::to_string(text.size());
+        line += ",\"convert_ms\":" + formatMs(convertMs);
+        line += ",\"total_ms\":" + formatMs(elapsedMs(start));
+        if (!sidecarFile.empty()) {
+            line += ",\"text_file\":";
+            appendJsonString(line, sidecarFile);
+        } else if (m_options.withText) {
+            line += ",\"text\":";
+            appendJsonString(line, text);
+        }
+        line += "}\n";
+
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        fwrite(line.data(), 1, line.size(), stdout);
+        fflush(stdout);
+    }
+
+    void enqueue(const std::string &path)
+    {
+        m_queue.push({ m_nextIndex++, path });
+    }
+
+    /**
+     * @brief Enqueue a file, or every regular file below a directory
+     */
+    void crawl(const std::string &input)
+    {
+        std::error_code ec;
+        if (!fs::is_directory(input, ec)) {
+            enqueue(input);
+            return;
+        }
+
+        fs::recursive_directory_iterator it(input, fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_regular_file(ec))
+                enqueue(it->path().string());
+        }
+        if (ec)
+            std::cerr << "WARNING: [docparser-cli] Failed to crawl " << input << ": " << ec.message() << std::endl;
+    }
+
+    void run()
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        unsigned threads = m_options.threads;
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] {
+                while (auto job = m_queue.pop())
+                    processJob(*job);
+            });
+        }
+
+        for (const auto &input : m_options.inputs)
+            crawl(input);
+
+        if (m_options.jobsFromStdin) {
+            std::string path;
+            while (std::getline(std::cin, path)) {
+                if (!path.empty() && path.back() == '\r')
+                    path.pop_back();
+                if (!path.empty())
+                    crawl(path);
+            }
+        }
+
+        m_queue.close();
+        for (auto &worker : workers)
+            worker.join();
+
+        if (m_options.printStats) {
+            double seconds = elapsedMs(start) / 1000.0;
+            double mb = static_cast<double>(m_stats.inputBytes) / (1024.0 * 1024.0);
+            fprintf(stderr, "files: %zu, failed: %zu, input: %.2f MiB, text: %zu bytes, threads: %u\n",
+                    m_stats.files.load(), m_stats.failed.load(), mb, m_stats.textBytes.load(), threads);
+            fprintf(stderr, "elapsed: %.3f s, %.1f files/s, %.2f MiB/s\n", seconds,
+                    seconds > 0 ? m_stats.files / seconds : 0.0, seconds > 0 ? mb / seconds : 0.0);
+        }
+    }
+
+    bool hasFailures() const { return m_stats.failed > 0; }
+
+private:
+    const Options &m_options;
+    JobQueue m_queue;
+    Stats m_stats;
+    std::mutex m_outputMutex;
+    size_t m_nextIndex = 0;
+};
+
+void printUsage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options] [file|directory]...\n"
+            "Extract text from documents and print one JSON object per file.\n"
+            "\n"
+            "Options:\n"
+            "  -m, --max-bytes N      Truncate the text of each file to N bytes\n"
+            "  -t, --threads N        Number of worker threads (default: number of CPUs)\n"
+            "  -s, --jobs-from-stdin  Read additional paths from stdin, one per line\n"
+            "  -o, --sidecar-dir DIR  Write text to DIR/<index>.txt instead of the JSON line\n"
+            "  -n, --no-text          Omit text from the output (throughput checks)\n"
+            "  -S, --stats            Print a throughput summary to stderr\n"
+            "  -f, --fast-text LIST   Fast text-run extraction for docx,pptx,xlsx or all\n"
+            "  -p, --docx-parts LIST  Docx parts: body,headers,footers,footnotes,endnotes,\n"
+            "                         comments,textboxes or all (default: body)\n"
+            "  -P, --pptx-parts LIST  Pptx parts: slides,notes,masters or all (default: slides)\n"
+            "  -e, --embedded DEPTH   Append text of embedded documents, up to DEPTH levels\n"
+            "  -l, --max-slides N     Read only the first N slides of pptx files (default: all)\n"
+            "  -N, --max-nesting N    Skip docx/odf tables and text boxes nested deeper than N\n"
+            "                         levels (default: 256)\n"
+            "  -h, --help             Show this help\n",
+            program);
+}
+
+bool parseNumber(const char *value, size_t &result)
+{
+    if (!value || !*value)
+        return false;
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long number = strtoull(value, &end, 10);
+    if (errno != 0 || *end != '\0' || value[0] == '-')
+        return false;
+    result = static_cast<size_t>(number);
+    return true;
+}
+
+bool parseFastText(const char *value, unsigned &formats)
+{
+    if (!value || !*value)
+        return false;
+    std::string list = value;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string format = list.substr(begin, end - begin);
+        if (format == "docx")
+            formats |= DocParser::FastTextDocx;
+        else if (format == "pptx")
+            formats |= DocParser::FastTextPptx;
+        else if (format == "xlsx")
+            formats |= DocParser::FastTextXlsx;
+        else if (format == "all")
+            formats |= DocParser::FastTextAll;
+        else
+            return false;
+        begin = end + 1;
+    }
+    return true;
+}
+
+bool parseDocxParts(const char *value, unsigned &parts)
+{
+    if (!value || !*value)
+        return false;
+    parts = 0;
+    std::string list = value;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string part = list.substr(begin, end - begin);
+        if (part == "body")
+            parts |= DocParser::DocxBody;
+        else if (part == "headers")
+            parts |= DocParser::DocxHeaders;
+        else if (part == "footers")
+            parts |= DocParser::DocxFooters;
+        else if (part == "footnotes")
+            parts |= DocParser::DocxFootnotes;
+        else if (part == "endnotes")
+            parts |= DocParser::DocxEndnotes;
+        else if (part == "comments")
+            parts |= DocParser::DocxComments;
+        else if (part == "textboxes")
+            parts |= DocParser::DocxTextBoxes;
+        else if (part == "all")
+            parts |= DocParser::DocxAllParts;
+        else
+            return false;
+        begin = end + 1;
+    }
+    return true;
+}
+
+bool parsePptxParts(const char *value, unsigned &parts)
+{
+    if (!value || !*value)
+        return false;
+    parts = 0;
+    std::string list = value;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string part = list.substr(begin, end - begin);
+        if (part == "slides")
+            parts |= DocParser::PptxSlides;
+        else if (part == "notes")
+            parts |= DocParser::PptxNotes;
+        else if (part == "masters")
+            parts |= DocParser::PptxMasters;
+        else if (part == "all")
+            parts |= DocParser::PptxAllParts;
+        else
+            return false;
+        begin = end + 1;
+    }
+    return true;
+}
+
+/**
+ * @return 0 on success, exit code otherwise
+ */
+int parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return -1;
+        } else if (arg == "-m" || arg == "--max-bytes") {
+            if (!parseNumber(nextValue(), options.maxBytes)) {
+                fprintf(stderr, "Error: --max-bytes expects a number\n");
+                return 2;
+            }
+        } else if (arg == "-t" || arg == "--threads") {
+            size_t threads = 0;
+            if (!parseNumber(nextValue(), threads)) {
+                fprintf(stderr, "Error: --threads expects a number\n");
+                return 2;
+            }
+            options.threads = static_cast<unsigned>(threads);
+        } else if (arg == "-s" || arg == "--jobs-from-stdin") {
+            options.jobsFromStdin = true;
+        } else if (arg == "-o" || arg == "--sidecar-dir") {
+            const char *dir = nextValue();
+            if (!dir) {
+                fprintf(stderr, "Error: --sidecar-dir expects a directory\n");
+                return 2;
+            }
+            options.sidecarDir = dir;
+        } else if (arg == "-n" || arg == "--no-text") {
+            options.withText = false;
+        } else if (arg == "-S" || arg == "--stats") {
+            options.printStats = true;
+        } else if (arg == "-f" || arg == "--fast-text") {
+            if (!parseFastText(nextValue(), options.fastText)) {
+                fprintf(stderr, "Error: --fast-text expects docx, pptx, xlsx or all (comma separated)\n");
+                return 2;
+            }
+        } else if (arg == "-p" || arg == "--docx-parts") {
+            if (!parseDocxParts(nextValue(), options.docxParts)) {
+                fprintf(stderr, "Error: --docx-parts expects body, headers, footers, footnotes, endnotes, "
+                                "comments, textboxes or all (comma separated)\n");
+                return 2;
+            }
+        } else if (arg == "-P" || arg == "--pptx-parts") {
+            if (!parsePptxParts(nextValue(), options.pptxParts)) {
+                fprintf(stderr, "Error: --pptx-parts expects slides, notes, masters or all (comma separated)\n");
+                return 2;
+            }
+        } else if (arg == "-e" || arg == "--embedded") {
+            if (!parseNumber(nextValue(), options.embeddedDepth)) {
+                fprintf(stderr, "Error: --embedded expects a number\n");
+                return 2;
+            }
+        } else if (arg == "-l" || arg == "--max-slides") {
+            if (!parseNumber(nextValue(), options.maxSlides)) {
+                fprintf(stderr, "Error: --max-slides expects a number\n");
+                return 2;
+            }
+        } else if (arg == "-N" || arg == "--max-nesting") {
+            if (!parseNumber(nextValue(), options.maxNesting) || options.maxNesting == 0) {
+                fprintf(stderr, "Error: --max-nesting expects a positive number\n");
+                return 2;
+            }
+        } else if (arg == "--") {
+            for (++i; i < argc; ++i)
+                options.inputs.emplace_back(argv[i]);
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            fprintf(stderr, "Error: unknown option %s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+
+    if (options.inputs.empty() && !options.jobsFromStdin) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (!options.sidecarDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(options.sidecarDir, ec);
+        if (ec) {
+            fprintf(stderr, "Error: cannot create %s: %s\n", options.sidecarDir.c_str(), ec.message().c_str());
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+}   // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    int ret = parseOptions(argc, argv, options);
+    if (ret != 0)
+        return ret < 0 ? 0 : ret;
+
+    // The library logs diagnostics through std::cout; keep stdout clean for JSON lines
+    std::cout.rdbuf(std::cerr.rdbuf());
+    options.conversion.fastTextFormats = options.fastText;
+    options.conversion.docxParts = options.docxParts;
+    options.conversion.pptxParts = options.pptxParts;
+    options.conversion.embedded.maxDepth = static_cast<unsigned>(options.embeddedDepth);
+    options.conversion.pptxMaxSlides = static_cast<unsigned>(options.maxSlides);
+    options.conversion.maxNesting = static_cast<unsigned>(options.maxNesting);
+
+    Runner runner(options);
+    runner.run();
+
+    return runner.hasFailures() ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#!/bin/sh
+# SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+#
+# SPDX-License-Identifier: LGPL-3.0-or-later
+#
+# Two-stage profile guided build of libdocparser.
+#
+#   scripts/pgo/build-pgo.sh [build-root]
+#
+# Stages:
+#   1. baseline   Release build, used for comparison
+#   2. generate   instrumented build, trained with docparser-cli on a generated corpus
+#   3. use        rebuild in the same tree with the collected profiles
+#   4. bench      per-format timing of baseline vs. PGO build, printed as a Markdown table
+#
+# Environment:
+#   EXTRA_CMAKE_ARGS  additional cmake arguments (e.g. -DDOCPARSER_ENABLE_LTO=ON)
+#   CORPUS_SCALE      size multiplier for the generated corpus (default: 2)
+#   BENCH_RUNS        timed runs per format, best one is reported (default: 5)
+
+set -eu
+
+SOURCE_DIR=$(cd "$(dirname "$0")/../.." && pwd)
+BUILD_ROOT=${1:-"$SOURCE_DIR/build-pgo"}
+CORPUS_DIR="$BUILD_ROOT/corpus"
+JOBS=$(nproc 2>/dev/null || echo 4)
+EXTRA_CMAKE_ARGS=${EXTRA_CMAKE_ARGS:-}
+CORPUS_SCALE=${CORPUS_SCALE:-2}
+BENCH_RUNS=${BENCH_RUNS:-5}
+# Formats of the generated corpus, in table order
+FORMATS="docx doc xlsx xls pptx ppt odt ods odp rtf pdf txt"
+
+configure() {
+    tree=$1
+    shift
+    # shellcheck disable=SC2086
+    cmake -S "$SOURCE_DIR" -B "$tree" -DCMAKE_BUILD_TYPE=Release -DBUILD_TESTS=OFF -DBUILD_CLI=ON \
+        $EXTRA_CMAKE_ARGS "$@"
+}
+
+echo "==> Generating training corpus"
+rm -rf "$CORPUS_DIR"
+python3 "$SOURCE_DIR/scripts/pgo/gen-corpus.py" --out "$CORPUS_DIR" --scale "$CORPUS_SCALE"
+
+echo "==> Stage 1: baseline build"
+configure "$BUILD_ROOT/baseline" -DDOCPARSER_PGO=OFF
+cmake --build "$BUILD_ROOT/baseline" -j"$JOBS"
+
+echo "==> Stage 2: instrumented build and training"
+PGO_TREE="$BUILD_ROOT/pgo"
+PROFILE_DIR="$PGO_TREE/pgo-profiles"
+rm -rf "$PROFILE_DIR"
+configure "$PGO_TREE" -DDOCPARSER_PGO=GENERATE -DDOCPARSER_PGO_DIR="$PROFILE_DIR"
+cmake --build "$PGO_TREE" --target clean
+cmake --build "$PGO_TREE" -j"$JOBS"
+"$PGO_TREE/cli/docparser-cli" --no-text --stats "$CORPUS_DIR" > /dev/null
+
+if ls "$PROFILE_DIR"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -output="$PROFILE_DIR/docparser.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "==> Stage 3: optimized build"
+configure "$PGO_TREE" -DDOCPARSER_PGO=USE -DDOCPARSER_PGO_DIR="$PROFILE_DIR"
+cmake --build "$PGO_TREE" --target clean
+cmake --build "$PGO_TREE" -j"$JOBS"
+
+best_time() {
+    best=""
+    run=0
+    while [ "$run" -lt "$BENCH_RUNS" ]; do
+        t=$("$1" --threads 1 --no-text --stats "$2" 2>&1 > /dev/null | sed -n 's/^elapsed: \([0-9.]*\) s.*/\1/p')
+        if [ -z "$best" ] || awk "BEGIN { exit !($t < $best) }"; then
+            best=$t
+        fi
+        run=$((run + 1))
+    done
+    echo "$best"
+}
+
+echo "==> Stage 4: benchmark (single thread, best of $BENCH_RUNS)"
+echo
+echo "| Format | Baseline (s) | PGO (s) | Speedup |"
+echo "| ------ | ------------ | ------- | ------- |"
+for format in $FORMATS; do
+    dir="$CORPUS_DIR/$format"
+    base=$(best_time "$BUILD_ROOT/baseline/cli/docparser-cli" "$dir")
+    pgo=$(best_time "$PGO_TREE/cli/docparser-cli" "$dir")
+    awk -v f="$format" -v b="$base" -v p="$pgo" \
+        'BEGIN { printf "| %s | %.3f | %.3f | %.2fx |\n", f, b, p, (p > 0 ? b / p : 0) }'
+done
+echo
+echo "PGO build: $PGO_TREE"
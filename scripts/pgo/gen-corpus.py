@@ -0,0 +1,405 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+#
+# SPDX-License-Identifier: LGPL-3.0-or-later
+
+"""Generate a synthetic training corpus for the PGO build.
+
+Only the Python standard library is used, so the corpus can be produced on
+any build host. The documents exercise the common parser paths: docx
+paragraphs/lists/tables, xlsx shared strings and typed cells, pptx slides,
+the binary formats inside compound files (Word pieces, BIFF8 records, PPT
+record trees), ODF text/tables, RTF control words, PDF text objects and
+plain text.
+"""
+
+import argparse
+import os
+import random
+import struct
+import zipfile
+
+WORDS = ("lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor "
+         "incididunt ut labore et dolore magna aliqua 文档 解析 测试 表格 段落 & < > \"quoted\"").split()
+
+CONTENT_TYPES_HEAD = ('<?xml version="1.0" encoding="UTF-8" standalone="yes"?>'
+                      '<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">'
+                      '<Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>'
+                      '<Default Extension="xml" ContentType="application/xml"/>')
+
+
+def sentence(rng, n=12):
+    return " ".join(rng.choice(WORDS) for _ in range(n))
+
+
+def esc(text):
+    return text.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;").replace('"', "&quot;")
+
+
+def write_zip(path, parts, stored=()):
+    with zipfile.ZipFile(path, "w", zipfile.ZIP_DEFLATED) as zf:
+        for name, data in parts.items():
+            compress = zipfile.ZIP_STORED if name in stored else zipfile.ZIP_DEFLATED
+            zf.writestr(zipfile.ZipInfo(name), data, compress_type=compress)
+
+
+def write_cfb(path, streams):
+    """Write a version 3 compound file (512 byte sectors) holding the given streams.
+
+    Streams are padded to the 4096 byte mini stream cutoff, so every stream
+    lives in regular sectors and no mini FAT is needed.
+    """
+    end_of_chain, free_sector, fat_sector, no_stream = 0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0xFFFFFFFF
+    payloads = [data.ljust(max(4096, -(-len(data) // 512) * 512), b"\0") for _, data in streams]
+    dir_sectors = -(-(len(streams) + 1) // 4)
+    data_sectors = sum(len(data) // 512 for data in payloads)
+    fat_sectors = 1
+    while fat_sectors * 128 < fat_sectors + dir_sectors + data_sectors:
+        fat_sectors += 1
+    if fat_sectors > 109:
+        raise ValueError("compound file too big for the header DIFAT")
+
+    fat = [fat_sector] * fat_sectors
+
+    def chain(count):
+        start = len(fat)
+        fat.extend(range(start + 1, start + count))
+        fat.append(end_of_chain)
+        return start
+
+    dir_start = chain(dir_sectors)
+    starts = [chain(len(data) // 512) for data in payloads]
+    fat.extend([free_sector] * (fat_sectors * 128 - len(fat)))
+
+    def entry(name, kind, start, size, right=no_stream, child=no_stream):
+        raw = (name + "\0").encode("utf-16-le") if name else b""
+        return struct.pack("<64sHBBIII16sIQQIQ", raw, len(raw), kind, 1, no_stream, right, child,
+                           b"", 0, 0, 0, start, size)
+
+    # Streams hang off the root as a chain of right siblings
+    entries = [entry("Root Entry", 5, end_of_chain, 0, child=1)]
+    for i, ((name, _), data) in enumerate(zip(streams, payloads), 1):
+        entries.append(entry(name, 2, starts[i - 1], len(data), right=i + 1 if i < len(streams) else no_stream))
+    entries.extend(entry("", 0, 0, 0) for _ in range(dir_sectors * 4 - len(entries)))
+
+    header = struct.pack("<8s16sHHHHH6sIIIIIIIII", bytes.fromhex("D0CF11E0A1B11AE1"), b"", 0x3E, 3, 0xFFFE,
+                         9, 6, b"", 0, fat_sectors, dir_start, 0, 4096, end_of_chain, 0, end_of_chain, 0)
+    header += struct.pack("<109I", *(list(range(fat_sectors)) + [free_sector] * (109 - fat_sectors)))
+    with open(path, "wb") as f:
+        f.write(header)
+        f.write(struct.pack("<%dI" % len(fat), *fat))
+        f.write(b"".join(entries))
+        f.write(b"".join(payloads))
+
+
+def make_doc(path, rng, paragraphs):
+    # Two pieces: 8-bit (compressed) and UTF-16 text, each paragraph ends with CR
+    ansi = "".join(sentence(rng).encode("ascii", "ignore").decode() + "\r" for _ in range(paragraphs // 2))
+    wide = "".join(sentence(rng) + "\r" for _ in range(paragraphs - paragraphs // 2))
+    ansi_offset = 0x800
+    wide_offset = ansi_offset + len(ansi) + (len(ansi) & 1)
+    ansi_chars, wide_chars = len(ansi), len(wide.encode("utf-16-le")) // 2
+
+    plc = struct.pack("<3I", 0, ansi_chars, ansi_chars + wide_chars)
+    plc += struct.pack("<HIH", 0, 0x40000000 | (ansi_offset * 2), 0) + struct.pack("<HIH", 0, wide_offset, 0)
+    clx = b"\x02" + struct.pack("<I", len(plc)) + plc
+
+    fib = bytearray(ansi_offset)
+    struct.pack_into("<HH", fib, 0x00, 0xA5EC, 0x00C1)
+    struct.pack_into("<H", fib, 0x0A, 0x0200)  # fWhichTblStm: pieces are in `1Table`
+    struct.pack_into("<i", fib, 0x4C, ansi_chars + wide_chars)
+    struct.pack_into("<II", fib, 0x01A2, 0, len(clx))
+    document = bytes(fib) + ansi.encode("ascii") + b"\0" * (len(ansi) & 1) + wide.encode("utf-16-le")
+    write_cfb(path, [("WordDocument", document), ("1Table", clx)])
+
+
+def biff_record(code, data=b""):
+    return struct.pack("<HH", code, len(data)) + data
+
+
+def biff_unicode(text, count_format):
+    raw = text.encode("utf-16-le")
+    return struct.pack(count_format, len(raw) // 2) + b"\x01" + raw
+
+
+def make_xls(path, rng, sheets, rows):
+    bof = lambda kind: biff_record(0x0809, struct.pack("<HHHHII", 0x0600, kind, 0x0DBB, 0x07CC, 0, 0x0206))
+    eof = biff_record(0x000A)
+
+    # SST split into CONTINUE records at string boundaries
+    shared = [sentence(rng, 3) for _ in range(200)]
+    sst, record = [], struct.pack("<II", sheets * rows, len(shared))
+    for text in shared:
+        item = biff_unicode(text, "<H")
+        if len(record) + len(item) > 8224:
+            sst.append(biff_record(0x003C if sst else 0x00FC, record))
+            record = b""
+        record += item
+    sst.append(biff_record(0x003C if sst else 0x00FC, record))
+
+    bodies = []
+    for s in range(sheets):
+        body = [bof(0x0010), biff_record(0x0200, struct.pack("<IIHHH", 0, rows, 0, 4, 0))]
+        for r in range(rows):
+            body.append(biff_record(0x0208, struct.pack("<HHHHHHI", r, 0, 4, 0x00FF, 0, 0, 0x0100)))
+            body.append(biff_record(0x00FD, struct.pack("<HHHI", r, 0, 15, rng.randrange(len(shared)))))
+            body.append(biff_record(0x0203, struct.pack("<HHHd", r, 1, 15, rng.random() * 1000)))
+            body.append(biff_record(0x027E, struct.pack("<HHHI", r, 2, 15, (rng.randrange(100000) << 2) | 2)))
+            body.append(biff_record(0x0204, struct.pack("<HHH", r, 3, 15) + biff_unicode(sentence(rng, 2), "<H")))
+        body.append(eof)
+        bodies.append(b"".join(body))
+
+    # BOUNDSHEET records hold the stream offset of each sheet's BOF
+    names = ["Sheet%d" % (s + 1) for s in range(sheets)]
+    boundsheet = lambda offset, name: biff_record(0x0085, struct.pack("<IBBBB", offset, 0, 0, len(name), 0)
+                                                  + name.encode("ascii"))
+    globals_size = (len(bof(0x0005)) + len(biff_record(0x0042, b"\0\0")) + len(eof) + sum(map(len, sst))
+                    + sum(len(boundsheet(0, name)) for name in names))
+    offsets = [globals_size + sum(map(len, bodies[:s])) for s in range(sheets)]
+    workbook = [bof(0x0005), biff_record(0x0042, struct.pack("<H", 1200))]
+    workbook += [boundsheet(offset, name) for offset, name in zip(offsets, names)]
+    workbook += sst + [eof] + bodies
+    write_cfb(path, [("Workbook", b"".join(workbook))])
+
+
+def ppt_record(rec_type, data=b"", container=False):
+    return struct.pack("<HHI", 0x000F if container else 0, rec_type, len(data)) + data
+
+
+def make_ppt(path, rng, slides):
+    chars = lambda text: ppt_record(0x0FA0, text.encode("utf-16-le"))
+    ascii_bytes = lambda text: ppt_record(0x0FA8, text.encode("ascii", "ignore"))
+    header = lambda kind: ppt_record(0x0F9F, struct.pack("<I", kind))
+
+    # Outline text of every slide in the document container
+    outline = []
+    for s in range(slides):
+        outline += [ppt_record(0x03F3, struct.pack("<IIiII", s + 1, 0, 2, 0, 256 + s)),
+                    header(0), chars(sentence(rng, 5)),
+                    header(1), ascii_bytes("\r".join(sentence(rng, 7) for _ in range(3)))]
+    stream = [ppt_record(0x03E8, ppt_record(0x0FF0, b"".join(outline), True) + ppt_record(0x03EA), True),
+              ppt_record(0x03F8, ppt_record(0x03EF, bytes(24)), True)]
+
+    # Shape text boxes inside the drawing of each slide
+    for _ in range(slides):
+        shapes = b"".join(
+            ppt_record(0xF004, ppt_record(0xF00D, header(4) + chars("\r".join(sentence(rng, 7) for _ in range(3))),
+                                          True), True)
+            for _ in range(3))
+        drawing = ppt_record(0x040C, ppt_record(0xF002, ppt_record(0xF003, shapes, True), True), True)
+        stream.append(ppt_record(0x03EE, ppt_record(0x03EF, bytes(24)) + drawing, True))
+    write_cfb(path, [("PowerPoint Document", b"".join(stream))])
+
+
+def make_docx(path, rng, paragraphs):
+    w = 'xmlns:w="http://schemas.openxmlformats.org/wordprocessingml/2006/main" ' \
+        'xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships"'
+    body = []
+    for i in range(paragraphs):
+        kind = i % 10
+        if kind == 0:
+            body.append('<w:p><w:pPr><w:pStyle w:val="Heading1"/></w:pPr><w:r><w:t>%s</w:t></w:r></w:p>'
+                        % esc(sentence(rng, 5)))
+        elif kind in (1, 2, 3):
+            body.append('<w:p><w:pPr><w:numPr><w:ilvl w:val="%d"/><w:numId w:val="1"/></w:numPr></w:pPr>'
+                        '<w:r><w:t>%s</w:t></w:r></w:p>' % (kind - 1, esc(sentence(rng, 8))))
+        elif kind == 4:
+            rows = "".join(
+                "<w:tr>%s</w:tr>" % "".join(
+                    '<w:tc><w:tcPr/><w:p><w:r><w:t>%s</w:t></w:r></w:p></w:tc>' % esc(sentence(rng, 3))
+                    for _ in range(4))
+                for _ in range(3))
+            body.append("<w:tbl>%s</w:tbl>" % rows)
+        elif kind == 5:
+            body.append('<w:p><w:hyperlink r:id="rId1"><w:r><w:t>%s</w:t></w:r></w:hyperlink></w:p>'
+                        % esc(sentence(rng, 4)))
+        else:
+            runs = "".join('<w:r><w:rPr><w:b/></w:rPr><w:t xml:space="preserve">%s </w:t></w:r>'
+                           % esc(sentence(rng, 6)) for _ in range(3))
+            body.append("<w:p>%s</w:p>" % runs)
+    document = '<?xml version="1.0" encoding="UTF-8"?><w:document %s><w:body>%s<w:sectPr/></w:body></w:document>' \
+               % (w, "".join(body))
+    numbering = ('<?xml version="1.0" encoding="UTF-8"?><w:numbering %s>'
+                 '<w:abstractNum w:abstractNumId="0">%s</w:abstractNum>'
+                 '<w:num w:numId="1"><w:abstractNumId w:val="0"/></w:num></w:numbering>'
+                 % (w, "".join('<w:lvl w:ilvl="%d"><w:numFmt w:val="%s"/></w:lvl>' % (i, f)
+                               for i, f in enumerate(("decimal", "lowerLetter", "bullet")))))
+    styles = ('<?xml version="1.0" encoding="UTF-8"?><w:styles %s>'
+              '<w:style w:styleId="Heading1"><w:name w:val="heading 1"/><w:rPr><w:sz w:val="32"/></w:rPr></w:style>'
+              '<w:style w:styleId="Normal"><w:name w:val="Normal"/></w:style></w:styles>' % w)
+    rels = ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">'
+            '<Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/hyperlink" '
+            'Target="https://example.com" TargetMode="External"/></Relationships>')
+    write_zip(path, {
+        "[Content_Types].xml": CONTENT_TYPES_HEAD + '</Types>',
+        "word/document.xml": document,
+        "word/numbering.xml": numbering,
+        "word/styles.xml": styles,
+        "word/_rels/document.xml.rels": rels,
+    })
+
+
+def make_xlsx(path, rng, sheets, rows):
+    shared = [sentence(rng, 3) for _ in range(200)]
+    sst = ('<?xml version="1.0" encoding="UTF-8"?><sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">%s</sst>'
+           % "".join("<si><t>%s</t></si>" % esc(s) for s in shared))
+    parts = {"[Content_Types].xml": CONTENT_TYPES_HEAD + '</Types>', "xl/sharedStrings.xml": sst}
+    sheet_xml, rel_xml = [], []
+    for s in range(1, sheets + 1):
+        sheet_xml.append('<sheet name="Sheet%d" sheetId="%d" r:id="rId%d"/>' % (s, s, s))
+        rel_xml.append('<Relationship Id="rId%d" Type="http://schemas.openxmlformats.org/officeDocument/2006/'
+                       'relationships/worksheet" Target="worksheets/sheet%d.xml"/>' % (s, s))
+        data = []
+        for r in range(1, rows + 1):
+            cells = ['<c r="A%d" t="s"><v>%d</v></c>' % (r, rng.randrange(len(shared))),
+                     '<c r="B%d"><v>%d</v></c>' % (r, rng.randrange(100000)),
+                     '<c r="C%d"><v>%.4f</v></c>' % (r, rng.random() * 1000),
+                     '<c r="D%d" t="str"><f>A%d</f><v>%s</v></c>' % (r, r, esc(sentence(rng, 2))),
+                     '<c r="E%d" t="inlineStr"><is><t>%s</t></is></c>' % (r, esc(sentence(rng, 2))),
+                     '<c r="F%d" t="b"><v>%d</v></c>' % (r, r % 2)]
+            data.append('<row r="%d">%s</row>' % (r, "".join(cells)))
+        parts["xl/worksheets/sheet%d.xml" % s] = (
+            '<?xml version="1.0" encoding="UTF-8"?><worksheet xmlns="http://schemas.openxmlformats.org/'
+            'spreadsheetml/2006/main"><dimension ref="A1:F%d"/><sheetData>%s</sheetData>'
+            '<mergeCells><mergeCell ref="A1:B1"/></mergeCells></worksheet>' % (rows, "".join(data)))
+    parts["xl/workbook.xml"] = (
+        '<?xml version="1.0" encoding="UTF-8"?><workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" '
+        'xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships"><workbookPr/>'
+        '<sheets>%s</sheets></workbook>' % "".join(sheet_xml))
+    parts["xl/_rels/workbook.xml.rels"] = (
+        '<?xml version="1.0" encoding="UTF-8"?><Relationships '
+        'xmlns="http://schemas.openxmlformats.org/package/2006/relationships">%s</Relationships>' % "".join(rel_xml))
+    write_zip(path, parts)
+
+
+def make_pptx(path, rng, slides):
+    p = ('xmlns:a="http://schemas.openxmlformats.org/drawingml/2006/main" '
+         'xmlns:p="http://schemas.openxmlformats.org/presentationml/2006/main" '
+         'xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships"')
+    parts = {"[Content_Types].xml": CONTENT_TYPES_HEAD + '</Types>'}
+    ids, rels = [], []
+    for s in range(1, slides + 1):
+        ids.append('<p:sldId id="%d" r:id="rId%d"/>' % (255 + s, s))
+        rels.append('<Relationship Id="rId%d" Type="http://schemas.openxmlformats.org/officeDocument/2006/'
+                    'relationships/slide" Target="slides/slide%d.xml"/>' % (s, s))
+        shapes = "".join(
+            '<p:sp><p:txBody><a:bodyPr/>%s</p:txBody></p:sp>'
+            % "".join('<a:p><a:r><a:rPr lang="en-US"/><a:t>%s</a:t></a:r></a:p>' % esc(sentence(rng, 7))
+                      for _ in range(4))
+            for _ in range(3))
+        parts["ppt/slides/slide%d.xml" % s] = (
+            '<?xml version="1.0" encoding="UTF-8"?><p:sld %s><p:cSld><p:spTree>%s</p:spTree></p:cSld></p:sld>'
+            % (p, shapes))
+    parts["ppt/presentation.xml"] = ('<?xml version="1.0" encoding="UTF-8"?><p:presentation %s><p:sldIdLst>%s'
+                                     '</p:sldIdLst></p:presentation>' % (p, "".join(ids)))
+    parts["ppt/_rels/presentation.xml.rels"] = (
+        '<?xml version="1.0" encoding="UTF-8"?><Relationships '
+        'xmlns="http://schemas.openxmlformats.org/package/2006/relationships">%s</Relationships>' % "".join(rels))
+    write_zip(path, parts)
+
+
+def make_odf(path, rng, kind, blocks):
+    ns = ('xmlns:office="urn:oasis:names:tc:opendocument:xmlns:office:1.0" '
+          'xmlns:text="urn:oasis:names:tc:opendocument:xmlns:text:1.0" '
+          'xmlns:table="urn:oasis:names:tc:opendocument:xmlns:table:1.0" '
+          'xmlns:xlink="http://www.w3.org/1999/xlink"')
+    body = []
+    for i in range(blocks):
+        if i % 5 == 4:
+            rows = "".join("<table:table-row>%s</table:table-row>" % "".join(
+                "<table:table-cell><text:p>%s</text:p></table:table-cell>" % esc(sentence(rng, 3))
+                for _ in range(4)) for _ in range(3))
+            body.append("<table:table>%s</table:table>" % rows)
+        else:
+            body.append('<text:p>%s <text:a xlink:href="https://example.com">%s</text:a></text:p>'
+                        % (esc(sentence(rng, 10)), esc(sentence(rng, 2))))
+    content = ('<?xml version="1.0" encoding="UTF-8"?><office:document-content %s><office:body>'
+               '<office:%s>%s</office:%s></office:body></office:document-content>'
+               % (ns, kind, "".join(body), kind))
+    mime = {"text": "application/vnd.oasis.opendocument.text",
+            "spreadsheet": "application/vnd.oasis.opendocument.spreadsheet",
+            "presentation": "application/vnd.oasis.opendocument.presentation"}[kind]
+    # ODF requires an uncompressed mimetype as the first entry
+    write_zip(path, {"mimetype": mime, "content.xml": content}, stored=("mimetype",))
+
+
+def make_rtf(path, rng, paragraphs):
+    out = [r"{\rtf1\ansi\ansicpg1252\deff0{\fonttbl{\f0 Times New Roman;}}{\colortbl;\red255\green0\blue0;}"]
+    for i in range(paragraphs):
+        if i % 7 == 6:
+            out.append(r"\trowd\cellx2000\cellx4000 %s\cell %s\cell\row" % (sentence(rng, 2), sentence(rng, 2)))
+        else:
+            out.append(r"\pard\f0\fs24 {\b %s} {\i %s}  3? \par" % (sentence(rng, 5), sentence(rng, 5)))
+    out.append("}")
+    with open(path, "w", encoding="ascii", errors="ignore") as f:
+        f.write("\n".join(out))
+
+
+def make_pdf(path, rng, pages):
+    objects = ["<< /Type /Catalog /Pages 2 0 R >>", None, "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>"]
+    kids = []
+    for _ in range(pages):
+        lines = " ".join("(%s) Tj T*" % sentence(rng, 8).encode("ascii", "ignore").decode()
+                         .replace("\\", "").replace("(", "").replace(")", "") for _ in range(30))
+        stream = "BT /F1 10 Tf 14 TL 40 800 Td %s ET" % lines
+        objects.append("<< /Length %d >>\nstream\n%s\nendstream" % (len(stream), stream))
+        content_id = len(objects)
+        objects.append("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 595 842] "
+                       "/Resources << /Font << /F1 3 0 R >> >> /Contents %d 0 R >>" % content_id)
+        kids.append("%d 0 R" % len(objects))
+    objects[1] = "<< /Type /Pages /Kids [%s] /Count %d >>" % (" ".join(kids), pages)
+
+    data = bytearray(b"%PDF-1.4\n")
+    offsets = []
+    for number, obj in enumerate(objects, 1):
+        offsets.append(len(data))
+        data += ("%d 0 obj\n%s\nendobj\n" % (number, obj)).encode("latin-1")
+    xref = len(data)
+    data += ("xref\n0 %d\n0000000000 65535 f \n" % (len(objects) + 1)).encode()
+    data += "".join("%010d 00000 n \n" % off for off in offsets).encode()
+    data += ("trailer\n<< /Size %d /Root 1 0 R >>\nstartxref\n%d\n%%%%EOF\n" % (len(objects) + 1, xref)).encode()
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def make_txt(path, rng, lines):
+    with open(path, "w", encoding="utf-8") as f:
+        for _ in range(lines):
+            f.write(sentence(rng, 14) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--out", required=True, help="output directory")
+    parser.add_argument("--scale", type=int, default=1, help="size multiplier (default: 1)")
+    parser.add_argument("--count", type=int, default=8, help="files per format (default: 8)")
+    parser.add_argument("--seed", type=int, default=20260101)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    scale = max(1, args.scale)
+    generators = {
+        "docx": lambda p: make_docx(p, rng, 400 * scale),
+        "xlsx": lambda p: make_xlsx(p, rng, 3, 400 * scale),
+        "pptx": lambda p: make_pptx(p, rng, 40 * scale),
+        "doc": lambda p: make_doc(p, rng, 400 * scale),
+        "xls": lambda p: make_xls(p, rng, 3, 400 * scale),
+        "ppt": lambda p: make_ppt(p, rng, 40 * scale),
+        "odt": lambda p: make_odf(p, rng, "text", 300 * scale),
+        "ods": lambda p: make_odf(p, rng, "spreadsheet", 300 * scale),
+        "odp": lambda p: make_odf(p, rng, "presentation", 300 * scale),
+        "rtf": lambda p: make_rtf(p, rng, 400 * scale),
+        "pdf": lambda p: make_pdf(p, rng, 10 * scale),
+        "txt": lambda p: make_txt(p, rng, 2000 * scale),
+    }
+    for fmt, generate in generators.items():
+        directory = os.path.join(args.out, fmt)
+        os.makedirs(directory, exist_ok=True)
+        for i in range(args.count):
+            generate(os.path.join(directory, "sample%d.%s" % (i, fmt)))
+    print("corpus written to %s" % args.out)
+
+
+if __name__ == "__main__":
+    main()
@@ -3,12 +3,17 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "docparser.h"
+#include "docparser_c.h"
 #include "ofd/ofd.h"
 
+#include "fileext/cfb/cfb.hpp"
+
 #include "fileext/doc/doc.hpp"
 #include "fileext/docx/docx.hpp"
 #include "fileext/excel/excel.hpp"
+#include "fileext/executor.hpp"
 #include "fileext/odf/odf.hpp"
+#include "fileext/ooxml/ooxml.hpp"
 #include "fileext/pdf/pdf.hpp"
 #include "fileext/ppt/ppt.hpp"
 #include "fileext/pptx/pptx.hpp"
@@ -16,13 +21,17 @@
 #include "fileext/txt/txt.hpp"
 #include "fileext/xlsb/xlsb.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include <iostream>
 #include <cstring>
 #include <unordered_set>
 #include <unordered_map>
 #include <string_view>
 #include <algorithm>
+#include <new>
 #include <magic.h>
 #include <sys/stat.h>
 
@@ -145,60 +154,100 @@ static bool isSmallFile(const std::string &filename, size_t maxBytes)
     return fileSize > 0 && fileSize <= maxBytes;
 }
 
+// The masks are passed to docx::Docx::setParts() and pptx::Pptx::setParts() unchanged
+static_assert(unsigned(DocParser::DocxBody) == docx::Docx::PartBody
+                      && unsigned(DocParser::DocxTextBoxes) == docx::Docx::PartTextBoxes
+                      && unsigned(DocParser::DocxAllParts) == docx::Docx::PartAll,
+              "DocParser::DocxPart must match docx::Docx::Part");
+static_assert(unsigned(DocParser::PptxSlides) == pptx::Pptx::PartSlides
+                      && unsigned(DocParser::PptxNotes) == pptx::Pptx::PartNotes
+                      && unsigned(DocParser::PptxMasters) == pptx::Pptx::PartMasters
+                      && unsigned(DocParser::PptxAllParts) == pptx::Pptx::PartAll,
+              "DocParser::PptxPart must match pptx::Pptx::Part");
+static_assert(DocParser::Options().maxNesting == fileext::DEFAULT_MAX_NESTING,
+              "DocParser::Options::maxNesting must match fileext::DEFAULT_MAX_NESTING");
+
+/**
+ * @brief Select fast text-run extraction if it was enabled for the format
+ */
+static std::unique_ptr<fileext::FileExtension> withFastText(std::unique_ptr<fileext::FileExtension> document,
+                                                            const DocParser::Options &options, unsigned format)
+{
+    document->setFastTextMode((options.fastTextFormats & format) != 0);
+    return document;
+}
+
 // 预处理后缀映射，避免多次strcasecmp比较
-using FileCreator = std::unique_ptr<fileext::FileExtension> (*)(const std::string &, const std::string &);
+using FileCreator = std::unique_ptr<fileext::FileExtension> (*)(const std::string &, const std::string &,
+                                                                 const DocParser::Options &);
 
-static std::unique_ptr<fileext::FileExtension> createDocx(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createDocx(const std::string &filename, const std::string &,
+                                                          const DocParser::Options &options)
 {
-    return std::make_unique<docx::Docx>(filename);
+    auto document = std::make_unique<docx::Docx>(filename);
+    document->setParts(options.docxParts & DocParser::DocxAllParts);
+    return withFastText(std::move(document), options, DocParser::FastTextDocx);
 }
 
-static std::unique_ptr<fileext::FileExtension> createPptx(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createPptx(const std::string &filename, const std::string &,
+                                                          const DocParser::Options &options)
 {
-    return std::make_unique<pptx::Pptx>(filename);
+    auto document = std::make_unique<pptx::Pptx>(filename);
+    document->setMaxSlides(options.pptxMaxSlides);
+    document->setParts(options.pptxParts & DocParser::PptxAllParts);
+    return withFastText(std::move(document), options, DocParser::FastTextPptx);
 }
 
-static std::unique_ptr<fileext::FileExtension> createTxt(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createTxt(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<txt::Txt>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createDoc(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createDoc(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<doc::Doc>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createRtf(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createRtf(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<rtf::Rtf>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createOdf(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createOdf(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<odf::Odf>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createExcel(const std::string &filename, const std::string &suffix)
+static std::unique_ptr<fileext::FileExtension> createExcel(const std::string &filename, const std::string &suffix,
+                                                           const DocParser::Options &options)
 {
-    return std::make_unique<excel::Excel>(filename, suffix);
+    return withFastText(std::make_unique<excel::Excel>(filename, suffix), options, DocParser::FastTextXlsx);
 }
 
-static std::unique_ptr<fileext::FileExtension> createXlsb(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createXlsb(const std::string &filename, const std::string &,
+                                                          const DocParser::Options &)
 {
     return std::make_unique<xlsb::Xlsb>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createPpt(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createPpt(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<ppt::Ppt>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createPdf(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createPdf(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<pdf::Pdf>(filename);
 }
 
-static std::unique_ptr<fileext::FileExtension> createOfd(const std::string &filename, const std::string &)
+static std::unique_ptr<fileext::FileExtension> createOfd(const std::string &filename, const std::string &,
+                                                         const DocParser::Options &)
 {
     return std::make_unique<ofd::Ofd>(filename);
 }
@@ -246,51 +295,315 @@ static const std::unordered_map<std::string, std::string> createSimilarExtension
  * @brief Create parser instance for the given file
  * @param filename Path to the file
  * @param suffix File extension (lowercase)
+ * @param options Conversion options
  * @return Unique pointer to FileExtension instance, or nullptr if unsupported
  */
-static std::unique_ptr<fileext::FileExtension> createParser(const std::string &filename, const std::string &suffix)
+static std::unique_ptr<fileext::FileExtension> createParser(const std::string &filename, const std::string &suffix,
+                                                            const DocParser::Options &options)
 {
     static const std::unordered_map<std::string, FileCreator> extensionMap = createExtensionMap();
 
+    std::unique_ptr<fileext::FileExtension> document;
+    auto it = extensionMap.find(suffix);
     // First check if it is a text file
     if (isTextSuffix(suffix)) {
-        return createTxt(filename, suffix);
+        document = createTxt(filename, suffix, options);
     }
-
     // Find the corresponding creation function
-    auto it = extensionMap.find(suffix);
-    if (it != extensionMap.end()) {
-        return it->second(filename, suffix);
+    else if (it != extensionMap.end()) {
+        document = it->second(filename, suffix, options);
     }
+    else {
+        // Extension not found in map, check if it's a text file by content
+        std::cout << "INFO: [createParser] Unknown file extension '" << suffix
+                  << "', checking file content for text type: " << filename << std::endl;
 
-    // Extension not found in map, check if it's a text file by content
-    std::cout << "INFO: [createParser] Unknown file extension '" << suffix
-              << "', checking file content for text type: " << filename << std::endl;
-
-    if (isTextFileByMimeType(filename)) {
+        if (!isTextFileByMimeType(filename))
+            return nullptr;
         std::cout << "INFO: [createParser] File detected as text by MIME type analysis: "
                   << filename << std::endl;
-        return createTxt(filename, suffix);
+        document = createTxt(filename, suffix, options);
+    }
+
+    document->setMaxNesting(options.maxNesting > 0 ? options.maxNesting : 1);
+    return document;
+}
+
+/**
+ * @brief Limits shared by a converted file and all documents embedded in it
+ */
+struct EmbeddedBudget
+{
+    /**
+     * @param options Options of the conversion, embedded documents are converted with them too
+     * @param textLimit Text limit of the conversion (0 = no limit)
+     */
+    EmbeddedBudget(const DocParser::Options &options, size_t textLimit)
+        : options(options),
+          maxDepth(options.embedded.maxDepth),
+          isTextLimited(textLimit > 0),
+          textLeft(textLimit),
+          bytesLeft(options.embedded.maxBytes),
+          deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(options.embedded.timeoutMs))
+    {
+    }
+
+    bool expired() const { return std::chrono::steady_clock::now() >= deadline; }
+
+    /**
+     * @brief Reserve embedded content bytes
+     * @return false if the budget is exhausted
+     */
+    bool take(size_t size)
+    {
+        size_t left = bytesLeft.load(std::memory_order_relaxed);
+        do {
+            if (size > left)
+                return false;
+        } while (!bytesLeft.compare_exchange_weak(left, left - size, std::memory_order_relaxed));
+        return true;
+    }
+
+    /**
+     * @brief Count text of the converted file or of an embedded document against the text limit
+     */
+    void spendText(size_t size)
+    {
+        size_t left = textLeft.load(std::memory_order_relaxed);
+        while (!textLeft.compare_exchange_weak(left, left > size ? left - size : 0, std::memory_order_relaxed)) {
+        }
     }
 
+    const DocParser::Options &options;
+    const unsigned maxDepth;
+    const bool isTextLimited;
+    // Text the embedded documents may still add, if isTextLimited
+    std::atomic<size_t> textLeft;
+    std::atomic<size_t> bytesLeft;
+    const std::chrono::steady_clock::time_point deadline;
+    // Set when the text of an embedded document was cut
+    std::atomic<bool> truncated { false };
+};
+
+/**
+ * @brief Package session of an OOXML parser, kept open after convert()
+ * @return Empty for other parsers
+ */
+static std::shared_ptr<const ooxml::Archive> packageOf(const fileext::FileExtension &document)
+{
+    if (const auto *package = dynamic_cast<const ooxml::Ooxml *>(&document))
+        return package->archive();
     return nullptr;
 }
 
-static std::string doConvertFile(const std::string &filename, std::string suffix)
+/**
+ * @brief Embedded document read from the package of its parent
+ */
+struct EmbeddedPart
+{
+    std::string name;
+    std::string suffix;
+    std::string content;
+    std::string text;
+};
+
+/**
+ * @brief Directory of embedded objects in an OOXML package
+ * @return Entry prefix, empty if the format has none
+ */
+static std::string_view embeddingsDir(const std::string &suffix)
+{
+    if (suffix == "docx")
+        return "word/embeddings/";
+    if (suffix == "pptx" || suffix == "ppsx")
+        return "ppt/embeddings/";
+    if (suffix == "xlsx")
+        return "xl/embeddings/";
+    return {};
+}
+
+/**
+ * @brief Detect format of embedded content by its signature and structure
+ * @param name Entry name
+ * @param content Entry content, OLE objects wrapping an OOXML package are replaced with the package
+ * @return Suffix of the parser, empty if the content isn't supported
+ */
+static std::string detectEmbeddedFormat(const std::string &name, std::string &content)
+{
+    static constexpr std::string_view ZIP_SIGNATURE("PK\x03\x04", 4);
+    static constexpr std::string_view CFB_SIGNATURE("\xD0\xCF\x11\xE0\xA1\xB1\x1A\xE1", 8);
+
+    const std::string_view signature(content);
+    if (signature.substr(0, ZIP_SIGNATURE.size()) == ZIP_SIGNATURE) {
+        ooxml::Archive package(name, content);
+        if (package.exists("word/document.xml"))
+            return "docx";
+        if (package.exists("ppt/presentation.xml"))
+            return "pptx";
+        if (package.exists("xl/workbook.xml"))
+            return "xlsx";
+        return {};
+    }
+
+    if (signature.substr(0, CFB_SIGNATURE.size()) == CFB_SIGNATURE) {
+        cfb::Cfb object(name);
+        object.setData(content);
+        object.parse();
+        if (object.hasStream("Package")) {
+            content = object.getStream("Package");
+            return content.empty() ? std::string() : detectEmbeddedFormat(name, content);
+        }
+        if (object.hasStream("WordDocument"))
+            return "doc";
+        if (object.hasStream("Workbook"))
+            return "xls";
+        if (object.hasStream("PowerPoint Document"))
+            return "ppt";
+    }
+    return {};
+}
+
+/**
+ * @brief Read supported embedded documents of a package within the byte budget
+ */
+static std::vector<EmbeddedPart> readEmbeddedParts(const ooxml::Archive &package, const std::string &suffix,
+                                                   EmbeddedBudget &budget)
+{
+    std::vector<EmbeddedPart> parts;
+    const std::string_view dir = embeddingsDir(suffix);
+    if (dir.empty())
+        return parts;
+
+    for (auto &name : package.entries(dir)) {
+        if (budget.expired())
+            break;
+
+        EmbeddedPart part;
+        part.name = std::move(name);
+        if (!package.extractFile(part.name, part.content, budget.bytesLeft.load(std::memory_order_relaxed))
+            || !budget.take(part.content.size()))
+            continue;
+
+        part.suffix = detectEmbeddedFormat(part.name, part.content);
+        if (!part.suffix.empty())
+            parts.push_back(std::move(part));
+    }
+    return parts;
+}
+
+static void appendEmbeddedText(const ooxml::Archive &package, const std::string &suffix, unsigned depth,
+                               EmbeddedBudget &budget, std::string &text);
+
+/**
+ * @brief Convert embedded document from memory, then the documents embedded in it
+ * @param part Embedded document, receives the text
+ * @param depth Nesting level of the part, 1 for embeddings of the converted file
+ * @param budget Shared limits
+ */
+static void convertEmbeddedPart(EmbeddedPart &part, unsigned depth, EmbeddedBudget &budget)
+{
+    try {
+        std::unique_ptr<fileext::FileExtension> document = createParser(part.name, part.suffix, budget.options);
+        if (!document)
+            return;
+
+        // The part only gets the text its parent and the parts converted before it left over
+        document->setContent(part.content);
+        document->setDeadline(budget.deadline);
+        if (budget.isTextLimited) {
+            const size_t textLeft = budget.textLeft.load(std::memory_order_relaxed);
+            if (textLeft == 0) {
+                budget.truncated = true;
+                return;
+            }
+            document->setTruncationLimit(textLeft);
+        }
+        document->convert();
+        if (document->isTruncated())
+            budget.truncated = true;
+        part.text = std::move(document->m_text);
+        budget.spendText(part.text.size());
+
+        std::shared_ptr<const ooxml::Archive> package = packageOf(*document);
+        document.reset();
+        if (package && depth < budget.maxDepth && !embeddingsDir(part.suffix).empty())
+            appendEmbeddedText(*package, part.suffix, depth + 1, budget, part.text);
+    } catch (const std::exception &error) {
+        std::cerr << "Parse failed: embedded " << part.name << ": " << error.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Parse failed: embedded " << part.name << std::endl;
+    }
+}
+
+/**
+ * @brief Append text of documents embedded in a package
+ * @details Embeddings of the converted file are converted in parallel with
+ *          helpers of the shared executor, deeper levels on the thread of
+ *          their parent. Text keeps the package order.
+ * @param package Package of the parent document
+ * @param suffix Parent format
+ * @param depth Nesting level of the embeddings
+ * @param budget Shared limits
+ * @param text Parent text
+ */
+static void appendEmbeddedText(const ooxml::Archive &package, const std::string &suffix, unsigned depth,
+                               EmbeddedBudget &budget, std::string &text)
+{
+    std::vector<EmbeddedPart> parts = readEmbeddedParts(package, suffix, budget);
+    if (parts.empty())
+        return;
+
+    std::atomic<size_t> next { 0 };
+    auto work = [&parts, &next, &budget, depth] {
+        for (size_t i = next++; i < parts.size() && !budget.expired(); i = next++)
+            convertEmbeddedPart(parts[i], depth, budget);
+    };
+    fileext::Executor::shared().run(depth == 1 ? parts.size() - 1 : 0, work, work);
+
+    for (const auto &part : parts) {
+        if (part.text.empty())
+            continue;
+        if (!text.empty() && text.back() != '\n')
+            text += '\n';
+        text += part.text;
+    }
+}
+
+/**
+ * @brief Append text of documents embedded in the converted file, if extraction is enabled
+ * @param document Parser of the file, its package session is reused
+ */
+static void appendEmbeddedDocuments(const fileext::FileExtension &document, const std::string &filename,
+                                    const std::string &suffix, EmbeddedBudget &budget, std::string &text)
+{
+    if (budget.maxDepth == 0 || embeddingsDir(suffix).empty() || budget.expired())
+        return;
+
+    budget.spendText(text.size());
+    std::shared_ptr<const ooxml::Archive> package = packageOf(document);
+    if (!package)
+        package = std::make_shared<const ooxml::Archive>(filename);
+    appendEmbeddedText(*package, suffix, 1, budget, text);
+}
+
+static std::string doConvertFile(const std::string &filename, std::string suffix, const DocParser::Options &options)
 {
     // Convert suffix to lowercase
     std::transform(suffix.begin(), suffix.end(), suffix.begin(),
                    [](unsigned char c) { return std::tolower(c); });
 
-    std::unique_ptr<fileext::FileExtension> document = createParser(filename, suffix);
+    std::unique_ptr<fileext::FileExtension> document = createParser(filename, suffix, options);
     if (!document) {
         throw std::logic_error("Unsupported file extension: " + filename);
     }
 
     try {
+        EmbeddedBudget budget(options, 0);
         document->convert();
         // Use move semantics to avoid copying
-        return std::move(document->m_text);
+        std::string text = std::move(document->m_text);
+        appendEmbeddedDocuments(*document, filename, suffix, budget, text);
+        return text;
     } catch (const std::logic_error &error) {
         std::cout << error.what() << std::endl;
     } catch (...) {
@@ -304,22 +617,24 @@ static std::string doConvertFile(const std::string &filename, std::string suffix
  * @brief Convert file with truncation support
  * @param filename Path to the file
  * @param maxBytes Maximum bytes to process
+ * @param options Conversion options
  * @return Converted text content (potentially truncated)
  */
-static std::string doConvertFileWithTruncation(const std::string &filename, size_t maxBytes)
+static std::string doConvertFileWithTruncation(const std::string &filename, size_t maxBytes,
+                                               const DocParser::Options &options)
 {
     std::string suffix = extractFileExtension(filename);
     if (suffix.empty()) {
         return {};
     }
 
-    std::unique_ptr<fileext::FileExtension> document = createParser(filename, suffix);
+    std::unique_ptr<fileext::FileExtension> document = createParser(filename, suffix, options);
     if (!document) {
         // Try similar extensions
         static const std::unordered_map<std::string, std::string> similarExtensionMap = createSimilarExtensionMap();
         auto it = similarExtensionMap.find(suffix);
         if (it != similarExtensionMap.end()) {
-            document = createParser(filename, it->second);
+            document = createParser(filename, it->second, options);
         }
     }
 
@@ -333,10 +648,16 @@ static std::string doConvertFileWithTruncation(const std::string &filename, size
         document->setTruncationLimit(maxBytes);
 
         // Convert with truncation control
+        EmbeddedBudget budget(options, maxBytes);
         document->convert();
 
         // Get result and add truncation marker if needed
         std::string result = std::move(document->m_text);
+        if (!document->isTruncated()) {
+            appendEmbeddedDocuments(*document, filename, suffix, budget, result);
+            if (budget.truncated)
+                document->markAsTruncated();
+        }
         
         // Fallback truncation: if the result still exceeds maxBytes, do final truncation
         if (result.size() > maxBytes) {
@@ -359,6 +680,16 @@ static std::string doConvertFileWithTruncation(const std::string &filename, size
 }
 
 std::string DocParser::convertFile(const std::string &filename)
+{
+    return convertFile(filename, Options());
+}
+
+std::string DocParser::convertFile(const std::string &filename, size_t maxBytes)
+{
+    return convertFile(filename, maxBytes, Options());
+}
+
+std::string DocParser::convertFile(const std::string &filename, const Options &options)
 {
     std::string suffix = extractFileExtension(filename);
     if (suffix.empty()) {
@@ -366,7 +697,7 @@ std::string DocParser::convertFile(const std::string &filename)
     }
 
     // 尝试使用原始后缀解析
-    std::string content = doConvertFile(filename, suffix);
+    std::string content = doConvertFile(filename, suffix, options);
     if (!content.empty())
         return content;
 
@@ -375,19 +706,293 @@ std::string DocParser::convertFile(const std::string &filename)
 
     auto it = similarExtensionMap.find(suffix);
     if (it != similarExtensionMap.end()) {
-        return doConvertFile(filename, it->second);
+        return doConvertFile(filename, it->second, options);
     }
 
     return {};
 }
 
-std::string DocParser::convertFile(const std::string &filename, size_t maxBytes)
+std::string DocParser::convertFile(const std::string &filename, size_t maxBytes, const Options &options)
 {
-    // Quick check for small files - use original path for maximum compatibility
-    if (isSmallFile(filename, maxBytes)) {
-        return convertFile(filename);
+    // Quick check for small files - use original path for maximum compatibility.
+    // Embedded documents can make the text of a small file exceed the limit
+    if (options.embedded.maxDepth == 0 && isSmallFile(filename, maxBytes)) {
+        return convertFile(filename, options);
     }
 
     // Use truncation processing for all other cases
-    return doConvertFileWithTruncation(filename, maxBytes);
+    return doConvertFileWithTruncation(filename, maxBytes, options);
+}
+
+// ---------------------------------------------------------------------------
+// C interface (docparser_c.h)
+// ---------------------------------------------------------------------------
+
+struct docparser_doc
+{
+    std::string filename;
+    std::string suffix;
+    size_t maxBytes = 0;
+    DocParser::Options options;
+    bool converted = false;
+    // Filled by moving the parser's m_text, handed out without further copies
+    std::string text;
+    std::string error;
+};
+
+/**
+ * @brief Run one parser for the handle, never throws
+ * @param doc Document handle
+ * @param suffix Lowercase extension selecting the parser
+ * @return DOCPARSER_OK and doc->text filled, or an error code and doc->error
+ */
+static docparser_status convertDocument(docparser_doc *doc, const std::string &suffix)
+{
+    try {
+        std::unique_ptr<fileext::FileExtension> document = createParser(doc->filename, suffix, doc->options);
+        if (!document) {
+            doc->error = "Unsupported file extension: " + doc->filename;
+            return DOCPARSER_ERR_UNSUPPORTED;
+        }
+
+        // Same rules as DocParser::convertFile(filename, maxBytes)
+        const bool truncate = doc->maxBytes > 0
+                && (doc->options.embedded.maxDepth > 0 || !isSmallFile(doc->filename, doc->maxBytes));
+        if (truncate)
+            document->setTruncationLimit(doc->maxBytes);
+
+        EmbeddedBudget budget(doc->options, truncate ? doc->maxBytes : 0);
+        document->convert();
+        doc->text = std::move(document->m_text);
+        if (!document->isTruncated()) {
+            appendEmbeddedDocuments(*document, doc->filename, suffix, budget, doc->text);
+            if (budget.truncated)
+                document->markAsTruncated();
+        }
+
+        if (truncate) {
+            if (doc->text.size() > doc->maxBytes) {
+                doc->text = document->applyFinalTruncation(doc->text, doc->maxBytes);
+                document->markAsTruncated();
+            }
+            if (document->isTruncated())
+                doc->text += "\n[CONTENT_TRUNCATED]";
+        }
+        return DOCPARSER_OK;
+    } catch (const std::bad_alloc &) {
+        doc->error = "Out of memory: " + doc->filename;
+        return DOCPARSER_ERR_NO_MEMORY;
+    } catch (const std::exception &error) {
+        doc->error = error.what();
+    } catch (...) {
+        doc->error = "Parse failed: " + doc->filename;
+    }
+
+    doc->text.clear();
+    return DOCPARSER_ERR_PARSE;
+}
+
+extern "C" {
+
+docparser_status docparser_open(const char *path, docparser_doc **out)
+{
+    if (!out)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+    *out = nullptr;
+    if (!path || !*path)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    struct stat statBuf;
+    if (stat(path, &statBuf) != 0 || !S_ISREG(statBuf.st_mode))
+        return DOCPARSER_ERR_NOT_FOUND;
+
+    try {
+        auto doc = std::make_unique<docparser_doc>();
+        doc->filename = path;
+        doc->suffix = extractFileExtension(doc->filename);
+        *out = doc.release();
+    } catch (...) {
+        return DOCPARSER_ERR_NO_MEMORY;
+    }
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_max_bytes(docparser_doc *doc, size_t max_bytes)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->maxBytes = max_bytes;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_convert(docparser_doc *doc)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+    doc->converted = true;
+
+    if (doc->suffix.empty()) {
+        doc->error = "File has no extension: " + doc->filename;
+        return DOCPARSER_ERR_UNSUPPORTED;
+    }
+
+    docparser_status status = convertDocument(doc, doc->suffix);
+    if (status == DOCPARSER_ERR_NO_MEMORY || (status == DOCPARSER_OK && !doc->text.empty()))
+        return status;
+
+    // Mirror DocParser::convertFile(): a mislabelled doc/docx, xls/xlsx or
+    // ppt/pptx is retried with its sibling format
+    static const std::unordered_map<std::string, std::string> similarExtensionMap = createSimilarExtensionMap();
+    auto it = similarExtensionMap.find(doc->suffix);
+    if (it == similarExtensionMap.end())
+        return status;
+
+    std::string firstError = std::move(doc->error);
+    docparser_status retryStatus = convertDocument(doc, it->second);
+    if (retryStatus == DOCPARSER_OK && !doc->text.empty()) {
+        doc->error.clear();
+        return DOCPARSER_OK;
+    }
+
+    doc->text.clear();
+    doc->error = std::move(firstError);
+    return status;
+}
+
+docparser_status docparser_text(const docparser_doc *doc, const char **data, size_t *size)
+{
+    if (!doc || !doc->converted || !data || !size)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    *data = doc->text.c_str();
+    *size = doc->text.size();
+    return DOCPARSER_OK;
 }
+
+docparser_status docparser_copy_text(const docparser_doc *doc, char *buffer, size_t capacity, size_t *needed)
+{
+    if (!doc || !doc->converted || !needed || (!buffer && capacity > 0))
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    const size_t size = doc->text.size();
+    *needed = size;
+    if (capacity < size)
+        return DOCPARSER_ERR_BUFFER_TOO_SMALL;
+
+    if (size > 0)
+        std::memcpy(buffer, doc->text.data(), size);
+    if (capacity > size)
+        buffer[size] = '\0';
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_write_text(const docparser_doc *doc, docparser_write_fn write,
+                                      void *user_data, size_t chunk_size)
+{
+    if (!doc || !doc->converted || !write)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    const std::string &text = doc->text;
+    if (chunk_size == 0)
+        chunk_size = text.size();
+
+    for (size_t offset = 0; offset < text.size(); offset += chunk_size) {
+        const size_t length = std::min(chunk_size, text.size() - offset);
+        if (write(user_data, text.data() + offset, length) != 0)
+            return DOCPARSER_ERR_ABORTED;
+    }
+    return DOCPARSER_OK;
+}
+
+const char *docparser_last_error(const docparser_doc *doc)
+{
+    return doc ? doc->error.c_str() : "";
+}
+
+const char *docparser_status_string(docparser_status status)
+{
+    switch (status) {
+    case DOCPARSER_OK:
+        return "ok";
+    case DOCPARSER_ERR_INVALID_ARGUMENT:
+        return "invalid argument";
+    case DOCPARSER_ERR_NOT_FOUND:
+        return "file not found";
+    case DOCPARSER_ERR_UNSUPPORTED:
+        return "unsupported file type";
+    case DOCPARSER_ERR_PARSE:
+        return "parse failed";
+    case DOCPARSER_ERR_NO_MEMORY:
+        return "out of memory";
+    case DOCPARSER_ERR_BUFFER_TOO_SMALL:
+        return "buffer too small";
+    case DOCPARSER_ERR_ABORTED:
+        return "aborted by callback";
+    }
+    return "unknown status";
+}
+
+docparser_status docparser_set_fast_text_formats(docparser_doc *doc, unsigned formats)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.fastTextFormats = formats & DocParser::FastTextAll;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_docx_parts(docparser_doc *doc, unsigned parts)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.docxParts = parts & DocParser::DocxAllParts;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_embedded_limits(docparser_doc *doc, unsigned max_depth, size_t max_bytes,
+                                               unsigned timeout_ms)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.embedded.maxDepth = max_depth;
+    doc->options.embedded.maxBytes = max_bytes;
+    doc->options.embedded.timeoutMs = timeout_ms;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_pptx_parts(docparser_doc *doc, unsigned parts)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.pptxParts = parts & DocParser::PptxAllParts;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_pptx_max_slides(docparser_doc *doc, unsigned max_slides)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.pptxMaxSlides = max_slides;
+    return DOCPARSER_OK;
+}
+
+docparser_status docparser_set_max_nesting(docparser_doc *doc, unsigned depth)
+{
+    if (!doc || doc->converted)
+        return DOCPARSER_ERR_INVALID_ARGUMENT;
+
+    doc->options.maxNesting = depth;
+    return DOCPARSER_OK;
+}
+
+void docparser_close(docparser_doc *doc)
+{
+    delete doc;
+}
+
+}  // extern "C"
@@ -10,8 +10,59 @@
 class DocParser
 {
 public:
+    // Formats converted with the fast text-run extractor: only text elements
+    // and paragraph boundaries are read, document structure is not interpreted
+    enum FastTextFormat : unsigned {
+        FastTextNone = 0,
+        FastTextDocx = 1 << 0,
+        FastTextPptx = 1 << 1,
+        FastTextXlsx = 1 << 2,
+        FastTextAll = FastTextDocx | FastTextPptx | FastTextXlsx
+    };
+
+    // Docx story parts to extract, text boxes are read inside the selected parts
+    enum DocxPart : unsigned {
+        DocxBody = 1 << 0,
+        DocxHeaders = 1 << 1,
+        DocxFooters = 1 << 2,
+        DocxFootnotes = 1 << 3,
+        DocxEndnotes = 1 << 4,
+        DocxComments = 1 << 5,
+        DocxTextBoxes = 1 << 6,
+        DocxAllParts = (1 << 7) - 1
+    };
+
+    // Pptx parts to extract; with more than slides, repeats of master, layout and notes paragraphs are dropped
+    enum PptxPart : unsigned {
+        PptxSlides = 1 << 0,
+        PptxNotes = 1 << 1,
+        PptxMasters = 1 << 2,
+        PptxAllParts = (1 << 3) - 1
+    };
+
+    // Documents embedded in docx, pptx and xlsx files (packages and OLE objects under
+    // word/, ppt/ and xl/embeddings/) are converted from memory and appended to the text
+    struct EmbeddedLimits {
+        unsigned maxDepth = 0;              // Nesting levels to follow, 0 disables extraction
+        size_t maxBytes = 64 * 1024 * 1024; // Embedded content read per converted file
+        unsigned timeoutMs = 10000;         // Time per converted file, embedded conversions stop when it runs out
+    };
+
+    // Options of one conversion, the defaults are used by the overloads without them
+    struct Options {
+        unsigned fastTextFormats = FastTextNone; // FastTextFormat flags
+        unsigned docxParts = DocxBody;           // DocxPart flags
+        unsigned pptxParts = PptxSlides;         // PptxPart flags
+        unsigned pptxMaxSlides = 0;              // Only the first slides in presentation order, 0 reads all
+        unsigned maxNesting = 256;               // Deeper tables, text boxes and links of docx and odf
+                                                 // files are skipped (0 is taken as 1)
+        EmbeddedLimits embedded;                 // Extraction is disabled by default
+    };
+
     static std::string convertFile(const std::string &filename);
     static std::string convertFile(const std::string &filename, size_t maxBytes);
+    static std::string convertFile(const std::string &filename, const Options &options);
+    static std::string convertFile(const std::string &filename, size_t maxBytes, const Options &options);
 };
 
 #endif // DOCPARSER_H
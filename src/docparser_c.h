@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DOCPARSER_C_H
+#define DOCPARSER_C_H
+
+/*
+ * Plain C interface to libdocparser, intended for bindings (Go, Python, ...).
+ *
+ * A document handle is opened for a path, converted once and then read
+ * as many times as needed.  No C++ exception crosses this boundary, every
+ * call reports a docparser_status instead.  The extracted text is owned by
+ * the handle and stays valid until docparser_close(); it can be borrowed
+ * directly, copied into a caller buffer or streamed through a callback.
+ *
+ * Typical use:
+ *
+ *     docparser_doc *doc = NULL;
+ *     if (docparser_open(path, &doc) == DOCPARSER_OK
+ *         && docparser_convert(doc) == DOCPARSER_OK) {
+ *         size_t needed = 0;
+ *         docparser_copy_text(doc, NULL, 0, &needed);
+ *         char *buf = malloc(needed);
+ *         docparser_copy_text(doc, buf, needed, &needed);
+ *     }
+ *     docparser_close(doc);
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum docparser_status {
+    DOCPARSER_OK = 0,
+    DOCPARSER_ERR_INVALID_ARGUMENT = 1,  /* null handle/pointer or call out of order */
+    DOCPARSER_ERR_NOT_FOUND = 2,         /* file does not exist or is not readable */
+    DOCPARSER_ERR_UNSUPPORTED = 3,       /* no parser for this file type */
+    DOCPARSER_ERR_PARSE = 4,             /* the parser failed, see docparser_last_error() */
+    DOCPARSER_ERR_NO_MEMORY = 5,
+    DOCPARSER_ERR_BUFFER_TOO_SMALL = 6,  /* *needed holds the required size */
+    DOCPARSER_ERR_ABORTED = 7            /* a write callback asked to stop */
+} docparser_status;
+
+typedef struct docparser_doc docparser_doc;
+
+/* Formats for docparser_set_fast_text_formats() */
+#define DOCPARSER_FAST_TEXT_DOCX 0x1u
+#define DOCPARSER_FAST_TEXT_PPTX 0x2u
+#define DOCPARSER_FAST_TEXT_XLSX 0x4u
+
+/* Story parts for docparser_set_docx_parts() */
+#define DOCPARSER_DOCX_BODY 0x1u
+#define DOCPARSER_DOCX_HEADERS 0x2u
+#define DOCPARSER_DOCX_FOOTERS 0x4u
+#define DOCPARSER_DOCX_FOOTNOTES 0x8u
+#define DOCPARSER_DOCX_ENDNOTES 0x10u
+#define DOCPARSER_DOCX_COMMENTS 0x20u
+#define DOCPARSER_DOCX_TEXT_BOXES 0x40u
+#define DOCPARSER_DOCX_ALL_PARTS 0x7fu
+
+/* Parts for docparser_set_pptx_parts() */
+#define DOCPARSER_PPTX_SLIDES 0x1u
+#define DOCPARSER_PPTX_NOTES 0x2u
+#define DOCPARSER_PPTX_MASTERS 0x4u
+#define DOCPARSER_PPTX_ALL_PARTS 0x7u
+
+/*
+ * Receives one chunk of text.  Return 0 to continue, anything else stops
+ * the delivery and makes docparser_write_text() return DOCPARSER_ERR_ABORTED.
+ * Chunks are not NUL terminated and may split a UTF-8 sequence.
+ */
+typedef int (*docparser_write_fn)(void *user_data, const char *data, size_t size);
+
+/* Create a handle for @path.  On success *out must be released with docparser_close(). */
+docparser_status docparser_open(const char *path, docparser_doc **out);
+
+/* Limit the extracted text to about @max_bytes, 0 (default) means no limit.
+ * Same semantics as DocParser::convertFile(filename, maxBytes).  Must be
+ * called before docparser_convert(). */
+docparser_status docparser_set_max_bytes(docparser_doc *doc, size_t max_bytes);
+
+/* Run the parser.  Can only be called once per handle. */
+docparser_status docparser_convert(docparser_doc *doc);
+
+/* Borrow the converted text.  *data stays valid until docparser_close()
+ * and is NUL terminated; *size excludes the terminator. */
+docparser_status docparser_text(const docparser_doc *doc, const char **data, size_t *size);
+
+/*
+ * Copy the converted text into @buffer of @capacity bytes.  *needed is
+ * always set to the text size in bytes (without terminator).  If
+ * @capacity is smaller than that nothing is written and
+ * DOCPARSER_ERR_BUFFER_TOO_SMALL is returned, so a NULL/0 call can be
+ * used to query the size.  A NUL terminator is appended when it fits.
+ */
+docparser_status docparser_copy_text(const docparser_doc *doc, char *buffer, size_t capacity, size_t *needed);
+
+/* Stream the converted text to @write in chunks of at most @chunk_size
+ * bytes (0 delivers everything in one call). */
+docparser_status docparser_write_text(const docparser_doc *doc, docparser_write_fn write,
+                                      void *user_data, size_t chunk_size);
+
+/* Message of the last failure on @doc, never NULL.  Valid until the next call on @doc. */
+const char *docparser_last_error(const docparser_doc *doc);
+
+/* Static description of @status, never NULL. */
+const char *docparser_status_string(docparser_status status);
+
+/* Convert the DOCPARSER_FAST_TEXT_* @formats with the fast text-run
+ * extractor, which reads only text elements and paragraph breaks.  0
+ * (default) uses the full parsers.  Must be called before docparser_convert(). */
+docparser_status docparser_set_fast_text_formats(docparser_doc *doc, unsigned formats);
+
+/* Extract the DOCPARSER_DOCX_* story @parts of docx files.
+ * DOCPARSER_DOCX_BODY (default) reads the main document only; text boxes
+ * are read inside the selected parts.  Must be called before docparser_convert(). */
+docparser_status docparser_set_docx_parts(docparser_doc *doc, unsigned parts);
+
+/* Append the text of documents embedded in docx, pptx and xlsx files,
+ * following up to @max_depth nesting levels (0, the default, disables it).
+ * At most @max_bytes of embedded content is read and @timeout_ms spent,
+ * an embedded document still being converted then keeps its text so far.
+ * Must be called before docparser_convert(). */
+docparser_status docparser_set_embedded_limits(docparser_doc *doc, unsigned max_depth, size_t max_bytes,
+                                               unsigned timeout_ms);
+
+/* Extract the DOCPARSER_PPTX_* @parts of pptx files.
+ * DOCPARSER_PPTX_SLIDES (default) reads slides only; notes follow their
+ * slide, masters and layouts come last.  With more than slides selected,
+ * paragraphs that also occur in master, layout or notes text are kept
+ * once.  Must be called before docparser_convert(). */
+docparser_status docparser_set_pptx_parts(docparser_doc *doc, unsigned parts);
+
+/* Read only the first @max_slides slides of pptx files, in presentation
+ * order.  0 (default) reads all.  Must be called before docparser_convert(). */
+docparser_status docparser_set_pptx_max_slides(docparser_doc *doc, unsigned max_slides);
+
+/* Skip tables, text boxes and links of docx and odf files nested deeper
+ * than @depth levels (default 256, 0 is taken as 1).  Must be called
+ * before docparser_convert(). */
+docparser_status docparser_set_max_nesting(docparser_doc *doc, unsigned depth);
+
+/* Release @doc and its text.  NULL is accepted. */
+void docparser_close(docparser_doc *doc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DOCPARSER_C_H
@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "docparser.h"
+#include "docparser_c.h"
+#include "fileext/dedupe.hpp"
+#include "fileext/ooxml/xmlreader.hpp"
 
 #include <QTest>
 #include <QTemporaryFile>
@@ -15,6 +18,8 @@
 #include <QRandomGenerator>
 #include <QElapsedTimer>
 
+#include <cstring>
+
 /**
  * @brief Unit test class for DocParser library
  *
@@ -63,9 +68,46 @@ private slots:
     void testTruncationBoundaryConditions();
     void testTruncationBackwardCompatibility();
 
+    // C API tests
+    void testCApiConversion();
+    void testCApiErrors();
+
+    // Streaming XML reader tests
+    void testXmlReaderEntities();
+    void testXmlReaderCdata();
+    void testXmlReaderEmptyElements();
+    void testXmlReaderAttributes();
+    void testXmlReaderSkipElement();
+    void testXmlReaderReadElement();
+    void testXmlReaderTruncatedInput();
+
+    // Document structure tests
+    void testDocxListItems();
+    void testDocxNestedBlocks();
+    void testOdfNestedBlocks();
+    void testPptxSlideOrder();
+
+    // Fast text extraction tests
+    void testFastTextAlternateContent();
+    void testFastTextDocx();
+    void testFastTextPptx();
+    void testFastTextXlsx();
+
+    // Embedded document tests
+    void testEmbeddedDocuments();
+
+    // Repeated paragraph tests
+    void testParagraphDedupe();
+    void testPptxRepeatedParagraphs();
+
 private:
     QString createTestFile(const QString &content, const QString &suffix = "txt");
     QString createBinaryTestFile(const QByteArray &data, const QString &suffix);
+    QString createZipTestFile(const QList<QPair<QString, QByteArray>> &entries, const QString &suffix);
+    QString createDocxTestFile(const QByteArray &body, QList<QPair<QString, QByteArray>> parts = {});
+    QString createOdtTestFile(const QByteArray &text);
+    QString createPptxTestFile(const QList<QByteArray> &slides, const QStringList &slideNames = {});
+    QString createXlsxTestFile(const QByteArray &sharedStrings, const QByteArray &sheetData);
     void verifyConversionResult(const std::string &result, const QString &expectedContent);
 
 private:
@@ -564,6 +606,632 @@ void DocParserAutoTest::testTruncationBackwardCompatibility()
     qInfo() << "INFO: [DocParserAutoTest::testTruncationBackwardCompatibility] All backward compatibility tests passed";
 }
 
+void DocParserAutoTest::testCApiConversion()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testCApiConversion] Testing C API text delivery";
+
+    const QString content = "C API content: äöü 中文";
+    QString testFile = createTestFile(content, "txt");
+    QVERIFY(!testFile.isEmpty());
+
+    const std::string expected = DocParser::convertFile(testFile.toStdString());
+
+    docparser_doc *doc = nullptr;
+    QCOMPARE(docparser_open(testFile.toUtf8().constData(), &doc), DOCPARSER_OK);
+    QVERIFY(doc != nullptr);
+
+    // Not converted yet
+    const char *data = nullptr;
+    size_t size = 0;
+    QCOMPARE(docparser_text(doc, &data, &size), DOCPARSER_ERR_INVALID_ARGUMENT);
+    QVERIFY(data == nullptr);
+    QCOMPARE(docparser_convert(doc), DOCPARSER_OK);
+    QCOMPARE(docparser_convert(doc), DOCPARSER_ERR_INVALID_ARGUMENT);
+    QCOMPARE(docparser_text(doc, nullptr, &size), DOCPARSER_ERR_INVALID_ARGUMENT);
+
+    // Borrowed view
+    QCOMPARE(docparser_text(doc, &data, &size), DOCPARSER_OK);
+    QCOMPARE(std::string(data, size), expected);
+
+    // Size query, too small buffer, exact buffer
+    size_t needed = 0;
+    QCOMPARE(docparser_copy_text(doc, nullptr, 0, &needed), DOCPARSER_ERR_BUFFER_TOO_SMALL);
+    QCOMPARE(needed, expected.size());
+
+    std::string small(needed - 1, 'x');
+    QCOMPARE(docparser_copy_text(doc, small.data(), small.size(), &needed), DOCPARSER_ERR_BUFFER_TOO_SMALL);
+    QCOMPARE(small, std::string(needed - 1, 'x'));
+
+    std::string buffer(needed + 1, 'x');
+    QCOMPARE(docparser_copy_text(doc, buffer.data(), buffer.size(), &needed), DOCPARSER_OK);
+    QCOMPARE(buffer.substr(0, needed), expected);
+    QCOMPARE(buffer[needed], '\0');
+
+    // Chunked callback
+    std::string streamed;
+    auto append = [](void *userData, const char *chunk, size_t length) -> int {
+        static_cast<std::string *>(userData)->append(chunk, length);
+        return 0;
+    };
+    QCOMPARE(docparser_write_text(doc, append, &streamed, 3), DOCPARSER_OK);
+    QCOMPARE(streamed, expected);
+
+    auto stop = [](void *, const char *, size_t) -> int { return 1; };
+    QCOMPARE(docparser_write_text(doc, stop, nullptr, 0), DOCPARSER_ERR_ABORTED);
+
+    docparser_close(doc);
+}
+
+void DocParserAutoTest::testCApiErrors()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testCApiErrors] Testing C API error codes";
+
+    docparser_doc *doc = nullptr;
+    QCOMPARE(docparser_open(nullptr, &doc), DOCPARSER_ERR_INVALID_ARGUMENT);
+    QVERIFY(doc == nullptr);
+
+    QString missing = m_tempDir->path() + "/non_existent_file.docx";
+    QCOMPARE(docparser_open(missing.toUtf8().constData(), &doc), DOCPARSER_ERR_NOT_FOUND);
+    QVERIFY(doc == nullptr);
+
+    QString testFile = createBinaryTestFile(QByteArray("\x00\x01\x02", 3), "unknownext");
+    QCOMPARE(docparser_open(testFile.toUtf8().constData(), &doc), DOCPARSER_OK);
+    QCOMPARE(docparser_convert(doc), DOCPARSER_ERR_UNSUPPORTED);
+    QVERIFY(std::strlen(docparser_last_error(doc)) > 0);
+    docparser_close(doc);
+
+    QCOMPARE(docparser_convert(nullptr), DOCPARSER_ERR_INVALID_ARGUMENT);
+    QVERIFY(docparser_status_string(DOCPARSER_ERR_PARSE) != nullptr);
+    docparser_close(nullptr);
+}
+
+/**
+ * @brief Concatenate all Text tokens of an XML fragment
+ */
+static std::string readXmlText(std::string_view xml, bool *failed = nullptr)
+{
+    ooxml::XmlReader reader(xml);
+    std::string text;
+    for (auto token = reader.next(); token != ooxml::XmlReader::Token::End; token = reader.next()) {
+        if (token == ooxml::XmlReader::Token::Text)
+            text += reader.text();
+    }
+    if (failed)
+        *failed = reader.failed();
+    return text;
+}
+
+void DocParserAutoTest::testXmlReaderEntities()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderEntities] Testing entity decoding";
+
+    bool failed = true;
+    QCOMPARE(readXmlText("<a>x &amp; &lt;y&gt; &#65;&#x42; &quot;&apos;</a>", &failed),
+             std::string("x & <y> AB \"'"));
+    QVERIFY(!failed);
+}
+
+void DocParserAutoTest::testXmlReaderCdata()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderCdata] Testing CDATA sections";
+
+    // CDATA is reported as text without decoding
+    QCOMPARE(readXmlText("<a>1<![CDATA[<b>&amp;</b>]]>2</a>"), std::string("1<b>&amp;</b>2"));
+}
+
+void DocParserAutoTest::testXmlReaderEmptyElements()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderEmptyElements] Testing self-closing elements";
+
+    using Token = ooxml::XmlReader::Token;
+    ooxml::XmlReader reader("<r><e a=\"1\"/><f/></r>");
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("r"));
+    QCOMPARE(reader.depth(), 1);
+    QVERIFY(!reader.isEmptyElement());
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("e"));
+    QCOMPARE(reader.depth(), 2);
+    QVERIFY(reader.isEmptyElement());
+    QCOMPARE(reader.rawAttribute("a"), std::string_view("1"));
+    // The end tag of an empty element is reported as well
+    QCOMPARE(reader.next(), Token::EndElement);
+    QCOMPARE(reader.name(), std::string_view("e"));
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("f"));
+    QVERIFY(reader.isEmptyElement());
+    QCOMPARE(reader.next(), Token::EndElement);
+
+    QCOMPARE(reader.next(), Token::EndElement);
+    QCOMPARE(reader.name(), std::string_view("r"));
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.next(), Token::End);
+    QVERIFY(!reader.failed());
+}
+
+void DocParserAutoTest::testXmlReaderAttributes()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderAttributes] Testing attributes containing '>'";
+
+    using Token = ooxml::XmlReader::Token;
+    ooxml::XmlReader reader("<a t=\"x>y\" u='1>2' v=\"a&amp;b\">t</a>");
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.rawAttribute("t"), std::string_view("x>y"));
+    QCOMPARE(reader.rawAttribute("u"), std::string_view("1>2"));
+    QCOMPARE(reader.rawAttribute("v"), std::string_view("a&amp;b"));
+    QCOMPARE(reader.attribute("v"), std::string("a&b"));
+    QVERIFY(reader.rawAttribute("missing").empty());
+
+    QCOMPARE(reader.next(), Token::Text);
+    QCOMPARE(reader.text(), std::string("t"));
+}
+
+void DocParserAutoTest::testXmlReaderSkipElement()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderSkipElement] Testing subtree skipping";
+
+    using Token = ooxml::XmlReader::Token;
+    ooxml::XmlReader reader("<r><s><x>hidden</x><s/></s><k>keep</k></r>");
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("s"));
+    // Nested element with the same name must not end the skip
+    reader.skipElement();
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("k"));
+    QCOMPARE(reader.depth(), 2);
+}
+
+void DocParserAutoTest::testXmlReaderReadElement()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderReadElement] Testing subtree capture";
+
+    using Token = ooxml::XmlReader::Token;
+    ooxml::XmlReader reader("<r><p a=\"1\"><t>hi &amp;</t></p><q/></r>");
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.next(), Token::StartElement);
+
+    std::string xml;
+    QVERIFY(reader.readElement(xml));
+    // Captured markup is kept undecoded
+    QCOMPARE(xml, std::string("<p a=\"1\"><t>hi &amp;</t></p>"));
+
+    QCOMPARE(reader.next(), Token::StartElement);
+    QCOMPARE(reader.name(), std::string_view("q"));
+    QCOMPARE(reader.depth(), 2);
+}
+
+void DocParserAutoTest::testXmlReaderTruncatedInput()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testXmlReaderTruncatedInput] Testing truncated parts";
+
+    // Text before the unterminated tag is still delivered
+    bool failed = false;
+    QCOMPARE(readXmlText("<r><a>text</a><b attr=\"x", &failed), std::string("text"));
+    QVERIFY(failed);
+
+    ooxml::XmlReader reader("<r><p><t>cut");
+    QCOMPARE(reader.next(), ooxml::XmlReader::Token::StartElement);
+    QCOMPARE(reader.next(), ooxml::XmlReader::Token::StartElement);
+    std::string xml;
+    QVERIFY(!reader.readElement(xml));
+    QCOMPARE(reader.next(), ooxml::XmlReader::Token::End);
+}
+
+/**
+ * @brief CRC-32 of zip entries
+ */
+static quint32 zipCrc32(const QByteArray &data)
+{
+    quint32 crc = 0xFFFFFFFFu;
+    for (char byte : data) {
+        crc ^= static_cast<quint8>(byte);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Append little-endian integer of @p size bytes
+ */
+static void appendLe(QByteArray &out, quint32 value, int size)
+{
+    for (int i = 0; i < size; ++i)
+        out.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+static QByteArray zipArchive(const QList<QPair<QString, QByteArray>> &entries)
+{
+    // Stored (uncompressed) entries are enough for the parsers and need no zlib
+    QByteArray archive;
+    QByteArray directory;
+    for (const auto &entry : entries) {
+        const QByteArray name = entry.first.toUtf8();
+        const QByteArray &data = entry.second;
+        const quint32 crc = zipCrc32(data);
+        const quint32 offset = static_cast<quint32>(archive.size());
+
+        appendLe(archive, 0x04034b50, 4);   // Local file header
+        appendLe(archive, 20, 2);           // Version needed
+        appendLe(archive, 0, 2);            // Flags
+        appendLe(archive, 0, 2);            // Stored
+        appendLe(archive, 0, 2);            // Time
+        appendLe(archive, 0x21, 2);         // Date (1980-01-01)
+        appendLe(archive, crc, 4);
+        appendLe(archive, static_cast<quint32>(data.size()), 4);
+        appendLe(archive, static_cast<quint32>(data.size()), 4);
+        appendLe(archive, static_cast<quint32>(name.size()), 2);
+        appendLe(archive, 0, 2);            // Extra field length
+        archive += name;
+        archive += data;
+
+        appendLe(directory, 0x02014b50, 4); // Central directory header
+        appendLe(directory, 20, 2);         // Version made by
+        appendLe(directory, 20, 2);         // Version needed
+        appendLe(directory, 0, 2);
+        appendLe(directory, 0, 2);
+        appendLe(directory, 0, 2);
+        appendLe(directory, 0x21, 2);
+        appendLe(directory, crc, 4);
+        appendLe(directory, static_cast<quint32>(data.size()), 4);
+        appendLe(directory, static_cast<quint32>(data.size()), 4);
+        appendLe(directory, static_cast<quint32>(name.size()), 2);
+        appendLe(directory, 0, 2);          // Extra field length
+        appendLe(directory, 0, 2);          // Comment length
+        appendLe(directory, 0, 2);          // Disk number
+        appendLe(directory, 0, 2);          // Internal attributes
+        appendLe(directory, 0, 4);          // External attributes
+        appendLe(directory, offset, 4);
+        directory += name;
+    }
+
+    const quint32 directoryOffset = static_cast<quint32>(archive.size());
+    archive += directory;
+    appendLe(archive, 0x06054b50, 4);       // End of central directory
+    appendLe(archive, 0, 2);
+    appendLe(archive, 0, 2);
+    appendLe(archive, static_cast<quint32>(entries.size()), 2);
+    appendLe(archive, static_cast<quint32>(entries.size()), 2);
+    appendLe(archive, static_cast<quint32>(directory.size()), 4);
+    appendLe(archive, directoryOffset, 4);
+    appendLe(archive, 0, 2);                // Comment length
+    return archive;
+}
+
+static QByteArray docxDocument(const QByteArray &body)
+{
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+           "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\""
+           " xmlns:mc=\"http://schemas.openxmlformats.org/markup-compatibility/2006\""
+           " xmlns:wps=\"http://schemas.microsoft.com/office/word/2010/wordprocessingShape\">"
+           "<w:body>" + body + "<w:sectPr/></w:body></w:document>";
+}
+
+// One decimal list: `w:numId` 1, level 0
+static const QByteArray DOCX_NUMBERING =
+        "<w:numbering xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:abstractNum w:abstractNumId=\"0\"><w:lvl w:ilvl=\"0\"><w:numFmt w:val=\"decimal\"/></w:lvl></w:abstractNum>"
+        "<w:num w:numId=\"1\"><w:abstractNumId w:val=\"0\"/></w:num>"
+        "</w:numbering>";
+
+static QByteArray docxParagraph(const char *text)
+{
+    return QByteArray("<w:p><w:r><w:t>") + text + "</w:t></w:r></w:p>";
+}
+
+static QByteArray docxListItem(const char *text)
+{
+    return QByteArray("<w:p><w:pPr><w:numPr><w:ilvl w:val=\"0\"/><w:numId w:val=\"1\"/></w:numPr></w:pPr>"
+                      "<w:r><w:t>") + text + "</w:t></w:r></w:p>";
+}
+
+void DocParserAutoTest::testDocxListItems()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testDocxListItems] Testing docx list items";
+
+    const QByteArray body = docxParagraph("Intro") + docxListItem("First item") + docxListItem("Second item")
+            + docxParagraph("After");
+
+    QString testFile = createDocxTestFile(body, { { "word/numbering.xml", DOCX_NUMBERING } });
+    QVERIFY(!testFile.isEmpty());
+
+    // Every item is emitted once, the first one included
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), std::string("Intro\nFirst item\nSecond item\nAfter\n"));
+}
+
+void DocParserAutoTest::testDocxNestedBlocks()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testDocxNestedBlocks] Testing docx nested tables, lists and text boxes";
+
+    const QByteArray textBox = "<w:r><w:drawing><wps:wsp><wps:txbx><w:txbxContent>" + docxParagraph("Box")
+            + "</w:txbxContent></wps:txbx></wps:wsp></w:drawing></w:r>";
+    const QByteArray innerTable = "<w:tbl><w:tr><w:tc>" + docxParagraph("Inner") + "</w:tc></w:tr></w:tbl>";
+    const QByteArray body = docxParagraph("Before")
+            + "<w:tbl><w:tr>"
+              "<w:tc><w:tcPr/>" + docxParagraph("A1") + "</w:tc>"
+              "<w:tc>" + innerTable + docxParagraph("B1") + "</w:tc>"
+              "</w:tr><w:tr>"
+              "<w:tc>" + docxListItem("Cell item") + docxParagraph("Cell text") + "</w:tc>"
+              "</w:tr></w:tbl>"
+            + "<w:p><w:r><w:t>Anchor</w:t></w:r>" + textBox + "</w:p>"
+            + docxParagraph("After");
+
+    QString testFile = createDocxTestFile(body, { { "word/numbering.xml", DOCX_NUMBERING } });
+    QVERIFY(!testFile.isEmpty());
+
+    // Cells are read in document order, text boxes follow their paragraph
+    DocParser::Options options;
+    options.docxParts = DocParser::DocxBody | DocParser::DocxTextBoxes;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options),
+             std::string("Before\nA1\nInner\nB1\nCell item\nCell text\nAnchor\nBox\nAfter\n"));
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()),
+             std::string("Before\nA1\nInner\nB1\nCell item\nCell text\nAnchor\nAfter\n"));
+
+    // Tables nested deeper than the cap are dropped without unwinding the stack
+    QByteArray deep = docxParagraph("Outer");
+    for (int i = 0; i < 1000; ++i)
+        deep += "<w:tbl><w:tr><w:tc>";
+    deep += docxParagraph("Deepest");
+    for (int i = 0; i < 1000; ++i)
+        deep += "</w:tc></w:tr></w:tbl>";
+    deep += docxParagraph("Tail");
+
+    testFile = createDocxTestFile(deep);
+    QVERIFY(!testFile.isEmpty());
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), std::string("Outer\nTail\n"));
+}
+
+void DocParserAutoTest::testOdfNestedBlocks()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testOdfNestedBlocks] Testing odt nested tables and links";
+
+    const QByteArray innerTable =
+            "<table:table><table:table-row><table:table-cell><text:p>Inner</text:p></table:table-cell>"
+            "</table:table-row></table:table>";
+    const QByteArray text = "<text:p>Intro</text:p>"
+            "<table:table><table:table-row>"
+            "<table:table-cell><text:p>A1</text:p></table:table-cell>"
+            "<table:table-cell>" + innerTable + "</table:table-cell>"
+            "</table:table-row></table:table>"
+            "<text:p>See <text:a>link</text:a> here</text:p>";
+
+    QString testFile = createOdtTestFile(text);
+    QVERIFY(!testFile.isEmpty());
+
+    // Paragraphs, links and cells end with a line break each; a table adds none of its own
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()),
+             std::string("Intro\nA1\n\nInner\n\n\nSee link\n here\n"));
+
+    // Tables nested deeper than the cap are dropped without unwinding the stack
+    QByteArray deep = "<text:p>Outer</text:p>";
+    for (int i = 0; i < 1000; ++i)
+        deep += "<table:table><table:table-row><table:table-cell>";
+    deep += "<text:p>Deepest</text:p>";
+    for (int i = 0; i < 1000; ++i)
+        deep += "</table:table-cell></table:table-row></table:table>";
+
+    testFile = createOdtTestFile(deep);
+    QVERIFY(!testFile.isEmpty());
+    const std::string result = DocParser::convertFile(testFile.toStdString());
+    QVERIFY(result.rfind("Outer\n", 0) == 0);
+    QVERIFY(result.find("Deepest") == std::string::npos);
+}
+
+void DocParserAutoTest::testPptxSlideOrder()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testPptxSlideOrder] Testing slide order of a reordered deck";
+
+    // Reordered deck with a deleted slide: part names don't follow sldIdLst
+    const QByteArray opening = "<p:sp><p:txBody><a:p><a:r><a:t>Opening</a:t></a:r></a:p></p:txBody></p:sp>";
+    const QByteArray closing = "<p:sp><p:txBody><a:p><a:r><a:t>Closing</a:t></a:r></a:p></p:txBody></p:sp>";
+    QString testFile = createPptxTestFile({ opening, closing }, { "slide3.xml", "slide1.xml" });
+    QVERIFY(!testFile.isEmpty());
+
+    DocParser::Options options;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), std::string("\nOpening\nClosing"));
+    options.fastTextFormats = DocParser::FastTextPptx;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), std::string("\nOpening\nClosing"));
+
+    // The limit counts slides in presentation order, not part names
+    options.pptxMaxSlides = 1;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), std::string("\nOpening"));
+    options.fastTextFormats = DocParser::FastTextNone;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), std::string("\nOpening"));
+}
+
+void DocParserAutoTest::testFastTextAlternateContent()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testFastTextAlternateContent] Testing alternate content in fast mode";
+
+    auto alternateRun = [](const char *requirement) {
+        return QByteArray("<w:r><mc:AlternateContent><mc:Choice Requires=\"") + requirement + "\">"
+                "<w:t>choice</w:t></mc:Choice><mc:Fallback><w:t>fallback</w:t></mc:Fallback>"
+                "</mc:AlternateContent></w:r>";
+    };
+    const QByteArray body = "<w:p><w:r><w:t>Known </w:t></w:r>" + alternateRun("wps") + "</w:p>"
+            "<w:p><w:r><w:t>Unknown </w:t></w:r>" + alternateRun("w99") + "</w:p>";
+
+    QString testFile = createDocxTestFile(body);
+    QVERIFY(!testFile.isEmpty());
+
+    // Both modes read the understood choice, else the fallback, never both
+    const std::string expected = "Known choice\nUnknown fallback\n";
+    DocParser::Options options;
+    options.fastTextFormats = DocParser::FastTextDocx;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), expected);
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), expected);
+}
+
+void DocParserAutoTest::testFastTextDocx()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testFastTextDocx] Testing fast docx extraction against the normal one";
+
+    const QByteArray body = docxParagraph("Plain")
+            + "<w:p><w:r><w:t>Two </w:t></w:r><w:r><w:t>runs &amp; &lt;entities&gt;</w:t></w:r></w:p>"
+            + "<w:p/>"
+            + "<w:tbl><w:tr><w:tc>" + docxParagraph("A") + "</w:tc><w:tc>" + docxParagraph("B") + "</w:tc></w:tr></w:tbl>"
+            + docxListItem("Item");
+
+    QString testFile = createDocxTestFile(body, { { "word/numbering.xml", DOCX_NUMBERING } });
+    QVERIFY(!testFile.isEmpty());
+
+    const std::string expected = "Plain\nTwo runs & <entities>\n\nA\nB\nItem\n";
+    DocParser::Options options;
+    options.fastTextFormats = DocParser::FastTextDocx;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), expected);
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), expected);
+}
+
+void DocParserAutoTest::testFastTextPptx()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testFastTextPptx] Testing fast pptx extraction against the normal one";
+
+    const QByteArray first =
+            "<p:sp><p:txBody><a:p><a:r><a:t>Title</a:t></a:r></a:p></p:txBody></p:sp>"
+            "<p:sp><p:txBody><a:p><a:r><a:t>Body </a:t></a:r><a:r><a:t>text &amp; more</a:t></a:r></a:p>"
+            "<a:p/></p:txBody></p:sp>";
+    const QByteArray second =
+            "<mc:AlternateContent><mc:Choice Requires=\"p99\"><p:sp><p:txBody><a:p><a:r><a:t>New</a:t></a:r></a:p>"
+            "</p:txBody></p:sp></mc:Choice><mc:Fallback><p:sp><p:txBody><a:p><a:r><a:t>Old</a:t></a:r></a:p>"
+            "</p:txBody></p:sp></mc:Fallback></mc:AlternateContent>";
+
+    QString testFile = createPptxTestFile({ first, second });
+    QVERIFY(!testFile.isEmpty());
+
+    // Every paragraph starts a line
+    const std::string expected = "\nTitle\nBody text & more\n\nOld";
+    DocParser::Options options;
+    options.fastTextFormats = DocParser::FastTextPptx;
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), expected);
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), expected);
+}
+
+void DocParserAutoTest::testFastTextXlsx()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testFastTextXlsx] Testing fast xlsx extraction against the normal one";
+
+    const QByteArray sharedStrings =
+            "<si><t>Plain</t></si>"
+            "<si><r><t>Rich</t></r><r><rPr><b/></rPr><t>Runs</t></r></si>"
+            "<si><t>Kanji</t><rPh sb=\"0\" eb=\"1\"><t>Reading</t></rPh></si>"
+            "<si><t>Tom &amp; Jerry</t></si>";
+    const QByteArray sheetData =
+            "<row r=\"1\"><c r=\"A1\" t=\"s\"><v>0</v></c><c r=\"B1\" t=\"s\"><v>1</v></c></row>"
+            "<row r=\"2\"><c r=\"A2\" t=\"s\"><v>2</v></c><c r=\"B2\" t=\"s\"><v>3</v></c></row>";
+
+    QString testFile = createXlsxTestFile(sharedStrings, sheetData);
+    QVERIFY(!testFile.isEmpty());
+
+    DocParser::Options options;
+    options.fastTextFormats = DocParser::FastTextXlsx;
+    const std::string normal = DocParser::convertFile(testFile.toStdString());
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), normal);
+
+    // Runs are joined, phonetic readings aren't part of the string
+    const QString text = QString::fromStdString(normal);
+    QVERIFY(text.contains("Plain"));
+    QVERIFY(text.contains("RichRuns"));
+    QVERIFY(text.contains("Kanji"));
+    QVERIFY(text.contains("Tom & Jerry"));
+    QVERIFY(!text.contains("Reading"));
+}
+
+void DocParserAutoTest::testEmbeddedDocuments()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testEmbeddedDocuments] Testing embedded document depth and size limits";
+
+    // outer.docx embeds level1.docx, which embeds level2.docx
+    const QByteArray level2 = zipArchive({ { "word/document.xml", docxDocument(docxParagraph("Level two")) } });
+    const QByteArray level1 = zipArchive({ { "word/document.xml", docxDocument(docxParagraph("Level one")) },
+                                           { "word/embeddings/level2.docx", level2 } });
+    QString testFile = createDocxTestFile(docxParagraph("Outer"), { { "word/embeddings/level1.docx", level1 } });
+    QVERIFY(!testFile.isEmpty());
+    const std::string fileName = testFile.toStdString();
+
+    // Extraction is disabled by default
+    QCOMPARE(DocParser::convertFile(fileName), std::string("Outer\n"));
+
+    DocParser::Options options;
+    options.embedded.maxDepth = 1;
+    QCOMPARE(DocParser::convertFile(fileName, options), std::string("Outer\nLevel one\n"));
+    options.embedded.maxDepth = 2;
+    QCOMPARE(DocParser::convertFile(fileName, options), std::string("Outer\nLevel one\nLevel two\n"));
+
+    // Content bytes are shared by all levels: entries that don't fit are skipped
+    options.embedded.maxBytes = static_cast<size_t>(level1.size());
+    QCOMPARE(DocParser::convertFile(fileName, options), std::string("Outer\nLevel one\n"));
+    options.embedded.maxBytes = static_cast<size_t>(level1.size()) - 1;
+    QCOMPARE(DocParser::convertFile(fileName, options), std::string("Outer\n"));
+
+    // Embedded documents only get the text the parent left of the limit
+    options.embedded.maxBytes = DocParser::EmbeddedLimits().maxBytes;
+    const std::string marker = "\n[CONTENT_TRUNCATED]";
+    const size_t maxBytes = 12;
+    const std::string truncated = DocParser::convertFile(fileName, maxBytes, options);
+    QVERIFY(truncated.rfind("Outer\n", 0) == 0);
+    QVERIFY(truncated.size() >= marker.size());
+    QCOMPARE(truncated.substr(truncated.size() - marker.size()), marker);
+    QVERIFY(truncated.size() - marker.size() <= maxBytes);
+    QVERIFY(truncated.find("Level two") == std::string::npos);
+}
+
+void DocParserAutoTest::testParagraphDedupe()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testParagraphDedupe] Testing boilerplate paragraph suppression";
+
+    fileext::ParagraphDedupe dedupe;
+    dedupe.addBoilerplate("Footer\nConfidential");
+
+    // Boilerplate is kept once; other paragraphs and blank lines are always kept
+    std::string output;
+    dedupe.filter("Title\nFooter\nQuestions?", output);
+    dedupe.filter("\nQuestions?\n  Footer \n\nConfidential", output);
+    QCOMPARE(output, std::string("Title\nFooter\nQuestions?\nQuestions?\n\nConfidential"));
+
+    output.clear();
+    dedupe.filter("Confidential\nFooter", output);
+    QCOMPARE(output, std::string());
+
+    // Without tables every paragraph is kept
+    fileext::ParagraphDedupe disabled(0);
+    disabled.addBoilerplate("Footer");
+    output.clear();
+    disabled.filter("Footer\nFooter", output);
+    QCOMPARE(output, std::string("Footer\nFooter"));
+
+    // Once a table is 3/4 full, further paragraphs aren't remembered and are kept
+    fileext::ParagraphDedupe small(4);
+    for (int i = 0; i < 10; ++i)
+        small.addBoilerplate(std::to_string(i));
+    output.clear();
+    small.filter("0\n0\n9\n9", output);
+    QCOMPARE(output, std::string("0\n9\n9"));
+}
+
+void DocParserAutoTest::testPptxRepeatedParagraphs()
+{
+    qInfo() << "INFO: [DocParserAutoTest::testPptxRepeatedParagraphs] Testing repeated slide paragraphs";
+
+    const QByteArray slide = "<p:sp><p:txBody><a:p><a:r><a:t>Questions?</a:t></a:r></a:p></p:txBody></p:sp>";
+    QString testFile = createPptxTestFile({ slide, slide });
+    QVERIFY(!testFile.isEmpty());
+
+    // Paragraphs that aren't in master, layout or notes text are never dropped
+    DocParser::Options options;
+    options.pptxParts = DocParser::PptxAllParts;
+    const std::string expected = "\nQuestions?\nQuestions?";
+    QCOMPARE(DocParser::convertFile(testFile.toStdString()), expected);
+    QCOMPARE(DocParser::convertFile(testFile.toStdString(), options), expected);
+}
+
 QString DocParserAutoTest::createTestFile(const QString &content, const QString &suffix)
 {
     QString fileName = m_tempDir->path() + QString("/test_file_%1.%2").arg(QRandomGenerator::global()->generate()).arg(suffix);
@@ -599,6 +1267,87 @@ QString DocParserAutoTest::createBinaryTestFile(const QByteArray &data, const QS
     return fileName;
 }
 
+/**
+ * @brief Zip test file with stored @p entries
+ */
+QString DocParserAutoTest::createZipTestFile(const QList<QPair<QString, QByteArray>> &entries, const QString &suffix)
+{
+    return createBinaryTestFile(zipArchive(entries), suffix);
+}
+
+QString DocParserAutoTest::createDocxTestFile(const QByteArray &body, QList<QPair<QString, QByteArray>> parts)
+{
+    parts.prepend({ "word/document.xml", docxDocument(body) });
+    return createZipTestFile(parts, "docx");
+}
+
+QString DocParserAutoTest::createOdtTestFile(const QByteArray &text)
+{
+    const QByteArray content =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<office:document-content xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\""
+            " xmlns:text=\"urn:oasis:names:tc:opendocument:xmlns:text:1.0\""
+            " xmlns:table=\"urn:oasis:names:tc:opendocument:xmlns:table:1.0\">"
+            "<office:body><office:text>" + text + "</office:text></office:body></office:document-content>";
+    return createZipTestFile({ { "mimetype", "application/vnd.oasis.opendocument.text" }, { "content.xml", content } },
+                             "odt");
+}
+
+/**
+ * @brief Pptx with @p slides in presentation order, stored as @p slideNames (default `slideN.xml`)
+ */
+QString DocParserAutoTest::createPptxTestFile(const QList<QByteArray> &slides, const QStringList &slideNames)
+{
+    QByteArray idList;
+    QByteArray relationships;
+    QList<QPair<QString, QByteArray>> parts;
+    for (int i = 0; i < slides.size(); ++i) {
+        const QByteArray number = QByteArray::number(i + 1);
+        const QString name = i < slideNames.size() ? slideNames[i] : "slide" + QString::number(i + 1) + ".xml";
+        idList += "<p:sldId id=\"" + QByteArray::number(256 + i) + "\" r:id=\"rId" + number + "\"/>";
+        relationships += "<Relationship Id=\"rId" + number + "\""
+                " Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/slide\""
+                " Target=\"slides/" + name.toUtf8() + "\"/>";
+        parts.append({ "ppt/slides/" + name,
+                       "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                       "<p:sld xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\""
+                       " xmlns:p=\"http://schemas.openxmlformats.org/presentationml/2006/main\""
+                       " xmlns:mc=\"http://schemas.openxmlformats.org/markup-compatibility/2006\">"
+                       "<p:cSld><p:spTree>" + slides[i] + "</p:spTree></p:cSld></p:sld>" });
+    }
+    parts.prepend({ "ppt/_rels/presentation.xml.rels",
+                    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                    + relationships + "</Relationships>" });
+    parts.prepend({ "ppt/presentation.xml",
+                    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                    "<p:presentation xmlns:p=\"http://schemas.openxmlformats.org/presentationml/2006/main\""
+                    " xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+                    "<p:sldIdLst>" + idList + "</p:sldIdLst></p:presentation>" });
+    return createZipTestFile(parts, "pptx");
+}
+
+QString DocParserAutoTest::createXlsxTestFile(const QByteArray &sharedStrings, const QByteArray &sheetData)
+{
+    const QByteArray header = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>";
+    const QByteArray mainNamespace = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+    return createZipTestFile({
+        { "xl/workbook.xml",
+          header + "<workbook xmlns=\"" + mainNamespace + "\""
+          " xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+          "<sheets><sheet name=\"Sheet1\" sheetId=\"1\" r:id=\"rId1\"/></sheets></workbook>" },
+        { "xl/_rels/workbook.xml.rels",
+          header + "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+          "<Relationship Id=\"rId1\""
+          " Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\""
+          " Target=\"worksheets/sheet1.xml\"/></Relationships>" },
+        { "xl/sharedStrings.xml",
+          header + "<sst xmlns=\"" + mainNamespace + "\">" + sharedStrings + "</sst>" },
+        { "xl/worksheets/sheet1.xml",
+          header + "<worksheet xmlns=\"" + mainNamespace + "\"><sheetData>" + sheetData + "</sheetData></worksheet>" },
+    }, "xlsx");
+}
+
 void DocParserAutoTest::verifyConversionResult(const std::string &result, const QString &expectedContent)
 {
     QVERIFY2(!result.empty(), "Conversion result should not be empty");